@@ -2,6 +2,7 @@
 #define RKTK_ORDER_CONDITION_HELPERS_HPP_INCLUDED
 
 // C++ standard library headers
+#include <cmath>   // for std::fma
 #include <cstddef> // for std::size_t
 
 // GNU MPFR multiprecision library headers
@@ -30,18 +31,94 @@
  *     sri - Set to Reciprocal of (unsigned) Integer
  *     res - RESult (special operation used to evaluate partial
  *                   derivatives of Runge-Kutta order conditions)
+ *     tws - TWo-Sum (error-free transformation of a sum)
+ *     twp - TWo-Product (error-free transformation of a product)
+ *     rne - RouNding Error (bound on the error of a rounded result)
+ *     mle - MuLtiplication Error (propagated error of a product)
  *
  * The one-character data type codes are listed below. Currently, only
  * double-precision and arbitrary-precision objective functions have been
  * implemented; other letters are reserved below for possible future expansion.
  *
+ *     d - double precision (double)
  *     m - arbitrary precision (mpfr_t)
  *     s - indexed arbitrary precision (mpfr_t)
  *     z - dual arbitrary precision (mpfr_t)
+ *     t - tangent part of indexed or dual arbitrary precision (mpfr_t)
+ *     a - adjoint part of arbitrary precision (mpfr_t)
+ *     b - batched arbitrary precision (mpfr_t)
+ *     r - midpoint-radius (ball) arbitrary precision (mpfr_t)
+ *     w - multiword fixed point (see multiword_kernels.hpp)
+ *
+ * Tangent functions compute only the dual part of the corresponding s or z
+ * function, taking the real part of their inputs as given. They allow the
+ * real part of a computation to be shared between many partial derivatives.
+ *
+ * Adjoint functions perform one step of a reverse-mode sweep: given the
+ * adjoint of the output of the corresponding m function, they add its
+ * contribution to the adjoints of the inputs.
+ *
+ * Batched functions operate on several evaluation points at once, stored
+ * in structure-of-arrays layout: entry i of a vector at point p is located
+ * at index i * num_points + p. Each operation is carried out across all
+ * points before moving on to the next operation.
+ *
+ * Double-precision functions compute dot products and sums with the
+ * compensated algorithms of Ogita, Rump, and Oishi (Dot2 and Sum2), whose
+ * results are as accurate as if they had been computed in twice the working
+ * precision and then rounded. This matters in the residuals of the order
+ * conditions, where dot(m, b) nearly cancels against 1 / gamma.
+ *
+ * Ball functions compute each value as a midpoint (rounded to the working
+ * precision as usual) together with a radius which rigorously bounds the
+ * distance from the midpoint to the exact value. Radii are typically stored
+ * at low precision, and all operations on them round upward. Operands
+ * without radii are exact.
  */
 
 // =============================================================================
 
+// Computes s + e = a + b exactly, where s = fl(a + b).
+void twsd(double &s, double &e, double a, double b) {
+    s = a + b;
+    const double t = s - a;
+    e = (a - (s - t)) + (b - t);
+}
+
+// Computes p + e = a * b exactly, where p = fl(a * b).
+void twpd(double &p, double &e, double a, double b) {
+    p = a * b;
+    e = std::fma(a, b, -p);
+}
+
+// Adds one unit in the last place of mid, which bounds the error committed
+// in rounding mid in any direction, to rad.
+void rner(mpfr_t rad, mpfr_t mid, mpfr_t tmp) {
+    if (!mpfr_regular_p(mid)) { return; }
+    mpfr_set_ui_2exp(tmp, 1, mpfr_get_exp(mid) - mpfr_get_prec(mid),
+                     MPFR_RNDU);
+    mpfr_add(rad, rad, tmp, MPFR_RNDU);
+}
+
+// Adds a bound on |a * b - a_mid * b_mid| over all a within a_rad of a_mid
+// and b within b_rad of b_mid to rad, where b_rad may be a null pointer if
+// b_mid is exact.
+void mler(mpfr_t rad,
+          mpfr_t a_mid, mpfr_t a_rad, mpfr_t b_mid, mpfr_t b_rad,
+          mpfr_t tmp) {
+    mpfr_abs(tmp, b_mid, MPFR_RNDU);
+    mpfr_mul(tmp, tmp, a_rad, MPFR_RNDU);
+    mpfr_add(rad, rad, tmp, MPFR_RNDU);
+    if (b_rad == nullptr) { return; }
+    mpfr_abs(tmp, a_mid, MPFR_RNDU);
+    mpfr_mul(tmp, tmp, b_rad, MPFR_RNDU);
+    mpfr_add(rad, rad, tmp, MPFR_RNDU);
+    mpfr_mul(tmp, a_rad, b_rad, MPFR_RNDU);
+    mpfr_add(rad, rad, tmp, MPFR_RNDU);
+}
+
+// =============================================================================
+
 void lrsm(mpfr_t *dst,
           std::size_t dst_size,
           mpfr_t *mat, mpfr_rnd_t rnd) {
@@ -55,10 +132,9 @@ void lrsm(mpfr_t *dst,
     }
 }
 
-void lrss(mpfr_t *dst_re, mpfr_t *dst_du,
+void lrst(mpfr_t *dst_du,
           std::size_t n,
-          mpfr_t *mat_re, std::size_t mat_di, mpfr_rnd_t rnd) {
-    lrsm(dst_re, n, mat_re, rnd);
+          std::size_t mat_di, mpfr_rnd_t rnd) {
     // TODO: See lsrq above.
     std::size_t k = 0;
     for (std::size_t i = 0; i < n; ++i) {
@@ -70,6 +146,82 @@ void lrss(mpfr_t *dst_re, mpfr_t *dst_du,
     }
 }
 
+void lrss(mpfr_t *dst_re, mpfr_t *dst_du,
+          std::size_t n,
+          mpfr_t *mat_re, std::size_t mat_di, mpfr_rnd_t rnd) {
+    lrsm(dst_re, n, mat_re, rnd);
+    lrst(dst_du, n, mat_di, rnd);
+}
+
+void lrsz(mpfr_t *dst_re, mpfr_t *dst_du,
+          std::size_t n,
+          mpfr_t *mat_re, mpfr_t *mat_du, mpfr_rnd_t rnd) {
+    lrsm(dst_re, n, mat_re, rnd);
+    lrsm(dst_du, n, mat_du, rnd);
+}
+
+void lrsa(mpfr_t *mat_ad,
+          std::size_t dst_size,
+          mpfr_t *dst_ad, mpfr_rnd_t rnd) {
+    std::size_t k = 0;
+    for (std::size_t i = 0; i < dst_size; ++i) {
+        for (std::size_t j = 0; j <= i; ++j, ++k) {
+            mpfr_add(mat_ad[k], mat_ad[k], dst_ad[i], rnd);
+        }
+    }
+}
+
+void lrsr(mpfr_t *dst_mid, mpfr_t *dst_rad,
+          std::size_t dst_size,
+          mpfr_t *mat, mpfr_t tmp, mpfr_rnd_t rnd) {
+    std::size_t k = 0;
+    for (std::size_t i = 0; i < dst_size; ++i) {
+        mpfr_set_zero(dst_rad[i], 0);
+        if (mpfr_set(dst_mid[i], mat[k], rnd)) {
+            rner(dst_rad[i], dst_mid[i], tmp);
+        }
+        ++k;
+        for (std::size_t j = 0; j < i; ++j, ++k) {
+            if (mpfr_add(dst_mid[i], dst_mid[i], mat[k], rnd)) {
+                rner(dst_rad[i], dst_mid[i], tmp);
+            }
+        }
+    }
+}
+
+void lrsb(mpfr_t *dst,
+          std::size_t dst_size, std::size_t num_points,
+          mpfr_t *mat, mpfr_rnd_t rnd) {
+    std::size_t k = 0;
+    for (std::size_t i = 0; i < dst_size; ++i) {
+        mpfr_t *row = dst + i * num_points;
+        for (std::size_t p = 0; p < num_points; ++p) {
+            mpfr_set(row[p], mat[k * num_points + p], rnd);
+        }
+        ++k;
+        for (std::size_t j = 0; j < i; ++j, ++k) {
+            for (std::size_t p = 0; p < num_points; ++p) {
+                mpfr_add(row[p], row[p], mat[k * num_points + p], rnd);
+            }
+        }
+    }
+}
+
+void lrsd(double *dst,
+          std::size_t dst_size,
+          const double *mat) {
+    std::size_t k = 0;
+    for (std::size_t i = 0; i < dst_size; ++i) {
+        double s = mat[k], c = 0.0, e;
+        ++k;
+        for (std::size_t j = 0; j < i; ++j, ++k) {
+            twsd(s, e, s, mat[k]);
+            c += e;
+        }
+        dst[i] = s + c;
+    }
+}
+
 // =============================================================================
 
 void elmm(mpfr_t *dst,
@@ -78,11 +230,10 @@ void elmm(mpfr_t *dst,
     for (std::size_t i = 0; i < n; ++i) { mpfr_mul(dst[i], v[i], w[i], rnd); }
 }
 
-void elmz(mpfr_t *dst_re, mpfr_t *dst_du,
+void elmt(mpfr_t *dst_du,
           std::size_t n,
           mpfr_t *v_re, mpfr_t *v_du,
           mpfr_t *w_re, mpfr_t *w_du, mpfr_rnd_t rnd) {
-    elmm(dst_re, n, v_re, w_re, rnd);
     for (std::size_t i = 0; i < n; ++i) {
         // TODO: Use mpfr_fmma here when we upgrade to MPFR 4.
         mpfr_mul(dst_du[i], v_du[i], w_re[i], rnd);
@@ -90,6 +241,48 @@ void elmz(mpfr_t *dst_re, mpfr_t *dst_du,
     }
 }
 
+void elmz(mpfr_t *dst_re, mpfr_t *dst_du,
+          std::size_t n,
+          mpfr_t *v_re, mpfr_t *v_du,
+          mpfr_t *w_re, mpfr_t *w_du, mpfr_rnd_t rnd) {
+    elmm(dst_re, n, v_re, w_re, rnd);
+    elmt(dst_du, n, v_re, v_du, w_re, w_du, rnd);
+}
+
+void elma(mpfr_t *v_ad, mpfr_t *w_ad,
+          std::size_t n,
+          mpfr_t *v, mpfr_t *w, mpfr_t *dst_ad, mpfr_rnd_t rnd) {
+    for (std::size_t i = 0; i < n; ++i) {
+        mpfr_fma(v_ad[i], w[i], dst_ad[i], v_ad[i], rnd);
+        mpfr_fma(w_ad[i], v[i], dst_ad[i], w_ad[i], rnd);
+    }
+}
+
+void elmr(mpfr_t *dst_mid, mpfr_t *dst_rad,
+          std::size_t n,
+          mpfr_t *v_mid, mpfr_t *v_rad, mpfr_t *w_mid, mpfr_t *w_rad,
+          mpfr_t tmp, mpfr_rnd_t rnd) {
+    for (std::size_t i = 0; i < n; ++i) {
+        mpfr_set_zero(dst_rad[i], 0);
+        mler(dst_rad[i], v_mid[i], v_rad[i], w_mid[i], w_rad[i], tmp);
+        if (mpfr_mul(dst_mid[i], v_mid[i], w_mid[i], rnd)) {
+            rner(dst_rad[i], dst_mid[i], tmp);
+        }
+    }
+}
+
+void elmb(mpfr_t *dst,
+          std::size_t n, std::size_t num_points,
+          mpfr_t *v, mpfr_t *w, mpfr_rnd_t rnd) {
+    elmm(dst, n * num_points, v, w, rnd);
+}
+
+void elmd(double *dst,
+          std::size_t n,
+          const double *v, const double *w) {
+    for (std::size_t i = 0; i < n; ++i) { dst[i] = v[i] * w[i]; }
+}
+
 // =============================================================================
 
 void esqm(mpfr_t *dst,
@@ -98,16 +291,56 @@ void esqm(mpfr_t *dst,
     for (std::size_t i = 0; i < n; ++i) { mpfr_sqr(dst[i], v[i], rnd); }
 }
 
-void esqz(mpfr_t *dst_re, mpfr_t *dst_du,
+void esqt(mpfr_t *dst_du,
           std::size_t n,
           mpfr_t *v_re, mpfr_t *v_du, mpfr_rnd_t rnd) {
     for (std::size_t i = 0; i < n; ++i) {
         mpfr_mul(dst_du[i], v_re[i], v_du[i], rnd);
         mpfr_mul_2ui(dst_du[i], dst_du[i], 1, rnd);
-        mpfr_sqr(dst_re[i], v_re[i], rnd);
     }
 }
 
+void esqz(mpfr_t *dst_re, mpfr_t *dst_du,
+          std::size_t n,
+          mpfr_t *v_re, mpfr_t *v_du, mpfr_rnd_t rnd) {
+    esqt(dst_du, n, v_re, v_du, rnd);
+    esqm(dst_re, n, v_re, rnd);
+}
+
+void esqa(mpfr_t *v_ad, mpfr_t tmp,
+          std::size_t n,
+          mpfr_t *v, mpfr_t *dst_ad, mpfr_rnd_t rnd) {
+    for (std::size_t i = 0; i < n; ++i) {
+        mpfr_mul(tmp, v[i], dst_ad[i], rnd);
+        mpfr_mul_2ui(tmp, tmp, 1, rnd);
+        mpfr_add(v_ad[i], v_ad[i], tmp, rnd);
+    }
+}
+
+void esqr(mpfr_t *dst_mid, mpfr_t *dst_rad,
+          std::size_t n,
+          mpfr_t *v_mid, mpfr_t *v_rad, mpfr_t tmp, mpfr_rnd_t rnd) {
+    for (std::size_t i = 0; i < n; ++i) {
+        mpfr_set_zero(dst_rad[i], 0);
+        mler(dst_rad[i], v_mid[i], v_rad[i], v_mid[i], v_rad[i], tmp);
+        if (mpfr_sqr(dst_mid[i], v_mid[i], rnd)) {
+            rner(dst_rad[i], dst_mid[i], tmp);
+        }
+    }
+}
+
+void esqb(mpfr_t *dst,
+          std::size_t n, std::size_t num_points,
+          mpfr_t *v, mpfr_rnd_t rnd) {
+    esqm(dst, n * num_points, v, rnd);
+}
+
+void esqd(double *dst,
+          std::size_t n,
+          const double *v) {
+    for (std::size_t i = 0; i < n; ++i) { dst[i] = v[i] * v[i]; }
+}
+
 // =============================================================================
 
 void dotm(mpfr_t dst,
@@ -119,6 +352,53 @@ void dotm(mpfr_t dst,
     }
 }
 
+void dotb(mpfr_t *dst,
+          std::size_t n, std::size_t num_points,
+          mpfr_t *v, mpfr_t *w, mpfr_rnd_t rnd) {
+    for (std::size_t p = 0; p < num_points; ++p) {
+        mpfr_mul(dst[p], v[p], w[p], rnd);
+    }
+    for (std::size_t i = 1; i < n; ++i) {
+        mpfr_t *v_row = v + i * num_points;
+        mpfr_t *w_row = w + i * num_points;
+        for (std::size_t p = 0; p < num_points; ++p) {
+            mpfr_fma(dst[p], v_row[p], w_row[p], dst[p], rnd);
+        }
+    }
+}
+
+// Computes dot(v, w) in ball arithmetic, where w_rad may be a null pointer
+// if w is exact.
+void dotr(mpfr_t dst_mid, mpfr_t dst_rad,
+          std::size_t n,
+          mpfr_t *v_mid, mpfr_t *v_rad, mpfr_t *w_mid, mpfr_t *w_rad,
+          mpfr_t tmp, mpfr_rnd_t rnd) {
+    mpfr_set_zero(dst_rad, 0);
+    for (std::size_t i = 0; i < n; ++i) {
+        mler(dst_rad, v_mid[i], v_rad[i], w_mid[i],
+             (w_rad == nullptr) ? nullptr : w_rad[i], tmp);
+        const int inexact = (i == 0)
+                            ? mpfr_mul(dst_mid, v_mid[i], w_mid[i], rnd)
+                            : mpfr_fma(dst_mid, v_mid[i], w_mid[i],
+                                       dst_mid, rnd);
+        if (inexact) { rner(dst_rad, dst_mid, tmp); }
+    }
+}
+
+// Computes s + c, an unevaluated sum approximating dot(v, w) with twice the
+// accuracy of a plain double-precision dot product (Dot2).
+void dotd(double &s, double &c,
+          std::size_t n,
+          const double *v, const double *w) {
+    double p, q;
+    twpd(s, c, v[0], w[0]);
+    for (std::size_t i = 1; i < n; ++i) {
+        twpd(p, q, v[i], w[i]);
+        twsd(s, p, s, p);
+        c += p + q;
+    }
+}
+
 // =============================================================================
 
 void lvmm(mpfr_t *dst,
@@ -131,11 +411,10 @@ void lvmm(mpfr_t *dst,
     }
 }
 
-void lvms(mpfr_t *dst_re, mpfr_t *dst_du,
+void lvmt(mpfr_t *dst_du,
           std::size_t dst_size, std::size_t mat_size,
           mpfr_t *mat_re, std::size_t mat_di,
           mpfr_t *vec_re, mpfr_t *vec_du, mpfr_rnd_t rnd) {
-    lvmm(dst_re, dst_size, mat_size, mat_re, vec_re, rnd);
     std::size_t skp = mat_size - dst_size;
     std::size_t idx = skp * (skp + 1) / 2 - 1;
     for (std::size_t i = 0; i < dst_size; ++i, idx += skp, ++skp) {
@@ -146,6 +425,77 @@ void lvms(mpfr_t *dst_re, mpfr_t *dst_du,
     }
 }
 
+void lvms(mpfr_t *dst_re, mpfr_t *dst_du,
+          std::size_t dst_size, std::size_t mat_size,
+          mpfr_t *mat_re, std::size_t mat_di,
+          mpfr_t *vec_re, mpfr_t *vec_du, mpfr_rnd_t rnd) {
+    lvmm(dst_re, dst_size, mat_size, mat_re, vec_re, rnd);
+    lvmt(dst_du, dst_size, mat_size, mat_re, mat_di, vec_re, vec_du, rnd);
+}
+
+void lvmz(mpfr_t *dst_re, mpfr_t *dst_du,
+          std::size_t dst_size, std::size_t mat_size,
+          mpfr_t *mat_re, mpfr_t *mat_du,
+          mpfr_t *vec_re, mpfr_t *vec_du, mpfr_rnd_t rnd) {
+    std::size_t skp = mat_size - dst_size;
+    std::size_t idx = skp * (skp + 1) / 2 - 1;
+    for (std::size_t i = 0; i < dst_size; ++i, idx += skp, ++skp) {
+        dotm(dst_re[i], i + 1, mat_re + idx, vec_re, rnd);
+        dotm(dst_du[i], i + 1, mat_re + idx, vec_du, rnd);
+        for (std::size_t j = 0; j <= i; ++j) {
+            mpfr_fma(dst_du[i], mat_du[idx + j], vec_re[j], dst_du[i], rnd);
+        }
+    }
+}
+
+void lvma(mpfr_t *mat_ad, mpfr_t *vec_ad,
+          std::size_t dst_size, std::size_t mat_size,
+          mpfr_t *mat, mpfr_t *vec, mpfr_t *dst_ad, mpfr_rnd_t rnd) {
+    std::size_t skp = mat_size - dst_size;
+    std::size_t idx = skp * (skp + 1) / 2 - 1;
+    for (std::size_t i = 0; i < dst_size; ++i, idx += skp, ++skp) {
+        for (std::size_t j = 0; j <= i; ++j) {
+            mpfr_fma(mat_ad[idx + j], dst_ad[i], vec[j], mat_ad[idx + j], rnd);
+            mpfr_fma(vec_ad[j], dst_ad[i], mat[idx + j], vec_ad[j], rnd);
+        }
+    }
+}
+
+void lvmr(mpfr_t *dst_mid, mpfr_t *dst_rad,
+          std::size_t dst_size, std::size_t mat_size,
+          mpfr_t *mat, mpfr_t *vec_mid, mpfr_t *vec_rad,
+          mpfr_t tmp, mpfr_rnd_t rnd) {
+    std::size_t skp = mat_size - dst_size;
+    std::size_t idx = skp * (skp + 1) / 2 - 1;
+    for (std::size_t i = 0; i < dst_size; ++i, idx += skp, ++skp) {
+        dotr(dst_mid[i], dst_rad[i], i + 1, vec_mid, vec_rad,
+             mat + idx, nullptr, tmp, rnd);
+    }
+}
+
+void lvmb(mpfr_t *dst,
+          std::size_t dst_size, std::size_t mat_size, std::size_t num_points,
+          mpfr_t *mat, mpfr_t *vec, mpfr_rnd_t rnd) {
+    std::size_t skp = mat_size - dst_size;
+    std::size_t idx = skp * (skp + 1) / 2 - 1;
+    for (std::size_t i = 0; i < dst_size; ++i, idx += skp, ++skp) {
+        dotb(dst + i * num_points, i + 1, num_points,
+             mat + idx * num_points, vec, rnd);
+    }
+}
+
+void lvmd(double *dst,
+          std::size_t dst_size, std::size_t mat_size,
+          const double *mat, const double *vec) {
+    std::size_t skp = mat_size - dst_size;
+    std::size_t idx = skp * (skp + 1) / 2 - 1;
+    double s, c;
+    for (std::size_t i = 0; i < dst_size; ++i, idx += skp, ++skp) {
+        dotd(s, c, i + 1, mat + idx, vec);
+        dst[i] = s + c;
+    }
+}
+
 // =============================================================================
 
 void srim(mpfr_t dst, unsigned long int src, mpfr_rnd_t rnd) {
@@ -153,6 +503,26 @@ void srim(mpfr_t dst, unsigned long int src, mpfr_rnd_t rnd) {
     mpfr_ui_div(dst, 1, dst, rnd);
 }
 
+void srir(mpfr_t dst_mid, mpfr_t dst_rad,
+          unsigned long int src, mpfr_t tmp, mpfr_rnd_t rnd) {
+    mpfr_set_zero(dst_rad, 0);
+    if (mpfr_set_ui(dst_mid, src, rnd)) {
+        // Never happens in practice, since every gamma fits in 32 bits.
+        mpfr_set_inf(dst_rad, 1);
+    }
+    if (mpfr_ui_div(dst_mid, 1, dst_mid, rnd)) {
+        rner(dst_rad, dst_mid, tmp);
+    }
+}
+
+// Computes hi + lo, an unevaluated sum approximating 1 / src with twice the
+// accuracy of a double-precision division.
+void srid(double &hi, double &lo, unsigned long int src) {
+    const double d = static_cast<double>(src);
+    hi = 1.0 / d;
+    lo = std::fma(-hi, d, 1.0) / d;
+}
+
 // =============================================================================
 
 void ress(mpfr_t dst, mpfr_t tmp_re, mpfr_t tmp_du,
@@ -170,6 +540,19 @@ void ress(mpfr_t dst, mpfr_t tmp_re, mpfr_t tmp_du,
     mpfr_fma(dst, tmp_re, tmp_du, dst, rnd);
 }
 
+void rest(mpfr_t dst, mpfr_t res, mpfr_t tmp_du,
+          std::size_t n,
+          mpfr_t *m_re, mpfr_t *m_du, std::size_t m_offset,
+          mpfr_t *x_re, std::size_t x_di, std::size_t x_offset,
+          mpfr_rnd_t rnd) {
+    dotm(tmp_du, n, m_du + m_offset, x_re + x_offset, rnd);
+    if (x_offset <= x_di && x_di < x_offset + n) {
+        mpfr_add(tmp_du, tmp_du, m_re[m_offset + (x_di - x_offset)], rnd);
+    }
+    mpfr_mul_2ui(tmp_du, tmp_du, 1, rnd);
+    mpfr_fma(dst, res, tmp_du, dst, rnd);
+}
+
 void resm(mpfr_t f, mpfr_t tmp,
           std::size_t n,
           mpfr_t *m, mpfr_t *x, mpfr_t gamma, mpfr_rnd_t rnd) {
@@ -178,6 +561,79 @@ void resm(mpfr_t f, mpfr_t tmp,
     mpfr_fma(f, tmp, tmp, f, rnd);
 }
 
+// Adds the square of the residual dot(m, x) - gamma to f, exactly as resm
+// does, and the derivative of that square along the dual parts of m and x
+// to df.
+void resz(mpfr_t f, mpfr_t df, mpfr_t tmp_re, mpfr_t tmp_du,
+          std::size_t n,
+          mpfr_t *m_re, mpfr_t *m_du, mpfr_t *x_re, mpfr_t *x_du,
+          mpfr_t gamma, mpfr_rnd_t rnd) {
+    resm(f, tmp_re, n, m_re, x_re, gamma, rnd);
+    dotm(tmp_du, n, m_du, x_re, rnd);
+    for (std::size_t i = 0; i < n; ++i) {
+        mpfr_fma(tmp_du, m_re[i], x_du[i], tmp_du, rnd);
+    }
+    mpfr_mul_2ui(tmp_du, tmp_du, 1, rnd);
+    mpfr_fma(df, tmp_re, tmp_du, df, rnd);
+}
+
+// Adds the contribution of a residual dot(m, x) - gamma with adjoint res_ad
+// to the adjoints of m and x.
+void resa(mpfr_t *m_ad, mpfr_t *x_ad,
+          std::size_t n,
+          mpfr_t *m, mpfr_t *x, mpfr_t res_ad, mpfr_rnd_t rnd) {
+    for (std::size_t i = 0; i < n; ++i) {
+        mpfr_fma(m_ad[i], res_ad, x[i], m_ad[i], rnd);
+        mpfr_fma(x_ad[i], res_ad, m[i], x_ad[i], rnd);
+    }
+}
+
+void resb(mpfr_t *f, mpfr_t *tmp,
+          std::size_t n, std::size_t num_points,
+          mpfr_t *m, mpfr_t *x, mpfr_t gamma, mpfr_rnd_t rnd) {
+    dotb(tmp, n, num_points, m, x, rnd);
+    for (std::size_t p = 0; p < num_points; ++p) {
+        mpfr_sub(tmp[p], tmp[p], gamma, rnd);
+        mpfr_fma(f[p], tmp[p], tmp[p], f[p], rnd);
+    }
+}
+
+// Adds the squared residual res = dot(m, x) - gamma to f in ball
+// arithmetic, leaving the residual in res.
+void resr(mpfr_t f_mid, mpfr_t f_rad, mpfr_t res_mid, mpfr_t res_rad,
+          std::size_t n,
+          mpfr_t *m_mid, mpfr_t *m_rad, mpfr_t *x,
+          mpfr_t gamma_mid, mpfr_t gamma_rad, mpfr_t tmp, mpfr_rnd_t rnd) {
+    dotr(res_mid, res_rad, n, m_mid, m_rad, x, nullptr, tmp, rnd);
+    mpfr_add(res_rad, res_rad, gamma_rad, MPFR_RNDU);
+    if (mpfr_sub(res_mid, res_mid, gamma_mid, rnd)) {
+        rner(res_rad, res_mid, tmp);
+    }
+    mler(f_rad, res_mid, res_rad, res_mid, res_rad, tmp);
+    if (mpfr_fma(f_mid, res_mid, res_mid, f_mid, rnd)) {
+        rner(f_rad, f_mid, tmp);
+    }
+}
+
+// Adds the squared residual dot(m, x) - (gamma_hi + gamma_lo) to the
+// compensated sum f_hi + f_lo (Sum2), and returns the residual. The
+// subtraction of gamma is folded into the compensated dot product, so the
+// cancellation between its two terms costs no accuracy.
+double resd(double &f_hi, double &f_lo,
+            std::size_t n,
+            const double *m, const double *x,
+            double gamma_hi, double gamma_lo) {
+    double s, c, e, p, q;
+    dotd(s, c, n, m, x);
+    twsd(s, e, s, -gamma_hi);
+    c += e - gamma_lo;
+    const double res = s + c;
+    twpd(p, q, res, res);
+    twsd(f_hi, e, f_hi, p);
+    f_lo += e + q;
+    return res;
+}
+
 // =============================================================================
 
 #endif // RKTK_ORDER_CONDITION_HELPERS_HPP_INCLUDED
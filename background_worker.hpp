@@ -0,0 +1,154 @@
+#ifndef RKTK_BACKGROUND_WORKER_HPP_INCLUDED
+#define RKTK_BACKGROUND_WORKER_HPP_INCLUDED
+
+// C++ standard library headers
+#include <condition_variable> // for std::condition_variable
+#include <cstddef>            // for std::size_t
+#include <functional>         // for std::function
+#include <mutex>              // for std::mutex, std::unique_lock
+#include <thread>             // for std::thread
+#include <utility>            // for std::move
+#include <vector>             // for std::vector
+
+/*
+ * BackgroundWorker owns a single thread that runs one task at a time on
+ * behalf of its creator. The thread persists for the lifetime of the
+ * worker, so the thread-local workspaces of the objective function
+ * evaluators (see scheduled_evaluators.hpp) are allocated once rather than
+ * once per task, and are reused for as long as the working precision stays
+ * the same.
+ *
+ * A task is started by start and must be waited for by wait before the
+ * next one is started. The task may read any data its creator does not
+ * modify in the meantime, and the creator may read its results after wait
+ * returns.
+ */
+class BackgroundWorker {
+
+private: // ======================================================= DATA MEMBERS
+
+    std::mutex mutex;
+    std::condition_variable state_changed;
+    std::function<void()> task;
+    bool has_task;
+    bool stopping;
+    std::thread thread;
+
+public: // ======================================================== CONSTRUCTORS
+
+    BackgroundWorker() :
+            has_task(false), stopping(false),
+            thread(&BackgroundWorker::run, this) {}
+
+    // explicitly disallow copy construction
+    BackgroundWorker(const BackgroundWorker &) = delete;
+
+    // explicitly disallow copy assignment
+    BackgroundWorker &operator=(const BackgroundWorker &) = delete;
+
+public: // ========================================================== DESTRUCTOR
+
+    ~BackgroundWorker() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        state_changed.notify_all();
+        thread.join();
+    }
+
+public: // ============================================================ MUTATORS
+
+    // Runs f on the worker thread and returns immediately.
+    void start(std::function<void()> f) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            task = std::move(f);
+            has_task = true;
+        }
+        state_changed.notify_all();
+    }
+
+    // Blocks until the task passed to the last call of start has finished.
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex);
+        state_changed.wait(lock, [this] { return !has_task; });
+    }
+
+private: // ===================================================== HELPER METHODS
+
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            state_changed.wait(lock, [this] { return has_task || stopping; });
+            if (has_task) {
+                lock.unlock();
+                task();
+                lock.lock();
+                task = nullptr;
+                has_task = false;
+                state_changed.notify_all();
+            } else {
+                return;
+            }
+        }
+    }
+
+};
+
+/*
+ * WorkerPool runs batches of independent tasks on a fixed set of
+ * BackgroundWorker threads together with the calling thread. Task i of a
+ * batch runs on thread i mod get_thread_count(), where thread zero is the
+ * calling thread.
+ */
+class WorkerPool {
+
+private: // ======================================================= DATA MEMBERS
+
+    std::vector<BackgroundWorker *> workers;
+
+public: // ======================================================== CONSTRUCTORS
+
+    // Creates a pool of num_threads threads (including the calling thread),
+    // where num_threads >= 1.
+    explicit WorkerPool(std::size_t num_threads) {
+        for (std::size_t i = 1; i < num_threads; ++i) {
+            workers.push_back(new BackgroundWorker());
+        }
+    }
+
+    // explicitly disallow copy construction
+    WorkerPool(const WorkerPool &) = delete;
+
+    // explicitly disallow copy assignment
+    WorkerPool &operator=(const WorkerPool &) = delete;
+
+public: // ========================================================== DESTRUCTOR
+
+    ~WorkerPool() {
+        for (BackgroundWorker *worker : workers) { delete worker; }
+    }
+
+public: // =========================================================== ACCESSORS
+
+    std::size_t get_thread_count() const { return workers.size() + 1; }
+
+public: // ============================================================ MUTATORS
+
+    // Calls task(i) for i = 0, ..., n - 1, and returns once all calls have
+    // finished.
+    void run(std::size_t n, const std::function<void(std::size_t)> &task) {
+        const std::size_t stride = get_thread_count();
+        for (std::size_t w = 0; w < workers.size(); ++w) {
+            workers[w]->start([&task, n, stride, w] {
+                for (std::size_t i = w + 1; i < n; i += stride) { task(i); }
+            });
+        }
+        for (std::size_t i = 0; i < n; i += stride) { task(i); }
+        for (BackgroundWorker *worker : workers) { worker->wait(); }
+    }
+
+};
+
+#endif // RKTK_BACKGROUND_WORKER_HPP_INCLUDED
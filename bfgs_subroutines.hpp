@@ -10,6 +10,7 @@
 // Project-specific headers
 #include <dznl/MPFRVector.hpp>
 #include "objective_function.hpp" // for objective_function
+#include "symmetric_matrix.hpp"   // for PackedSymmetricMatrix
 
 static inline void dot(mpfr_t dst,
                        const dznl::MPFRVector &v, const dznl::MPFRVector &w,
@@ -20,13 +21,14 @@ static inline void dot(mpfr_t dst,
     }
 }
 
-void update_inverse_hessian(dznl::MPFRMatrix &inv_hess,
+void update_inverse_hessian(PackedSymmetricMatrix &inv_hess,
                             const dznl::MPFRVector &delta_gradient,
                             mpfr_t step_size,
                             const dznl::MPFRVector &step_direction,
                             mpfr_prec_t prec, mpfr_rnd_t rnd) {
     static dznl::MPFRVector *kappa = nullptr;
     static mpfr_t theta, lambda, sigma, beta, alpha;
+    static mpfr_prec_t workspace_prec = 0;
     if (kappa == nullptr) {
         kappa = new dznl::MPFRVector(NUM_VARS, prec);
         mpfr_init2(theta, prec);
@@ -34,9 +36,20 @@ void update_inverse_hessian(dznl::MPFRMatrix &inv_hess,
         mpfr_init2(sigma, prec);
         mpfr_init2(beta, prec);
         mpfr_init2(alpha, prec);
+        workspace_prec = prec;
+    } else if (workspace_prec != prec) {
+        // The working precision has changed (adaptive precision mode).
+        delete kappa;
+        kappa = new dznl::MPFRVector(NUM_VARS, prec);
+        mpfr_set_prec(theta, prec);
+        mpfr_set_prec(lambda, prec);
+        mpfr_set_prec(sigma, prec);
+        mpfr_set_prec(beta, prec);
+        mpfr_set_prec(alpha, prec);
+        workspace_prec = prec;
     }
     // nan_check("during initialization of inverse hessian update workspace");
-    kappa->set_matrix_vector_multiply(inv_hess, delta_gradient, rnd);
+    inv_hess.multiply(*kappa, delta_gradient, rnd);
     // nan_check("during evaluation of kappa");
     dot(theta, delta_gradient, *kappa, rnd);
     // nan_check("during evaluation of theta");
@@ -56,17 +69,11 @@ void update_inverse_hessian(dznl::MPFRMatrix &inv_hess,
     }
     mpfr_div(alpha, step_size, lambda, rnd);
     mpfr_neg(alpha, alpha, rnd);
-    for (std::size_t i = 0, k = 0; i < NUM_VARS; ++i) {
-        for (std::size_t j = 0; j < NUM_VARS; ++j, ++k) {
-            mpfr_mul(beta, (*kappa)[i], step_direction[j], rnd);
-            mpfr_fma(beta, step_direction[i], (*kappa)[j], beta, rnd);
-            mpfr_fma(inv_hess.data()[k], alpha, beta, inv_hess.data()[k], rnd);
-        }
-    }
+    inv_hess.rank_two_update(alpha, *kappa, step_direction, rnd);
 }
 
 void update_inverse_hessian_mbfgst(
-        dznl::MPFRMatrix &inv_hess,
+        PackedSymmetricMatrix &inv_hess,
         mpfr_t func, mpfr_t func_new,
         const dznl::MPFRVector &grad, const dznl::MPFRVector &grad_new,
         const dznl::MPFRVector &delta_gradient,
@@ -75,11 +82,22 @@ void update_inverse_hessian_mbfgst(
         mpfr_prec_t prec, mpfr_rnd_t rnd) {
     static dznl::MPFRVector *w = nullptr;
     static mpfr_t phi, phi_0, t0, t1, t2, t3, beta, rho;
+    static mpfr_prec_t workspace_prec = 0;
     if (w == nullptr) {
         w = new dznl::MPFRVector(NUM_VARS, prec);
         mpfr_inits2(prec,
                     phi, phi_0, t0, t1, t2, t3, beta, rho,
                     static_cast<mpfr_ptr>(nullptr));
+        workspace_prec = prec;
+    } else if (workspace_prec != prec) {
+        delete w;
+        w = new dznl::MPFRVector(NUM_VARS, prec);
+        mpfr_clears(phi, phi_0, t0, t1, t2, t3, beta, rho,
+                    static_cast<mpfr_ptr>(nullptr));
+        mpfr_inits2(prec,
+                    phi, phi_0, t0, t1, t2, t3, beta, rho,
+                    static_cast<mpfr_ptr>(nullptr));
+        workspace_prec = prec;
     }
     // nan_check("during initialization of inverse hessian update workspace");
     mpfr_sub(phi, func, func_new, rnd);
@@ -92,7 +110,7 @@ void update_inverse_hessian_mbfgst(
     // phi_0 = 2 * step_size * dot(grad + grad_new, step_direction);
     mpfr_add(phi, phi, phi_0, rnd);
     // phi += phi_0; calculation of phi completed.
-    w->set_matrix_vector_multiply(inv_hess, delta_gradient, rnd);
+    inv_hess.multiply(*w, delta_gradient, rnd);
     dot(t0, step_direction, delta_gradient, rnd);
     mpfr_si_div(t1, +1, t0, rnd);
     dot(t2, delta_gradient, *w, rnd);
@@ -103,13 +121,163 @@ void update_inverse_hessian_mbfgst(
     mpfr_fma(t3, t1, t2, t3, rnd);
     mpfr_div_2si(t3, t3, +1, rnd);
     w->set_axmy(t3, step_direction, *w, rnd);
-    for (std::size_t i = 0, k = 0; i < NUM_VARS; ++i) {
-        for (std::size_t j = 0; j < NUM_VARS; ++j, ++k) {
-            mpfr_mul(t0, (*w)[i], step_direction[j], rnd);
-            mpfr_fma(t0, step_direction[i], (*w)[j], t0, rnd);
-            mpfr_fma(inv_hess.data()[k], t1, t0, inv_hess.data()[k], rnd);
+    inv_hess.rank_two_update(t1, *w, step_direction, rnd);
+}
+
+/*
+ * LimitedMemoryInverseHessian represents the approximate inverse Hessian of
+ * limited-memory BFGS implicitly by the most recent history_length pairs
+ * (s, y) of steps and gradient differences. Its product with a vector is
+ * computed by the two-loop recursion of Nocedal (1980) in about
+ * 4 * history_length * NUM_VARS operations, replacing the NUM_VARS^2
+ * operations (and storage) of the dense matrix. The initial approximation
+ * is the identity scaled by dot(s, y) / dot(y, y) of the most recent pair.
+ */
+class LimitedMemoryInverseHessian {
+
+private: // ======================================================= DATA MEMBERS
+
+    std::size_t capacity;
+    std::size_t num_pairs;
+    std::size_t newest;
+    mpfr_t *s;     // pair i occupies entries [i * NUM_VARS, (i + 1) * NUM_VARS)
+    mpfr_t *y;
+    mpfr_t *rho;   // rho[i] = 1 / dot(s_i, y_i)
+    mpfr_t *alpha;
+    mpfr_t gamma, t;
+
+public: // ======================================================== CONSTRUCTORS
+
+    LimitedMemoryInverseHessian(std::size_t history_length, mpfr_prec_t prec) :
+            capacity(history_length), num_pairs(0), newest(0),
+            s(new mpfr_t[history_length * NUM_VARS]),
+            y(new mpfr_t[history_length * NUM_VARS]),
+            rho(new mpfr_t[history_length]),
+            alpha(new mpfr_t[history_length]) {
+        for (std::size_t i = 0; i < capacity * NUM_VARS; ++i) {
+            mpfr_init2(s[i], prec);
+            mpfr_init2(y[i], prec);
         }
+        for (std::size_t i = 0; i < capacity; ++i) {
+            mpfr_init2(rho[i], prec);
+            mpfr_init2(alpha[i], prec);
+        }
+        mpfr_init2(gamma, prec);
+        mpfr_init2(t, prec);
     }
-}
+
+    // explicitly disallow copy construction
+    LimitedMemoryInverseHessian(const LimitedMemoryInverseHessian &) = delete;
+
+    // explicitly disallow copy assignment
+    LimitedMemoryInverseHessian &
+    operator=(const LimitedMemoryInverseHessian &) = delete;
+
+public: // ========================================================== DESTRUCTOR
+
+    ~LimitedMemoryInverseHessian() {
+        for (std::size_t i = 0; i < capacity * NUM_VARS; ++i) {
+            mpfr_clear(s[i]);
+            mpfr_clear(y[i]);
+        }
+        for (std::size_t i = 0; i < capacity; ++i) {
+            mpfr_clear(rho[i]);
+            mpfr_clear(alpha[i]);
+        }
+        mpfr_clear(gamma);
+        mpfr_clear(t);
+        delete[] s;
+        delete[] y;
+        delete[] rho;
+        delete[] alpha;
+    }
+
+public: // =========================================================== ACCESSORS
+
+    std::size_t get_history_length() const { return capacity; }
+
+    // Computes dst = H * v by the two-loop recursion. dst and v must be
+    // distinct vectors.
+    void multiply(dznl::MPFRVector &dst, const dznl::MPFRVector &v,
+                  mpfr_rnd_t rnd) {
+        dst = v;
+        if (num_pairs == 0) { return; }
+        std::size_t i = newest;
+        for (std::size_t k = 0; k < num_pairs; ++k) {
+            dot_pair(alpha[i], s + i * NUM_VARS, dst, rnd);
+            mpfr_mul(alpha[i], alpha[i], rho[i], rnd);
+            for (std::size_t j = 0; j < NUM_VARS; ++j) {
+                mpfr_mul(t, alpha[i], y[i * NUM_VARS + j], rnd);
+                mpfr_sub(dst[j], dst[j], t, rnd);
+            }
+            i = (i == 0) ? capacity - 1 : i - 1;
+        }
+        for (std::size_t j = 0; j < NUM_VARS; ++j) {
+            mpfr_mul(dst[j], dst[j], gamma, rnd);
+        }
+        for (std::size_t k = 0; k < num_pairs; ++k) {
+            i = (i + 1 == capacity) ? 0 : i + 1;
+            dot_pair(t, y + i * NUM_VARS, dst, rnd);
+            mpfr_mul(t, t, rho[i], rnd);
+            mpfr_sub(t, alpha[i], t, rnd);
+            for (std::size_t j = 0; j < NUM_VARS; ++j) {
+                mpfr_fma(dst[j], t, s[i * NUM_VARS + j], dst[j], rnd);
+            }
+        }
+    }
+
+public: // ============================================================ MUTATORS
+
+    // Discards all pairs, resetting the approximation to the identity.
+    void clear() { num_pairs = 0; }
+
+    // Records the pair s = step_size * step_direction, y = delta_gradient,
+    // evicting the oldest pair if the history is full. Pairs of non-positive
+    // curvature dot(s, y) <= 0 are skipped, since they would make the
+    // approximation indefinite.
+    void update(const dznl::MPFRVector &delta_gradient, mpfr_t step_size,
+                const dznl::MPFRVector &step_direction, mpfr_rnd_t rnd) {
+        if (capacity == 0) { return; }
+        dot(t, step_direction, delta_gradient, rnd);
+        mpfr_mul(t, t, step_size, rnd);
+        if (!mpfr_regular_p(t) || (mpfr_sgn(t) <= 0)) { return; }
+        const std::size_t i = (num_pairs == 0) ? 0
+                              : (newest + 1 == capacity) ? 0 : newest + 1;
+        for (std::size_t j = 0; j < NUM_VARS; ++j) {
+            mpfr_mul(s[i * NUM_VARS + j], step_size, step_direction[j], rnd);
+            mpfr_set(y[i * NUM_VARS + j], delta_gradient[j], rnd);
+        }
+        mpfr_ui_div(rho[i], 1, t, rnd);
+        dot(gamma, delta_gradient, delta_gradient, rnd);
+        mpfr_div(gamma, t, gamma, rnd);
+        newest = i;
+        if (num_pairs < capacity) { ++num_pairs; }
+    }
+
+    // Changes the precision of all stored pairs, rounding their values.
+    void set_precision(mpfr_prec_t prec, mpfr_rnd_t rnd) {
+        for (std::size_t i = 0; i < capacity * NUM_VARS; ++i) {
+            mpfr_prec_round(s[i], prec, rnd);
+            mpfr_prec_round(y[i], prec, rnd);
+        }
+        for (std::size_t i = 0; i < capacity; ++i) {
+            mpfr_prec_round(rho[i], prec, rnd);
+            mpfr_set_prec(alpha[i], prec);
+        }
+        mpfr_prec_round(gamma, prec, rnd);
+        mpfr_set_prec(t, prec);
+    }
+
+private: // ===================================================== HELPER METHODS
+
+    static void dot_pair(mpfr_t dst, const mpfr_t *v,
+                         const dznl::MPFRVector &w, mpfr_rnd_t rnd) {
+        mpfr_mul(dst, v[0], w[0], rnd);
+        for (std::size_t j = 1; j < NUM_VARS; ++j) {
+            mpfr_fma(dst, v[j], w[j], dst, rnd);
+        }
+    }
+
+};
 
 #endif // RKTK_BFGS_SUBROUTINES_HPP_INCLUDED
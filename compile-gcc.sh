@@ -14,5 +14,5 @@ mkdir -p bin
 
 g++-8 -std=c++17 $GCC_FLAGS -c objective_function.cpp -o obj/objective_function.o
 g++-8 -std=c++17 $GCC_FLAGS -c bfgs_subroutines.cpp -o obj/bfgs_subroutines.o
-g++-8 -std=c++17 $GCC_OPT_FLAGS rksearch_main.cpp obj/*.o -o bin/$EXE_NAME -lmpfr -lgmp
+g++-8 -std=c++17 $GCC_OPT_FLAGS rksearch_main.cpp obj/*.o -o bin/$EXE_NAME -lmpfr -lgmp -pthread
 rm obj/*.o
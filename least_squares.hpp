@@ -0,0 +1,414 @@
+#ifndef RKTK_LEAST_SQUARES_HPP_INCLUDED
+#define RKTK_LEAST_SQUARES_HPP_INCLUDED
+
+// C++ standard library headers
+#include <cstddef> // for std::size_t
+#include <utility> // for std::swap
+
+// GNU MPFR multiprecision library headers
+#include <mpfr.h>
+
+// RKTK headers
+#include "objective_function.hpp"    // for NUM_VARS
+#include "scheduled_evaluators.hpp" // for NUM_RESIDUALS
+
+// Project-specific headers
+#include <dznl/MPFRVector.hpp>
+
+// Computes the gradient 2 J^T r of the sum of squares of the NUM_RESIDUALS
+// residuals res, given their Jacobian jac in row-major order.
+void residual_gradient(dznl::MPFRVector &dst, mpfr_t *res, mpfr_t *jac,
+                       mpfr_rnd_t rnd) {
+    for (std::size_t i = 0; i < NUM_VARS; ++i) { mpfr_set_zero(dst[i], 0); }
+    for (std::size_t k = 0; k < NUM_RESIDUALS; ++k) {
+        if (mpfr_zero_p(res[k])) { continue; }
+        for (std::size_t i = 0; i < NUM_VARS; ++i) {
+            mpfr_fma(dst[i], res[k], jac[k * NUM_VARS + i], dst[i], rnd);
+        }
+    }
+    for (std::size_t i = 0; i < NUM_VARS; ++i) {
+        mpfr_mul_2ui(dst[i], dst[i], 1, rnd);
+    }
+}
+
+/*
+ * LevenbergMarquardtSolver holds the state of a Levenberg-Marquardt (damped
+ * Gauss-Newton) iteration on the NUM_RESIDUALS residuals r whose squares sum
+ * to the objective function f = dot(r, r). Given the Jacobian J of r at the
+ * current point, each trial step delta solves the damped normal equations
+ *
+ *     (J^T J + lambda I) delta = -J^T r,
+ *
+ * and minimizes dot(r + J delta, r + J delta) + lambda dot(delta, delta).
+ * The damping parameter lambda is adapted by the gain-ratio rule of Nielsen
+ * (1999): it shrinks after successful steps and grows geometrically after
+ * rejected ones, so the iteration interpolates between gradient descent and
+ * the quadratically convergent Gauss-Newton method.
+ *
+ * Residuals and Jacobians are stored both for the current point and for the
+ * most recent trial point, which becomes current when the trial step is
+ * accepted.
+ */
+class LevenbergMarquardtSolver {
+
+private: // ======================================================= DATA MEMBERS
+
+    mpfr_t *res, *jac;         // at the current point
+    mpfr_t *res_new, *jac_new; // at the most recent trial point
+    mpfr_t *normal;            // J^T J, stored in row-major order
+    mpfr_t *chol;              // Cholesky factor of J^T J + lambda I
+    mpfr_t *rhs;               // J^T r
+    mpfr_t lambda, nu, tmp;
+    bool has_damping;
+
+public: // ======================================================== CONSTRUCTORS
+
+    explicit LevenbergMarquardtSolver(mpfr_prec_t prec) :
+            res(new mpfr_t[NUM_RESIDUALS]),
+            jac(new mpfr_t[NUM_RESIDUALS * NUM_VARS]),
+            res_new(new mpfr_t[NUM_RESIDUALS]),
+            jac_new(new mpfr_t[NUM_RESIDUALS * NUM_VARS]),
+            normal(new mpfr_t[NUM_VARS * NUM_VARS]),
+            chol(new mpfr_t[NUM_VARS * NUM_VARS]),
+            rhs(new mpfr_t[NUM_VARS]),
+            has_damping(false) {
+        for (std::size_t k = 0; k < NUM_RESIDUALS; ++k) {
+            mpfr_init2(res[k], prec);
+            mpfr_init2(res_new[k], prec);
+        }
+        for (std::size_t k = 0; k < NUM_RESIDUALS * NUM_VARS; ++k) {
+            mpfr_init2(jac[k], prec);
+            mpfr_init2(jac_new[k], prec);
+        }
+        for (std::size_t k = 0; k < NUM_VARS * NUM_VARS; ++k) {
+            mpfr_init2(normal[k], prec);
+            mpfr_init2(chol[k], prec);
+        }
+        for (std::size_t i = 0; i < NUM_VARS; ++i) {
+            mpfr_init2(rhs[i], prec);
+        }
+        mpfr_inits2(prec, lambda, nu, tmp, static_cast<mpfr_ptr>(nullptr));
+    }
+
+    // explicitly disallow copy construction
+    LevenbergMarquardtSolver(const LevenbergMarquardtSolver &) = delete;
+
+    // explicitly disallow copy assignment
+    LevenbergMarquardtSolver &
+    operator=(const LevenbergMarquardtSolver &) = delete;
+
+public: // ========================================================== DESTRUCTOR
+
+    ~LevenbergMarquardtSolver() {
+        for (std::size_t k = 0; k < NUM_RESIDUALS; ++k) {
+            mpfr_clear(res[k]);
+            mpfr_clear(res_new[k]);
+        }
+        for (std::size_t k = 0; k < NUM_RESIDUALS * NUM_VARS; ++k) {
+            mpfr_clear(jac[k]);
+            mpfr_clear(jac_new[k]);
+        }
+        for (std::size_t k = 0; k < NUM_VARS * NUM_VARS; ++k) {
+            mpfr_clear(normal[k]);
+            mpfr_clear(chol[k]);
+        }
+        for (std::size_t i = 0; i < NUM_VARS; ++i) { mpfr_clear(rhs[i]); }
+        mpfr_clears(lambda, nu, tmp, static_cast<mpfr_ptr>(nullptr));
+        delete[] res;
+        delete[] jac;
+        delete[] res_new;
+        delete[] jac_new;
+        delete[] normal;
+        delete[] chol;
+        delete[] rhs;
+    }
+
+public: // =========================================================== ACCESSORS
+
+    mpfr_t *residuals() { return res; }
+
+    mpfr_t *jacobian() { return jac; }
+
+    mpfr_t *new_residuals() { return res_new; }
+
+    mpfr_t *new_jacobian() { return jac_new; }
+
+    mpfr_ptr damping() { return lambda; }
+
+    // Computes the gradient of the objective function at the current point,
+    // or at the trial point if at_new_point is true.
+    void gradient(dznl::MPFRVector &dst, bool at_new_point, mpfr_rnd_t rnd) {
+        residual_gradient(dst, at_new_point ? res_new : res,
+                          at_new_point ? jac_new : jac, rnd);
+    }
+
+public: // ============================================================ MUTATORS
+
+    // Forgets the damping parameter, so that it is chosen afresh from the
+    // next Jacobian.
+    void reset() { has_damping = false; }
+
+    // Changes the precision of all workspace variables, discarding the
+    // stored residuals and Jacobians. The damping parameter is kept.
+    void set_precision(mpfr_prec_t prec, mpfr_rnd_t rnd) {
+        set_workspace_precision(res, NUM_RESIDUALS, prec);
+        set_workspace_precision(res_new, NUM_RESIDUALS, prec);
+        set_workspace_precision(jac, NUM_RESIDUALS * NUM_VARS, prec);
+        set_workspace_precision(jac_new, NUM_RESIDUALS * NUM_VARS, prec);
+        set_workspace_precision(normal, NUM_VARS * NUM_VARS, prec);
+        set_workspace_precision(chol, NUM_VARS * NUM_VARS, prec);
+        set_workspace_precision(rhs, NUM_VARS, prec);
+        mpfr_prec_round(lambda, prec, rnd);
+        mpfr_prec_round(nu, prec, rnd);
+        mpfr_set_prec(tmp, prec);
+    }
+
+    // Makes the trial point current.
+    void accept_new_point() {
+        std::swap(res, res_new);
+        std::swap(jac, jac_new);
+    }
+
+    // Forms the normal equations J^T J and J^T r at the current point. If no
+    // damping parameter has been chosen yet, it is initialized to 10^(-3)
+    // times the largest diagonal entry of J^T J.
+    void prepare(mpfr_rnd_t rnd) {
+        for (std::size_t i = 0; i < NUM_VARS; ++i) {
+            for (std::size_t j = i; j < NUM_VARS; ++j) {
+                mpfr_ptr a = normal[i * NUM_VARS + j];
+                mpfr_set_zero(a, 0);
+                for (std::size_t k = 0; k < NUM_RESIDUALS; ++k) {
+                    mpfr_fma(a, jac[k * NUM_VARS + i],
+                             jac[k * NUM_VARS + j], a, rnd);
+                }
+                mpfr_set(normal[j * NUM_VARS + i], a, rnd);
+            }
+            mpfr_set_zero(rhs[i], 0);
+            for (std::size_t k = 0; k < NUM_RESIDUALS; ++k) {
+                mpfr_fma(rhs[i], jac[k * NUM_VARS + i], res[k], rhs[i], rnd);
+            }
+        }
+        if (!has_damping) {
+            mpfr_set_zero(lambda, 0);
+            for (std::size_t i = 0; i < NUM_VARS; ++i) {
+                mpfr_max(lambda, lambda, normal[i * NUM_VARS + i], rnd);
+            }
+            mpfr_div_ui(lambda, lambda, 1000, rnd);
+            mpfr_set_ui(nu, 2, rnd);
+            has_damping = true;
+        }
+    }
+
+    // Solves the damped normal equations for the trial step delta, and
+    // stores the reduction in dot(r + J delta, r + J delta) it predicts,
+    // namely lambda dot(delta, delta) - dot(J^T r, delta), in predicted.
+    // Returns false if J^T J + lambda I is not numerically positive
+    // definite, in which case the damping should be increased.
+    bool solve(dznl::MPFRVector &delta, mpfr_t predicted, mpfr_rnd_t rnd) {
+        // Cholesky factorization J^T J + lambda I = L L^T, with L stored in
+        // the lower triangle of chol.
+        for (std::size_t j = 0; j < NUM_VARS; ++j) {
+            mpfr_ptr l_jj = chol[j * NUM_VARS + j];
+            mpfr_add(l_jj, normal[j * NUM_VARS + j], lambda, rnd);
+            for (std::size_t k = 0; k < j; ++k) {
+                mpfr_sqr(tmp, chol[j * NUM_VARS + k], rnd);
+                mpfr_sub(l_jj, l_jj, tmp, rnd);
+            }
+            if (!mpfr_regular_p(l_jj) || (mpfr_sgn(l_jj) <= 0)) {
+                return false;
+            }
+            mpfr_sqrt(l_jj, l_jj, rnd);
+            for (std::size_t i = j + 1; i < NUM_VARS; ++i) {
+                mpfr_ptr l_ij = chol[i * NUM_VARS + j];
+                mpfr_set(l_ij, normal[i * NUM_VARS + j], rnd);
+                for (std::size_t k = 0; k < j; ++k) {
+                    mpfr_mul(tmp, chol[i * NUM_VARS + k],
+                             chol[j * NUM_VARS + k], rnd);
+                    mpfr_sub(l_ij, l_ij, tmp, rnd);
+                }
+                mpfr_div(l_ij, l_ij, l_jj, rnd);
+            }
+        }
+        // Forward substitution L z = -J^T r.
+        for (std::size_t i = 0; i < NUM_VARS; ++i) {
+            mpfr_neg(delta[i], rhs[i], rnd);
+            for (std::size_t k = 0; k < i; ++k) {
+                mpfr_mul(tmp, chol[i * NUM_VARS + k], delta[k], rnd);
+                mpfr_sub(delta[i], delta[i], tmp, rnd);
+            }
+            mpfr_div(delta[i], delta[i], chol[i * NUM_VARS + i], rnd);
+        }
+        // Back substitution L^T delta = z.
+        for (std::size_t i = NUM_VARS; i-- > 0;) {
+            for (std::size_t k = i + 1; k < NUM_VARS; ++k) {
+                mpfr_mul(tmp, chol[k * NUM_VARS + i], delta[k], rnd);
+                mpfr_sub(delta[i], delta[i], tmp, rnd);
+            }
+            mpfr_div(delta[i], delta[i], chol[i * NUM_VARS + i], rnd);
+        }
+        mpfr_set_zero(predicted, 0);
+        for (std::size_t i = 0; i < NUM_VARS; ++i) {
+            mpfr_mul(tmp, lambda, delta[i], rnd);
+            mpfr_sub(tmp, tmp, rhs[i], rnd);
+            mpfr_fma(predicted, tmp, delta[i], predicted, rnd);
+        }
+        return true;
+    }
+
+    // Updates the damping parameter after a trial step that reduced the
+    // objective function by actual, where the linear model predicted a
+    // reduction of predicted. Returns true if the step should be accepted.
+    bool update_damping(mpfr_t actual, mpfr_t predicted, mpfr_rnd_t rnd) {
+        const bool accepted = (mpfr_sgn(actual) > 0) &&
+                              (mpfr_sgn(predicted) > 0);
+        if (accepted) {
+            // lambda *= max(1/3, 1 - (2 rho - 1)^3), where rho is the ratio
+            // of actual to predicted reduction.
+            mpfr_div(tmp, actual, predicted, rnd);
+            mpfr_mul_2ui(tmp, tmp, 1, rnd);
+            mpfr_sub_ui(tmp, tmp, 1, rnd);
+            mpfr_pow_ui(tmp, tmp, 3, rnd);
+            mpfr_ui_sub(tmp, 1, tmp, rnd);
+            // nu is reset below, so it can hold the constant 1/3 meanwhile.
+            mpfr_set_ui(nu, 3, rnd);
+            mpfr_ui_div(nu, 1, nu, rnd);
+            mpfr_max(tmp, tmp, nu, rnd);
+            mpfr_mul(lambda, lambda, tmp, rnd);
+            mpfr_set_ui(nu, 2, rnd);
+        } else {
+            reject(rnd);
+        }
+        return accepted;
+    }
+
+    // Increases the damping parameter after a failed trial step.
+    void reject(mpfr_rnd_t rnd) {
+        mpfr_mul(lambda, lambda, nu, rnd);
+        mpfr_mul_2ui(nu, nu, 1, rnd);
+    }
+
+};
+
+// =============================================================================
+
+/*
+ * Computes the Gauss-Newton step delta minimizing ||r + J delta|| for the
+ * NUM_RESIDUALS x NUM_VARS Jacobian jac (in row-major order) and residuals
+ * res, both of which are overwritten. The least-squares problem is solved
+ * by Householder QR factorization with column pivoting (Businger and Golub,
+ * 1965), which avoids squaring the condition number of J as the normal
+ * equations do. Columns whose pivots fall below 2^(-p/2) times the largest
+ * pivot are treated as linearly dependent, and the corresponding entries of
+ * delta are set to zero. Returns the numerical rank of J.
+ */
+std::size_t gauss_newton_step_qr(dznl::MPFRVector &delta,
+                                 mpfr_t *jac, mpfr_t *res,
+                                 mpfr_prec_t p, mpfr_rnd_t rnd) {
+    static mpfr_t diag[NUM_VARS], col_norm[NUM_VARS];
+    static mpfr_t alpha, tau, dot_v, tol, tmp;
+    static std::size_t perm[NUM_VARS];
+    static mpfr_prec_t workspace_prec = 0;
+    if (workspace_prec == 0) {
+        for (std::size_t j = 0; j < NUM_VARS; ++j) {
+            mpfr_init2(diag[j], p);
+            mpfr_init2(col_norm[j], p);
+        }
+        mpfr_inits2(p, alpha, tau, dot_v, tol, tmp,
+                    static_cast<mpfr_ptr>(nullptr));
+        workspace_prec = p;
+    } else if (workspace_prec != p) {
+        set_workspace_precision(diag, NUM_VARS, p);
+        set_workspace_precision(col_norm, NUM_VARS, p);
+        mpfr_ptr scalars[] = {alpha, tau, dot_v, tol, tmp};
+        for (mpfr_ptr scalar : scalars) { mpfr_set_prec(scalar, p); }
+        workspace_prec = p;
+    }
+    const auto at = [jac](std::size_t i, std::size_t j) -> mpfr_ptr {
+        return jac[i * NUM_VARS + j];
+    };
+    // The right-hand side is -r; its sign is flipped in place.
+    for (std::size_t i = 0; i < NUM_RESIDUALS; ++i) {
+        mpfr_neg(res[i], res[i], rnd);
+    }
+    for (std::size_t j = 0; j < NUM_VARS; ++j) {
+        perm[j] = j;
+        mpfr_set_zero(col_norm[j], 0);
+        for (std::size_t i = 0; i < NUM_RESIDUALS; ++i) {
+            mpfr_fma(col_norm[j], at(i, j), at(i, j), col_norm[j], rnd);
+        }
+    }
+    std::size_t rank = 0;
+    for (std::size_t k = 0; k < NUM_VARS; ++k) {
+        // Move the remaining column of largest norm into position k. The
+        // squared norms in col_norm are only downdated approximations, so
+        // the pivot column's norm is recomputed from scratch below.
+        std::size_t pivot = k;
+        for (std::size_t j = k + 1; j < NUM_VARS; ++j) {
+            if (mpfr_greater_p(col_norm[j], col_norm[pivot])) { pivot = j; }
+        }
+        if (pivot != k) {
+            for (std::size_t i = 0; i < NUM_RESIDUALS; ++i) {
+                mpfr_swap(at(i, k), at(i, pivot));
+            }
+            mpfr_swap(col_norm[k], col_norm[pivot]);
+            std::swap(perm[k], perm[pivot]);
+        }
+        mpfr_set_zero(alpha, 0);
+        for (std::size_t i = k; i < NUM_RESIDUALS; ++i) {
+            mpfr_fma(alpha, at(i, k), at(i, k), alpha, rnd);
+        }
+        mpfr_sqrt(alpha, alpha, rnd);
+        if (k == 0) {
+            mpfr_mul_2si(tol, alpha, -(p / 2), rnd);
+        }
+        if (mpfr_zero_p(alpha) || mpfr_lessequal_p(alpha, tol)) { break; }
+        // Householder reflector H = I - tau v v^T mapping column k to
+        // alpha e_k, where v = x - alpha e_k is stored in place of x and
+        // the sign of alpha is chosen opposite to x_k to avoid cancellation.
+        if (mpfr_sgn(at(k, k)) > 0) { mpfr_neg(alpha, alpha, rnd); }
+        mpfr_sub(at(k, k), at(k, k), alpha, rnd);
+        mpfr_mul(tau, alpha, at(k, k), rnd);
+        mpfr_si_div(tau, -1, tau, rnd);
+        for (std::size_t j = k + 1; j < NUM_VARS; ++j) {
+            mpfr_set_zero(dot_v, 0);
+            for (std::size_t i = k; i < NUM_RESIDUALS; ++i) {
+                mpfr_fma(dot_v, at(i, k), at(i, j), dot_v, rnd);
+            }
+            mpfr_mul(dot_v, dot_v, tau, rnd);
+            for (std::size_t i = k; i < NUM_RESIDUALS; ++i) {
+                mpfr_mul(tmp, dot_v, at(i, k), rnd);
+                mpfr_sub(at(i, j), at(i, j), tmp, rnd);
+            }
+            mpfr_sqr(tmp, at(k, j), rnd);
+            mpfr_sub(col_norm[j], col_norm[j], tmp, rnd);
+        }
+        mpfr_set_zero(dot_v, 0);
+        for (std::size_t i = k; i < NUM_RESIDUALS; ++i) {
+            mpfr_fma(dot_v, at(i, k), res[i], dot_v, rnd);
+        }
+        mpfr_mul(dot_v, dot_v, tau, rnd);
+        for (std::size_t i = k; i < NUM_RESIDUALS; ++i) {
+            mpfr_mul(tmp, dot_v, at(i, k), rnd);
+            mpfr_sub(res[i], res[i], tmp, rnd);
+        }
+        mpfr_set(diag[k], alpha, rnd);
+        rank = k + 1;
+    }
+    // Back substitution R z = Q^T (-r) on the leading rank x rank block,
+    // where row k of R is stored to the right of the diagonal in row k of
+    // jac. Then delta = P z.
+    for (std::size_t j = 0; j < NUM_VARS; ++j) {
+        mpfr_set_zero(delta[j], 0);
+    }
+    for (std::size_t k = rank; k-- > 0;) {
+        mpfr_set(tmp, res[k], rnd);
+        for (std::size_t j = k + 1; j < rank; ++j) {
+            mpfr_fms(tmp, at(k, j), delta[perm[j]], tmp, rnd);
+            mpfr_neg(tmp, tmp, rnd);
+        }
+        mpfr_div(delta[perm[k]], tmp, diag[k], rnd);
+    }
+    return rank;
+}
+
+#endif // RKTK_LEAST_SQUARES_HPP_INCLUDED
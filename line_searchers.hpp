@@ -0,0 +1,742 @@
+#ifndef RKTK_LINE_SEARCHERS_HPP_INCLUDED
+#define RKTK_LINE_SEARCHERS_HPP_INCLUDED
+
+// C++ standard library headers
+#include <algorithm> // for std::min
+#include <cstddef>   // for std::size_t
+#include <vector>    // for std::vector
+
+// GNU MPFR multiprecision library headers
+#include <mpfr.h>
+
+// Project-specific headers
+#include <dznl/MPFRVector.hpp>
+
+// RKTK headers
+#include "background_worker.hpp"   // for WorkerPool
+#include "bfgs_subroutines.hpp"    // for dot
+#include "objective_evaluator.hpp" // for ObjectiveEvaluator
+#include "speculative_gradient.hpp" // for SpeculativeGradient
+
+/*
+ * BoundedQuadraticLineSearcher performs the same kind of quadratic line
+ * search as dznl::MPFRQuadraticLineSearcher, but evaluates trial points
+ * with ObjectiveEvaluator::bounded_objective whenever only a comparison
+ * against the best known objective value is needed. Trial points which
+ * turn out to be worse are typically rejected after computing a small
+ * fraction of the order conditions.
+ *
+ * If the initial step decreases the objective function, the step size is
+ * repeatedly doubled until the objective stops decreasing, and a parabola
+ * is fitted through the last three equally spaced points. Otherwise, the
+ * step size is repeatedly halved until the objective decreases, and a
+ * parabola is fitted through the starting point, the directional derivative
+ * at the starting point, and the accepted trial point. This avoids needing
+ * the exact value at any rejected point. In both cases, the minimizer of
+ * the parabola is tried as a final candidate.
+ *
+ * If no step size produces a decrease before the trial point becomes
+ * numerically indistinguishable from the starting point, the best step size
+ * is reported as zero.
+ *
+ * If a SpeculativeGradient is given, every trial point that decreases the
+ * objective function is proposed to it as soon as its value is known.
+ */
+class BoundedQuadraticLineSearcher {
+
+private: // ======================================================= DATA MEMBERS
+
+    ObjectiveEvaluator &evaluator;
+    mpfr_ptr func_best;
+    mpfr_ptr step_best;
+    const dznl::MPFRVector &x;
+    mpfr_ptr func;
+    const dznl::MPFRVector &dir;
+    const mpfr_prec_t prec;
+    const mpfr_rnd_t rnd;
+    SpeculativeGradient *const speculation;
+    dznl::MPFRVector x_trial;
+    mpfr_t slope, h1, f1, h2, f2, t, ft, num, den;
+
+public: // ======================================================== CONSTRUCTORS
+
+    BoundedQuadraticLineSearcher(ObjectiveEvaluator &objective,
+                                 mpfr_t best_func, mpfr_t best_step,
+                                 const dznl::MPFRVector &start_point,
+                                 mpfr_t start_func,
+                                 const dznl::MPFRVector &start_grad,
+                                 const dznl::MPFRVector &direction,
+                                 mpfr_prec_t numeric_precision,
+                                 mpfr_rnd_t rounding_mode,
+                                 SpeculativeGradient *speculative_gradient =
+                                         nullptr) :
+            evaluator(objective),
+            func_best(best_func), step_best(best_step),
+            x(start_point), func(start_func), dir(direction),
+            prec(numeric_precision), rnd(rounding_mode),
+            speculation(speculative_gradient),
+            x_trial(NUM_VARS, numeric_precision) {
+        mpfr_inits2(prec, slope, h1, f1, h2, f2, t, ft, num, den,
+                    static_cast<mpfr_ptr>(nullptr));
+        dot(slope, start_grad, dir, rnd);
+    }
+
+    // explicitly disallow copy construction
+    BoundedQuadraticLineSearcher(const BoundedQuadraticLineSearcher &) = delete;
+
+    // explicitly disallow copy assignment
+    BoundedQuadraticLineSearcher &operator=(
+            const BoundedQuadraticLineSearcher &) = delete;
+
+public: // ========================================================== DESTRUCTOR
+
+    ~BoundedQuadraticLineSearcher() {
+        mpfr_clears(slope, h1, f1, h2, f2, t, ft, num, den,
+                    static_cast<mpfr_ptr>(nullptr));
+    }
+
+public: // ============================================================ MUTATORS
+
+    void search(mpfr_t initial_step) {
+        mpfr_set(h1, initial_step, rnd);
+        if (mpfr_zero_p(h1)) {
+            mpfr_set_ui(h1, 1, rnd);
+            mpfr_div_2ui(h1, h1, static_cast<unsigned long>(prec / 2), rnd);
+        }
+        if (!try_step(f1, h1, func)) {
+            // Contract until the objective function decreases.
+            do {
+                mpfr_div_2ui(h1, h1, 1, rnd);
+                if (trial_point_is_start_point()) {
+                    mpfr_set(func_best, func, rnd);
+                    mpfr_set_zero(step_best, 0);
+                    return;
+                }
+            } while (!try_step(f1, h1, func));
+            // Fit q(s) = f0 + slope * s + c * s^2 through (h1, f1).
+            mpfr_mul(num, slope, h1, rnd);
+            mpfr_sub(den, f1, func, rnd);
+            mpfr_sub(den, den, num, rnd);
+            mpfr_div(den, den, h1, rnd);
+            mpfr_div(den, den, h1, rnd);
+            if (mpfr_sgn(den) > 0) {
+                // The minimizer of q is at -slope / (2 * c).
+                mpfr_div(t, slope, den, rnd);
+                mpfr_div_2ui(t, t, 1, rnd);
+                mpfr_neg(t, t, rnd);
+            } else {
+                mpfr_set_zero(t, 0);
+            }
+        } else {
+            // Expand until the objective function stops decreasing.
+            while (true) {
+                mpfr_mul_2ui(h2, h1, 1, rnd);
+                x_trial.set_axpy(h2, dir, x, rnd);
+                evaluator.objective(f2, x_trial.data(), prec, rnd);
+                if (!mpfr_less_p(f2, f1)) { break; }
+                propose(f2);
+                mpfr_swap(h1, h2);
+                mpfr_swap(f1, f2);
+            }
+            // Fit a parabola through (0, f0), (h1, f1), and (2 * h1, f2),
+            // whose minimizer is at
+            // h1 * (4 * f1 - 3 * f0 - f2) / (2 * (2 * f1 - f0 - f2)).
+            mpfr_mul_2ui(num, f1, 2, rnd);
+            mpfr_mul_ui(t, func, 3, rnd);
+            mpfr_sub(num, num, t, rnd);
+            mpfr_sub(num, num, f2, rnd);
+            mpfr_mul_2ui(den, f1, 1, rnd);
+            mpfr_sub(den, den, func, rnd);
+            mpfr_sub(den, den, f2, rnd);
+            mpfr_mul_2ui(den, den, 1, rnd);
+            if (mpfr_sgn(den) < 0) {
+                mpfr_div(t, num, den, rnd);
+                mpfr_mul(t, t, h1, rnd);
+            } else {
+                mpfr_set_zero(t, 0);
+            }
+        }
+        mpfr_set(func_best, f1, rnd);
+        mpfr_set(step_best, h1, rnd);
+        if (mpfr_number_p(t) && (mpfr_sgn(t) > 0) && !mpfr_equal_p(t, h1)) {
+            if (try_step(ft, t, f1)) {
+                mpfr_set(func_best, ft, rnd);
+                mpfr_set(step_best, t, rnd);
+            }
+        }
+    }
+
+private: // ===================================================== HELPER METHODS
+
+    // Evaluates the objective function at x + h * dir and returns true if
+    // its value is strictly less than bound. The contents of f are only
+    // meaningful when this function returns true.
+    bool try_step(mpfr_t f, mpfr_t h, mpfr_t bound) {
+        x_trial.set_axpy(h, dir, x, rnd);
+        if (!evaluator.bounded_objective(
+                f, x_trial.data(), bound, prec, rnd)) { return false; }
+        if (!mpfr_less_p(f, bound)) { return false; }
+        propose(f);
+        return true;
+    }
+
+    // Proposes x_trial, whose objective function value is f, to the
+    // speculative gradient evaluator (if any).
+    void propose(mpfr_t f) {
+        if (speculation != nullptr) { speculation->propose(x_trial, f); }
+    }
+
+    bool trial_point_is_start_point() {
+        x_trial.set_axpy(h1, dir, x, rnd);
+        for (std::size_t i = 0; i < NUM_VARS; ++i) {
+            if (!mpfr_equal_p(x_trial[i], x[i])) { return false; }
+        }
+        return true;
+    }
+
+};
+
+// Parameters of the strong Wolfe conditions used by WolfeLineSearcher: the
+// sufficient decrease constant c1 and the curvature constant c2, with the
+// values recommended for quasi-Newton methods by Nocedal & Wright.
+#define WOLFE_SUFFICIENT_DECREASE 1.0e-4
+#define WOLFE_CURVATURE 0.9
+
+// Maximum number of trial points per strong Wolfe line search.
+#define WOLFE_MAX_EVALUATIONS 32
+
+/*
+ * WolfeLineSearcher searches for a step size h satisfying the strong Wolfe
+ * conditions
+ *
+ *     phi(h) <= phi(0) + c1 * h * phi'(0),
+ *     |phi'(h)| <= c2 * |phi'(0)|,
+ *
+ * where phi(h) is the objective function at x + h * dir. Every trial point
+ * is evaluated by ObjectiveEvaluator::objective_derivative, which yields
+ * phi and phi' together at a fraction of the cost of a full gradient.
+ *
+ * Following Nocedal & Wright, Numerical Optimization, Algorithms 3.5 and
+ * 3.6, the step size is doubled until an interval containing acceptable
+ * points is bracketed. The first trial is capped at 2 * phi(0) / |phi'(0)|,
+ * twice the zero of the linear model of phi, since the objective function
+ * is nonnegative. The bracket is then narrowed as in More & Thuente (1994):
+ * each trial is the minimizer of the cubic or quadratic interpolant of phi
+ * and phi' at the endpoints, whichever lies closer to the best point, or a
+ * secant step on phi' when phi is still decreasing at the best point, and
+ * is kept away from both endpoints. Since phi'(h) >= c2 * phi'(0) > phi'(0)
+ * at an accepted point, the step s and gradient difference y it produces
+ * satisfy dot(s, y) > 0, so the BFGS update preserves positive definiteness.
+ *
+ * If no acceptable point is found within WOLFE_MAX_EVALUATIONS trials, the
+ * best point found that satisfies the sufficient decrease condition is
+ * reported instead. If there is none, or dir is not a direction of descent,
+ * the best step size is reported as zero.
+ */
+class WolfeLineSearcher {
+
+private: // ======================================================= DATA MEMBERS
+
+    ObjectiveEvaluator &evaluator;
+    mpfr_ptr func_best;
+    mpfr_ptr step_best;
+    const dznl::MPFRVector &x;
+    mpfr_ptr func;
+    const dznl::MPFRVector &dir;
+    const mpfr_prec_t prec;
+    const mpfr_rnd_t rnd;
+    dznl::MPFRVector x_trial;
+    mpfr_t slope, curv_tol, h_lo, f_lo, d_lo, h_hi, f_hi, d_hi, h, f, d;
+    mpfr_t h_prev, d_prev, d1, d2, q, t, u;
+    std::size_t num_evaluations;
+
+public: // ======================================================== CONSTRUCTORS
+
+    WolfeLineSearcher(ObjectiveEvaluator &objective,
+                      mpfr_t best_func, mpfr_t best_step,
+                      const dznl::MPFRVector &start_point,
+                      mpfr_t start_func,
+                      const dznl::MPFRVector &start_grad,
+                      const dznl::MPFRVector &direction,
+                      mpfr_prec_t numeric_precision,
+                      mpfr_rnd_t rounding_mode) :
+            evaluator(objective),
+            func_best(best_func), step_best(best_step),
+            x(start_point), func(start_func), dir(direction),
+            prec(numeric_precision), rnd(rounding_mode),
+            x_trial(NUM_VARS, numeric_precision), num_evaluations(0) {
+        mpfr_inits2(prec, slope, curv_tol, h_lo, f_lo, d_lo, h_hi, f_hi, d_hi,
+                    h, f, d, h_prev, d_prev, d1, d2, q, t, u,
+                    static_cast<mpfr_ptr>(nullptr));
+        dot(slope, start_grad, dir, rnd);
+        mpfr_mul_d(curv_tol, slope, -WOLFE_CURVATURE, rnd);
+    }
+
+    // explicitly disallow copy construction
+    WolfeLineSearcher(const WolfeLineSearcher &) = delete;
+
+    // explicitly disallow copy assignment
+    WolfeLineSearcher &operator=(const WolfeLineSearcher &) = delete;
+
+public: // ========================================================== DESTRUCTOR
+
+    ~WolfeLineSearcher() {
+        mpfr_clears(slope, curv_tol, h_lo, f_lo, d_lo, h_hi, f_hi, d_hi,
+                    h, f, d, h_prev, d_prev, d1, d2, q, t, u,
+                    static_cast<mpfr_ptr>(nullptr));
+    }
+
+public: // =========================================================== ACCESSORS
+
+    // Returns the number of trial points evaluated by the last search.
+    std::size_t get_evaluation_count() const { return num_evaluations; }
+
+public: // ============================================================ MUTATORS
+
+    void search(mpfr_t initial_step) {
+        num_evaluations = 0;
+        mpfr_set(func_best, func, rnd);
+        mpfr_set_zero(step_best, 0);
+        if (!mpfr_number_p(slope) || (mpfr_sgn(slope) >= 0)) { return; }
+        // The objective function is a sum of squares, so the first trial
+        // point is not placed beyond 2 * phi(0) / |phi'(0)|, where the
+        // linearization of the residuals along dir vanishes.
+        mpfr_div(h, func, slope, rnd);
+        mpfr_mul_si(h, h, -2, rnd);
+        if (!mpfr_zero_p(initial_step) && mpfr_less_p(initial_step, h)) {
+            mpfr_set(h, initial_step, rnd);
+        }
+        if (mpfr_zero_p(h)) {
+            mpfr_set_ui(h, 1, rnd);
+            mpfr_div_2ui(h, h, static_cast<unsigned long>(prec / 2), rnd);
+        }
+        // Bracketing phase: h_lo is the largest step size so far that
+        // satisfies the sufficient decrease condition.
+        mpfr_set_zero(h_lo, 0);
+        mpfr_set(f_lo, func, rnd);
+        mpfr_set(d_lo, slope, rnd);
+        while (num_evaluations < WOLFE_MAX_EVALUATIONS) {
+            if (trial_point_is(h_lo)) { return; }
+            evaluate();
+            if (!sufficient_decrease() || !mpfr_less_p(f, f_lo)) {
+                set_hi();
+                zoom();
+                return;
+            }
+            if (curvature_condition()) {
+                accept();
+                return;
+            }
+            if (mpfr_sgn(d) >= 0) {
+                // phi is increasing at h, so a minimizer lies in (h_lo, h),
+                // but now h is the endpoint with the lower value.
+                set_hi();
+                swap_lo_hi();
+                zoom();
+                return;
+            }
+            set_lo();
+            mpfr_mul_2ui(h, h, 1, rnd);
+        }
+        accept_lo();
+    }
+
+private: // ===================================================== HELPER METHODS
+
+    // Evaluates f = phi(h) and d = phi'(h).
+    void evaluate() {
+        x_trial.set_axpy(h, dir, x, rnd);
+        evaluator.objective_derivative(f, d, x_trial.data(), dir.data(),
+                                       prec, rnd);
+        ++num_evaluations;
+    }
+
+    bool sufficient_decrease() {
+        // phi(h) <= phi(0) + c1 * h * phi'(0)
+        mpfr_mul(t, h, slope, rnd);
+        mpfr_mul_d(t, t, WOLFE_SUFFICIENT_DECREASE, rnd);
+        mpfr_add(t, t, func, rnd);
+        return mpfr_lessequal_p(f, t) != 0;
+    }
+
+    bool curvature_condition() {
+        mpfr_abs(t, d, rnd);
+        return mpfr_lessequal_p(t, curv_tol) != 0;
+    }
+
+    void set_lo() {
+        mpfr_swap(h_prev, h_lo);
+        mpfr_swap(d_prev, d_lo);
+        mpfr_set(h_lo, h, rnd);
+        mpfr_set(f_lo, f, rnd);
+        mpfr_set(d_lo, d, rnd);
+    }
+
+    void set_hi() {
+        mpfr_set(h_hi, h, rnd);
+        mpfr_set(f_hi, f, rnd);
+        mpfr_set(d_hi, d, rnd);
+    }
+
+    void swap_lo_hi() {
+        mpfr_swap(h_lo, h_hi);
+        mpfr_swap(f_lo, f_hi);
+        mpfr_swap(d_lo, d_hi);
+    }
+
+    void accept() {
+        mpfr_set(func_best, f, rnd);
+        mpfr_set(step_best, h, rnd);
+    }
+
+    void accept_lo() {
+        if (mpfr_zero_p(h_lo)) { return; }
+        mpfr_set(func_best, f_lo, rnd);
+        mpfr_set(step_best, h_lo, rnd);
+    }
+
+    // Zoom phase: the interval between h_lo and h_hi (in either order)
+    // contains acceptable step sizes, and h_lo is the endpoint with the
+    // lower objective function value satisfying sufficient decrease. After
+    // an acceptable trial point at which phi still decreases towards h_hi,
+    // the next trial point is extrapolated from the last two values of h_lo
+    // instead of interpolated between h_lo and h_hi.
+    void zoom() {
+        bool extrapolating = false;
+        while (num_evaluations < WOLFE_MAX_EVALUATIONS) {
+            if (!extrapolating || !extrapolate()) { interpolate(); }
+            if (mpfr_equal_p(h, h_lo) || mpfr_equal_p(h, h_hi) ||
+                trial_point_is(h_lo)) { break; }
+            evaluate();
+            if (!sufficient_decrease() || !mpfr_less_p(f, f_lo)) {
+                set_hi();
+                extrapolating = false;
+                continue;
+            }
+            if (curvature_condition()) {
+                accept();
+                return;
+            }
+            mpfr_sub(t, h_hi, h_lo, rnd);
+            extrapolating = (mpfr_sgn(d) * mpfr_sgn(t) < 0);
+            if (!extrapolating) { swap_lo_hi(); }
+            set_lo();
+        }
+        accept_lo();
+    }
+
+    // Sets h to a trial step size between h_lo and h_hi. The zoom phase
+    // maintains phi(h_hi) > phi(h_lo), for which More & Thuente compare the
+    // minimizer c of the cubic interpolating phi and phi' at both endpoints
+    // (Nocedal & Wright, equation 3.59) with the minimizer q of the quadratic
+    // interpolating phi(h_lo), phi'(h_lo), and phi(h_hi), which always lies
+    // in the half of the interval nearest h_lo. Here, whichever of the two is
+    // closer to h_lo is used, since the objective function grows so steeply
+    // that phi(h_hi) often exceeds phi(h_lo) by many orders of magnitude,
+    // and both interpolants then overestimate the acceptable step sizes. The
+    // trial point is kept at least 2^(-10) of the interval length away from
+    // h_lo, and if the cubic has no minimizer in the interval, q is used.
+    void interpolate() {
+        // q = h_lo - d_lo * u^2 / (2 * (f_hi - f_lo - d_lo * u)),
+        // where u = h_hi - h_lo.
+        mpfr_sub(u, h_hi, h_lo, rnd);
+        mpfr_sub(t, f_hi, f_lo, rnd);
+        mpfr_mul(d1, d_lo, u, rnd);
+        mpfr_sub(t, t, d1, rnd);
+        mpfr_mul_2ui(t, t, 1, rnd);
+        mpfr_mul(q, d1, u, rnd);
+        mpfr_div(q, q, t, rnd);
+        mpfr_sub(q, h_lo, q, rnd);
+        // d1 = d_lo + d_hi - 3 * (f_hi - f_lo) / u
+        mpfr_sub(t, f_hi, f_lo, rnd);
+        mpfr_div(d1, t, u, rnd);
+        mpfr_mul_ui(d1, d1, 3, rnd);
+        mpfr_sub(d1, d_hi, d1, rnd);
+        mpfr_add(d1, d1, d_lo, rnd);
+        // d2 = sign(u) * sqrt(d1^2 - d_lo * d_hi)
+        mpfr_sqr(d2, d1, rnd);
+        mpfr_mul(t, d_lo, d_hi, rnd);
+        mpfr_sub(d2, d2, t, rnd);
+        bool use_cubic = mpfr_number_p(d2) && (mpfr_sgn(d2) >= 0);
+        if (use_cubic) {
+            mpfr_sqrt(d2, d2, rnd);
+            if (mpfr_sgn(u) < 0) { mpfr_neg(d2, d2, rnd); }
+            // c = h_hi - u * (d_hi + d2 - d1) / (d_hi - d_lo + 2 * d2)
+            mpfr_add(t, d_hi, d2, rnd);
+            mpfr_sub(t, t, d1, rnd);
+            mpfr_sub(h, d_hi, d_lo, rnd);
+            mpfr_mul_2ui(d1, d2, 1, rnd);
+            mpfr_add(h, h, d1, rnd);
+            mpfr_div(t, t, h, rnd);
+            mpfr_mul(t, t, u, rnd);
+            mpfr_sub(h, h_hi, t, rnd);
+            use_cubic = strictly_inside();
+        }
+        if (use_cubic) {
+            mpfr_sub(t, h, h_lo, rnd);
+            mpfr_sub(d1, q, h_lo, rnd);
+            if (mpfr_cmpabs(t, d1) > 0) { mpfr_set(h, q, rnd); }
+        } else {
+            mpfr_set(h, q, rnd);
+        }
+        if (!strictly_inside()) {
+            mpfr_add(h, h_lo, h_hi, rnd);
+            mpfr_div_2ui(h, h, 1, rnd);
+        } else if (mpfr_cmp_d(t, 0x1.0p-10) < 0) {
+            mpfr_div_2ui(h, u, 10, rnd);
+            mpfr_add(h, h_lo, h, rnd);
+        }
+    }
+
+    // Sets h to the zero of the secant of phi' through h_prev and h_lo, as in
+    // case 3 of More & Thuente, but at most 0.66 of the way from h_lo to
+    // h_hi. Returns false, leaving h unspecified, if the secant does not
+    // cross zero beyond h_lo.
+    bool extrapolate() {
+        // h = h_lo - d_lo * (h_lo - h_prev) / (d_lo - d_prev)
+        mpfr_sub(t, h_lo, h_prev, rnd);
+        mpfr_sub(u, d_lo, d_prev, rnd);
+        mpfr_div(t, t, u, rnd);
+        mpfr_mul(t, t, d_lo, rnd);
+        mpfr_sub(h, h_lo, t, rnd);
+        mpfr_sub(u, h_hi, h_lo, rnd);
+        if (!strictly_inside()) {
+            if (!mpfr_number_p(t) || (mpfr_sgn(t) <= 0)) { return false; }
+        }
+        if (mpfr_cmp_d(t, 0.66) > 0) {
+            mpfr_mul_d(h, u, 0.66, rnd);
+            mpfr_add(h, h_lo, h, rnd);
+        }
+        return true;
+    }
+
+    // Returns true if h lies strictly between h_lo and h_lo + u.
+    bool strictly_inside() {
+        mpfr_sub(t, h, h_lo, rnd);
+        mpfr_div(t, t, u, rnd);
+        return mpfr_number_p(t) && (mpfr_sgn(t) > 0) &&
+               (mpfr_cmp_ui(t, 1) < 0);
+    }
+
+    bool trial_point_is(mpfr_t step) {
+        for (std::size_t i = 0; i < NUM_VARS; ++i) {
+            mpfr_fma(t, h, dir[i], x[i], rnd);
+            mpfr_fma(u, step, dir[i], x[i], rnd);
+            if (!mpfr_equal_p(t, u)) { return false; }
+        }
+        return true;
+    }
+
+};
+
+// Maximum number of trial step sizes per ladder line search. The objective
+// cache of ObjectiveEvaluator retains the trial points of two searches.
+#define LADDER_MAX_TRIALS 15
+
+/*
+ * LadderLineSearcher evaluates the objective function at a geometric ladder
+ * of n trial step sizes
+ *
+ *     h_i = h * 2^(i - n / 2),    i = 0, ..., n - 1,
+ *
+ * around an initial step size h in a single round on a WorkerPool, instead
+ * of the chain of dependent evaluations made by BoundedQuadraticLineSearcher.
+ * Each thread of the pool evaluates its share of the rungs as one batch (see
+ * ObjectiveEvaluator::objective_batch).
+ * A parabola is then fitted through the best rung and its two neighbours,
+ * with the starting point h = 0 as the lower neighbour of the lowest rung,
+ * and its minimizer is tried as a final candidate. With at least n threads,
+ * a search therefore takes about as long as two objective function
+ * evaluations.
+ *
+ * If the highest rung is best, another round is evaluated on the ladder
+ * shifted upward by n - 2 rungs, so that the two highest rungs of the
+ * previous round (whose values are found in the objective cache) become the
+ * two lowest ones. If no rung decreases the objective function, another
+ * round is evaluated on the ladder continuing below the lowest rung, until
+ * the trial points become numerically indistinguishable from the starting
+ * point, in which case the best step size is reported as zero.
+ *
+ * If a SpeculativeGradient is given, the best rung of the final round is
+ * proposed to it before the minimizer of the parabola is evaluated.
+ */
+class LadderLineSearcher {
+
+private: // ======================================================= DATA MEMBERS
+
+    ObjectiveEvaluator &evaluator;
+    WorkerPool &pool;
+    const std::size_t num_trials;
+    mpfr_ptr func_best;
+    mpfr_ptr step_best;
+    const dznl::MPFRVector &x;
+    mpfr_ptr func;
+    const dznl::MPFRVector &dir;
+    const mpfr_prec_t prec;
+    const mpfr_rnd_t rnd;
+    std::vector<dznl::MPFRVector *> points;
+    mpfr_t *steps;
+    mpfr_t *values;
+    SpeculativeGradient *const speculation;
+    dznl::MPFRVector x_trial;
+    mpfr_t t, ft, da, dc, num, den;
+
+public: // ======================================================== CONSTRUCTORS
+
+    // Creates a searcher with 4 <= trials <= LADDER_MAX_TRIALS rungs. The
+    // remaining arguments are as for BoundedQuadraticLineSearcher, except
+    // that the gradient at the starting point is not needed.
+    LadderLineSearcher(ObjectiveEvaluator &objective, WorkerPool &workers,
+                       std::size_t trials,
+                       mpfr_t best_func, mpfr_t best_step,
+                       const dznl::MPFRVector &start_point,
+                       mpfr_t start_func,
+                       const dznl::MPFRVector &direction,
+                       mpfr_prec_t numeric_precision,
+                       mpfr_rnd_t rounding_mode,
+                       SpeculativeGradient *speculative_gradient = nullptr) :
+            evaluator(objective), pool(workers), num_trials(trials),
+            func_best(best_func), step_best(best_step),
+            x(start_point), func(start_func), dir(direction),
+            prec(numeric_precision), rnd(rounding_mode),
+            steps(new mpfr_t[trials]), values(new mpfr_t[trials]),
+            speculation(speculative_gradient),
+            x_trial(NUM_VARS, numeric_precision) {
+        for (std::size_t i = 0; i < num_trials; ++i) {
+            points.push_back(new dznl::MPFRVector(NUM_VARS, prec));
+            mpfr_init2(steps[i], prec);
+            mpfr_init2(values[i], prec);
+        }
+        mpfr_inits2(prec, t, ft, da, dc, num, den,
+                    static_cast<mpfr_ptr>(nullptr));
+    }
+
+    // explicitly disallow copy construction
+    LadderLineSearcher(const LadderLineSearcher &) = delete;
+
+    // explicitly disallow copy assignment
+    LadderLineSearcher &operator=(const LadderLineSearcher &) = delete;
+
+public: // ========================================================== DESTRUCTOR
+
+    ~LadderLineSearcher() {
+        for (std::size_t i = 0; i < num_trials; ++i) {
+            delete points[i];
+            mpfr_clear(steps[i]);
+            mpfr_clear(values[i]);
+        }
+        delete[] steps;
+        delete[] values;
+        mpfr_clears(t, ft, da, dc, num, den, static_cast<mpfr_ptr>(nullptr));
+    }
+
+public: // ============================================================ MUTATORS
+
+    void search(mpfr_t initial_step) {
+        mpfr_set(t, initial_step, rnd);
+        if (mpfr_zero_p(t)) {
+            mpfr_set_ui(t, 1, rnd);
+            mpfr_div_2ui(t, t, static_cast<unsigned long>(prec / 2), rnd);
+        }
+        const long n = static_cast<long>(num_trials);
+        mpfr_mul_2si(t, t, -(n / 2), rnd);
+        const std::size_t num_batches =
+                std::min(pool.get_thread_count(), num_trials);
+        std::size_t b;
+        while (true) {
+            for (std::size_t i = 0; i < num_trials; ++i) {
+                mpfr_mul_2si(steps[i], t, static_cast<long>(i), rnd);
+            }
+            pool.run(num_batches, [this, num_batches](std::size_t batch) {
+                evaluate_rungs(batch, num_batches);
+            });
+            b = 0;
+            for (std::size_t i = 1; i < num_trials; ++i) {
+                if (mpfr_less_p(values[i], values[b])) { b = i; }
+            }
+            if (!mpfr_less_p(values[b], func)) {
+                // Continue below the ladder.
+                if (rung_is_start_point(0)) {
+                    mpfr_set(func_best, func, rnd);
+                    mpfr_set_zero(step_best, 0);
+                    return;
+                }
+                mpfr_mul_2si(t, t, -n, rnd);
+            } else if (b + 1 == num_trials) {
+                // Continue above the ladder. The best rung of the next
+                // round cannot be its lowest one.
+                mpfr_mul_2si(t, t, n - 2, rnd);
+            } else {
+                break;
+            }
+        }
+        mpfr_set(func_best, values[b], rnd);
+        mpfr_set(step_best, steps[b], rnd);
+        if (speculation != nullptr) {
+            speculation->propose(*points[b], values[b]);
+        }
+        // With a < b < c denoting the step sizes of the best rung and its
+        // neighbours, the parabola through the three samples has its
+        // minimizer at b - (da^2 (fb - fc) - dc^2 (fb - fa)) /
+        // (2 (da (fb - fc) + dc (fb - fa))), where da = b - a, dc = c - b.
+        if (b == 0) {
+            mpfr_set(da, steps[0], rnd);
+            mpfr_sub(num, values[0], func, rnd);
+        } else {
+            mpfr_sub(da, steps[b], steps[b - 1], rnd);
+            mpfr_sub(num, values[b], values[b - 1], rnd);
+        }
+        mpfr_sub(dc, steps[b + 1], steps[b], rnd);
+        mpfr_sub(ft, values[b], values[b + 1], rnd);
+        // Now num = fb - fa and ft = fb - fc, both non-positive.
+        mpfr_mul(den, da, ft, rnd);
+        mpfr_mul(t, dc, num, rnd);
+        mpfr_add(den, den, t, rnd);
+        if (mpfr_sgn(den) >= 0) { return; }
+        mpfr_mul(t, da, da, rnd);
+        mpfr_mul(t, t, ft, rnd);
+        mpfr_mul(ft, dc, dc, rnd);
+        mpfr_mul(num, ft, num, rnd);
+        mpfr_sub(num, t, num, rnd);
+        mpfr_div(t, num, den, rnd);
+        mpfr_div_2ui(t, t, 1, rnd);
+        mpfr_sub(t, steps[b], t, rnd);
+        if (mpfr_number_p(t) && (mpfr_sgn(t) > 0) &&
+            !mpfr_equal_p(t, steps[b])) {
+            x_trial.set_axpy(t, dir, x, rnd);
+            if (evaluator.bounded_objective(ft, x_trial.data(), func_best,
+                                            prec, rnd) &&
+                mpfr_less_p(ft, func_best)) {
+                mpfr_set(func_best, ft, rnd);
+                mpfr_set(step_best, t, rnd);
+            }
+        }
+    }
+
+private: // ===================================================== HELPER METHODS
+
+    // Evaluates the objective function at rungs first, first + stride, ...
+    // as a single batch. This runs concurrently with the other batches, so
+    // it only writes to data owned by its own rungs.
+    void evaluate_rungs(std::size_t first, std::size_t stride) {
+        std::vector<mpfr_ptr> batch_values;
+        std::vector<mpfr_t *> batch_points;
+        for (std::size_t i = first; i < num_trials; i += stride) {
+            points[i]->set_axpy(steps[i], dir, x, rnd);
+            batch_values.push_back(values[i]);
+            batch_points.push_back(points[i]->data());
+        }
+        evaluator.objective_batch(batch_values.data(), batch_points.data(),
+                                  batch_values.size(), prec, rnd);
+    }
+
+    bool rung_is_start_point(std::size_t i) {
+        for (std::size_t j = 0; j < NUM_VARS; ++j) {
+            if (!mpfr_equal_p((*points[i])[j], x[j])) { return false; }
+        }
+        return true;
+    }
+
+};
+
+#endif // RKTK_LINE_SEARCHERS_HPP_INCLUDED
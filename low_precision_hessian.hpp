@@ -0,0 +1,287 @@
+#ifndef RKTK_LOW_PRECISION_HESSIAN_HPP_INCLUDED
+#define RKTK_LOW_PRECISION_HESSIAN_HPP_INCLUDED
+
+// C++ standard library headers
+#include <cmath>   // for std::isfinite
+#include <cstddef> // for std::size_t
+#include <vector>  // for std::vector
+
+// GNU MPFR multiprecision library headers
+#include <mpfr.h>
+
+// Project-specific headers
+#include <dznl/MPFRVector.hpp>
+
+// RKTK headers
+#include "objective_function.hpp" // for NUM_VARS, twsd, twpd
+#include "symmetric_matrix.hpp"   // for NUM_PACKED_ENTRIES
+
+/*
+ * DoubleDouble represents the unevaluated sum hi + lo of two doubles with
+ * |lo| <= ulp(hi) / 2, which carries about 106 significant bits. The
+ * arithmetic operators below are the usual sloppy double-double algorithms
+ * built on the error-free transformations twsd and twpd; they are accurate
+ * to a few units in the last place of lo, which is ample for a
+ * preconditioner.
+ */
+struct DoubleDouble {
+    double hi;
+    double lo;
+    DoubleDouble() : hi(0.0), lo(0.0) {}
+    DoubleDouble(double x) : hi(x), lo(0.0) {}
+    DoubleDouble(double h, double l) : hi(h), lo(l) {}
+};
+
+static inline DoubleDouble renormalize(double s, double e) {
+    const double h = s + e;
+    return DoubleDouble(h, e - (h - s));
+}
+
+static inline DoubleDouble operator+(DoubleDouble a, DoubleDouble b) {
+    double s, e;
+    twsd(s, e, a.hi, b.hi);
+    return renormalize(s, e + (a.lo + b.lo));
+}
+
+static inline DoubleDouble operator-(DoubleDouble a) {
+    return DoubleDouble(-a.hi, -a.lo);
+}
+
+static inline DoubleDouble operator-(DoubleDouble a, DoubleDouble b) {
+    return a + (-b);
+}
+
+static inline DoubleDouble operator*(DoubleDouble a, DoubleDouble b) {
+    double p, e;
+    twpd(p, e, a.hi, b.hi);
+    return renormalize(p, e + (a.hi * b.lo + a.lo * b.hi));
+}
+
+static inline DoubleDouble operator/(DoubleDouble a, DoubleDouble b) {
+    const double q = a.hi / b.hi;
+    const DoubleDouble r = a - b * DoubleDouble(q);
+    return renormalize(q, r.hi / b.hi);
+}
+
+static inline double leading_part(double x) { return x; }
+
+static inline double leading_part(DoubleDouble x) { return x.hi; }
+
+/*
+ * LowPrecisionInverseHessian stores the BFGS approximate inverse Hessian in
+ * packed symmetric form (see PackedSymmetricMatrix) in double or
+ * double-double arithmetic, while the iterate, objective function, and
+ * gradient remain at the full working precision. The matrix only serves as
+ * a preconditioner for the search direction, so its accuracy affects the
+ * rate of convergence but not the accuracy of the final result, and its
+ * O(NUM_VARS^2) work becomes negligible next to a high-precision gradient.
+ *
+ * Multiprecision vectors are scaled by a power of two before conversion, so
+ * gradients and steps far below the range of double (as occur at thousands
+ * of bits) lose no relative accuracy. Since the BFGS update of the inverse
+ * Hessian only depends on their relative scale, it is carried out on the
+ * scaled vectors. Updates with non-positive curvature dot(s, y) <= 0, which
+ * would make the matrix indefinite, are skipped.
+ */
+class LowPrecisionInverseHessian {
+
+private: // ======================================================= DATA MEMBERS
+
+    const bool double_double;
+    std::vector<double> entries_d;         // used in double mode
+    std::vector<DoubleDouble> entries_dd; // used in double-double mode
+    mpfr_t t;
+
+public: // ======================================================== CONSTRUCTORS
+
+    LowPrecisionInverseHessian(bool use_double_double, mpfr_prec_t prec) :
+            double_double(use_double_double) {
+        if (double_double) {
+            entries_dd.resize(NUM_PACKED_ENTRIES);
+        } else {
+            entries_d.resize(NUM_PACKED_ENTRIES);
+        }
+        mpfr_init2(t, prec);
+        clear();
+    }
+
+    // explicitly disallow copy construction
+    LowPrecisionInverseHessian(const LowPrecisionInverseHessian &) = delete;
+
+    // explicitly disallow copy assignment
+    LowPrecisionInverseHessian &
+    operator=(const LowPrecisionInverseHessian &) = delete;
+
+public: // ========================================================== DESTRUCTOR
+
+    ~LowPrecisionInverseHessian() { mpfr_clear(t); }
+
+public: // =========================================================== ACCESSORS
+
+    bool uses_double_double() const { return double_double; }
+
+    // Computes dst = H * v. dst and v must be distinct vectors.
+    void multiply(dznl::MPFRVector &dst, const dznl::MPFRVector &v,
+                  mpfr_rnd_t rnd) {
+        if (double_double) {
+            multiply_kernel(entries_dd, dst, v, rnd);
+        } else {
+            multiply_kernel(entries_d, dst, v, rnd);
+        }
+    }
+
+public: // ============================================================ MUTATORS
+
+    // Resets the approximation to the identity.
+    void clear() {
+        if (double_double) {
+            set_identity(entries_dd);
+        } else {
+            set_identity(entries_d);
+        }
+    }
+
+    // Performs the BFGS update for the step s = step_size * step_direction
+    // and the gradient difference y = delta_gradient.
+    void update(const dznl::MPFRVector &delta_gradient, mpfr_t step_size,
+                const dznl::MPFRVector &step_direction, mpfr_rnd_t rnd) {
+        if (double_double) {
+            update_kernel(entries_dd, delta_gradient, step_size,
+                          step_direction, rnd);
+        } else {
+            update_kernel(entries_d, delta_gradient, step_size,
+                          step_direction, rnd);
+        }
+    }
+
+    // Changes the precision of the conversion workspace. The stored matrix
+    // is independent of the working precision.
+    void set_precision(mpfr_prec_t prec) { mpfr_set_prec(t, prec); }
+
+private: // ===================================================== HELPER METHODS
+
+    template <typename T>
+    static void set_identity(std::vector<T> &a) {
+        for (std::size_t i = 0, k = 0; i < NUM_VARS; ++i) {
+            for (std::size_t j = 0; j < i; ++j, ++k) { a[k] = T(0.0); }
+            a[k++] = T(1.0);
+        }
+    }
+
+    // Returns the largest exponent of the entries of v, or zero if all of
+    // them are zero, so that v * 2^(-result) has entries of magnitude < 1.
+    static mpfr_exp_t scale_exponent(const dznl::MPFRVector &v) {
+        bool found = false;
+        mpfr_exp_t result = 0;
+        for (std::size_t i = 0; i < NUM_VARS; ++i) {
+            if (!mpfr_regular_p(v[i])) { continue; }
+            const mpfr_exp_t e = mpfr_get_exp(v[i]);
+            if (!found || (e > result)) { result = e; }
+            found = true;
+        }
+        return result;
+    }
+
+    // Rounds x * 2^(-e) to double or double-double.
+    void lower(double &dst, mpfr_srcptr x, mpfr_exp_t e) {
+        mpfr_mul_2si(t, x, -e, MPFR_RNDN);
+        dst = mpfr_get_d(t, MPFR_RNDN);
+    }
+
+    void lower(DoubleDouble &dst, mpfr_srcptr x, mpfr_exp_t e) {
+        mpfr_mul_2si(t, x, -e, MPFR_RNDN);
+        dst.hi = mpfr_get_d(t, MPFR_RNDN);
+        mpfr_sub_d(t, t, dst.hi, MPFR_RNDN);
+        dst.lo = mpfr_get_d(t, MPFR_RNDN);
+    }
+
+    // Sets dst = x * 2^e.
+    static void raise(mpfr_ptr dst, double x, mpfr_exp_t e, mpfr_rnd_t rnd) {
+        mpfr_set_d(dst, x, rnd);
+        mpfr_mul_2si(dst, dst, e, rnd);
+    }
+
+    static void raise(mpfr_ptr dst, DoubleDouble x, mpfr_exp_t e,
+                      mpfr_rnd_t rnd) {
+        mpfr_set_d(dst, x.hi, rnd);
+        mpfr_add_d(dst, dst, x.lo, rnd);
+        mpfr_mul_2si(dst, dst, e, rnd);
+    }
+
+    template <typename T>
+    static void packed_multiply(std::vector<T> &dst, const std::vector<T> &a,
+                                const std::vector<T> &v) {
+        for (std::size_t i = 0; i < NUM_VARS; ++i) { dst[i] = T(0.0); }
+        for (std::size_t i = 0, k = 0; i < NUM_VARS; ++i) {
+            for (std::size_t j = 0; j < i; ++j, ++k) {
+                dst[i] = dst[i] + a[k] * v[j];
+                dst[j] = dst[j] + a[k] * v[i];
+            }
+            dst[i] = dst[i] + a[k++] * v[i];
+        }
+    }
+
+    template <typename T>
+    static T packed_dot(const std::vector<T> &v, const std::vector<T> &w) {
+        T result(0.0);
+        for (std::size_t i = 0; i < NUM_VARS; ++i) {
+            result = result + v[i] * w[i];
+        }
+        return result;
+    }
+
+    template <typename T>
+    void multiply_kernel(std::vector<T> &a, dznl::MPFRVector &dst,
+                         const dznl::MPFRVector &v, mpfr_rnd_t rnd) {
+        const mpfr_exp_t e = scale_exponent(v);
+        std::vector<T> x(NUM_VARS), r(NUM_VARS);
+        for (std::size_t i = 0; i < NUM_VARS; ++i) { lower(x[i], v[i], e); }
+        packed_multiply(r, a, x);
+        for (std::size_t i = 0; i < NUM_VARS; ++i) {
+            raise(dst[i], r[i], e, rnd);
+        }
+    }
+
+    template <typename T>
+    void update_kernel(std::vector<T> &a,
+                       const dznl::MPFRVector &delta_gradient,
+                       mpfr_t step_size,
+                       const dznl::MPFRVector &step_direction,
+                       mpfr_rnd_t rnd) {
+        // With y = 2^ey * yh and s = step_size * 2^es * sh, the update
+        //     H += (dot(s, y) + dot(y, H y)) / dot(s, y)^2 * s s^T
+        //          - (H y s^T + s y^T H) / dot(s, y)
+        // equals H += (u sh^T + sh u^T) / sigma, where sigma = dot(sh, yh),
+        // u = c * sh - H yh, and c = (ratio * sigma + dot(yh, H yh)) /
+        // (2 * sigma) depends on the scales only through their ratio
+        // ratio = step_size * 2^(es - ey).
+        const mpfr_exp_t ey = scale_exponent(delta_gradient);
+        const mpfr_exp_t es = scale_exponent(step_direction);
+        std::vector<T> y(NUM_VARS), s(NUM_VARS), u(NUM_VARS);
+        for (std::size_t i = 0; i < NUM_VARS; ++i) {
+            lower(y[i], delta_gradient[i], ey);
+            lower(s[i], step_direction[i], es);
+        }
+        T ratio;
+        mpfr_mul_2si(t, step_size, es - ey, rnd);
+        lower(ratio, t, 0);
+        const T sigma = packed_dot(s, y);
+        if (!(leading_part(sigma) > 0.0) ||
+            !std::isfinite(leading_part(ratio))) { return; }
+        packed_multiply(u, a, y);
+        const T theta = packed_dot(y, u);
+        const T c = (ratio * sigma + theta) / (T(2.0) * sigma);
+        if (!std::isfinite(leading_part(c))) { return; }
+        for (std::size_t i = 0; i < NUM_VARS; ++i) {
+            u[i] = (c * s[i] - u[i]) / sigma;
+        }
+        for (std::size_t i = 0, k = 0; i < NUM_VARS; ++i) {
+            for (std::size_t j = 0; j <= i; ++j, ++k) {
+                a[k] = a[k] + (u[i] * s[j] + s[i] * u[j]);
+            }
+        }
+    }
+
+};
+
+#endif // RKTK_LOW_PRECISION_HESSIAN_HPP_INCLUDED
@@ -0,0 +1,276 @@
+#ifndef RKTK_MEMORY_POOL_HPP_INCLUDED
+#define RKTK_MEMORY_POOL_HPP_INCLUDED
+
+// C++ standard library headers
+#include <algorithm> // for std::find
+#include <atomic>    // for std::atomic
+#include <cstddef>   // for std::size_t
+#include <cstdlib>   // for std::malloc, std::realloc, std::free, std::abort
+#include <cstring>   // for std::memcpy
+#include <mutex>     // for std::mutex, std::lock_guard
+#include <vector>    // for std::vector
+
+// GNU MPFR multiprecision library headers
+#include <mpfr.h> // includes gmp.h for mp_set_memory_functions
+
+/*
+ * The pooled allocator below serves every allocation made by GMP and MPFR,
+ * including the limb arrays of mpfr_t variables and the temporaries allocated
+ * inside MPFR functions. Since GMP passes the size of each block to its free
+ * and reallocation functions, blocks need no headers: each request is rounded
+ * up to a power-of-two size class, and freed blocks are kept on per-class
+ * free lists for reuse. Requests larger than the largest size class go
+ * directly to the system allocator.
+ *
+ * Free lists are thread-local, so threads never contend for them; a block
+ * freed by a thread other than the one that allocated it simply migrates to
+ * the freeing thread's cache. Each thread also keeps its own allocation
+ * counters, and every cache registers itself in a global list so that
+ * get_pool_statistics can sum the counters over all threads, including those
+ * that have already exited. The list is only locked when a thread creates or
+ * destroys its cache and when statistics are requested.
+ *
+ * Because blocks carry no headers, a block allocated before the pool was
+ * installed cannot be told apart from a pooled one. install_pool_allocator
+ * must therefore be called before any GMP or MPFR object is initialized.
+ */
+
+#define POOL_MIN_CLASS_BITS 4
+#define POOL_NUM_CLASSES 13 // 16 bytes to 64 KiB
+#define POOL_MAX_CACHED_BLOCKS 4096
+
+struct PoolStatistics {
+    std::size_t pool_hits;    // requests served from a free list
+    std::size_t pool_misses;  // requests passed to the system allocator
+    std::size_t frees;        // blocks returned by GMP or MPFR
+    std::size_t reallocations;
+};
+
+// The counters of a single thread. Only the owning thread writes them, but
+// get_pool_statistics may read them from any thread.
+struct PoolCounters {
+    std::atomic<std::size_t> pool_hits;
+    std::atomic<std::size_t> pool_misses;
+    std::atomic<std::size_t> frees;
+    std::atomic<std::size_t> reallocations;
+
+    PoolCounters() : pool_hits(0), pool_misses(0), frees(0),
+                     reallocations(0) {}
+
+    // Increments a counter of the calling thread. No read-modify-write
+    // instruction is needed, since no other thread writes to it.
+    static void increment(std::atomic<std::size_t> &counter) {
+        counter.store(counter.load(std::memory_order_relaxed) + 1,
+                      std::memory_order_relaxed);
+    }
+
+    void add_to(PoolStatistics &totals) const {
+        totals.pool_hits += pool_hits.load(std::memory_order_relaxed);
+        totals.pool_misses += pool_misses.load(std::memory_order_relaxed);
+        totals.frees += frees.load(std::memory_order_relaxed);
+        totals.reallocations +=
+                reallocations.load(std::memory_order_relaxed);
+    }
+};
+
+class ThreadPoolCache {
+
+private: // ======================================================= DATA MEMBERS
+
+    struct FreeBlock { FreeBlock *next; };
+
+    FreeBlock *heads[POOL_NUM_CLASSES];
+    std::size_t counts[POOL_NUM_CLASSES];
+
+public:
+
+    PoolCounters stats;
+
+public: // ======================================================== CONSTRUCTORS
+
+    ThreadPoolCache() : heads(), counts(), stats() {}
+
+    ~ThreadPoolCache() {
+        for (std::size_t c = 0; c < POOL_NUM_CLASSES; ++c) {
+            while (heads[c] != nullptr) {
+                FreeBlock *const block = heads[c];
+                heads[c] = block->next;
+                std::free(block);
+            }
+        }
+    }
+
+    // explicitly disallow copy construction
+    ThreadPoolCache(const ThreadPoolCache &) = delete;
+
+    // explicitly disallow copy assignment
+    ThreadPoolCache &operator=(const ThreadPoolCache &) = delete;
+
+public: // =========================================================== ACCESSORS
+
+    // Returns the index of the smallest size class holding size bytes, or
+    // POOL_NUM_CLASSES if size exceeds the largest one.
+    static std::size_t size_class(std::size_t size) {
+        std::size_t c = 0;
+        while ((c < POOL_NUM_CLASSES) &&
+               ((std::size_t(1) << (c + POOL_MIN_CLASS_BITS)) < size)) {
+            ++c;
+        }
+        return c;
+    }
+
+    static std::size_t class_size(std::size_t c) {
+        return std::size_t(1) << (c + POOL_MIN_CLASS_BITS);
+    }
+
+public: // ============================================================ MUTATORS
+
+    void *allocate(std::size_t c) {
+        if (heads[c] != nullptr) {
+            FreeBlock *const block = heads[c];
+            heads[c] = block->next;
+            --counts[c];
+            PoolCounters::increment(stats.pool_hits);
+            return block;
+        }
+        PoolCounters::increment(stats.pool_misses);
+        return std::malloc(class_size(c));
+    }
+
+    void release(void *ptr, std::size_t c) {
+        PoolCounters::increment(stats.frees);
+        if (counts[c] >= POOL_MAX_CACHED_BLOCKS) {
+            std::free(ptr);
+            return;
+        }
+        auto *const block = static_cast<FreeBlock *>(ptr);
+        block->next = heads[c];
+        heads[c] = block;
+        ++counts[c];
+    }
+
+};
+
+// Tracks the lifetime of the cache of the calling thread, which is created
+// on first use. Blocks freed during thread or program exit, after the cache
+// has been destroyed, are returned to the system allocator.
+enum class PoolCacheState { UNUSED, ALIVE, DESTROYED };
+
+static thread_local PoolCacheState pool_cache_state = PoolCacheState::UNUSED;
+
+// Lists the caches of all live threads, and holds the summed counters of
+// those that have exited.
+struct PoolRegistry {
+    std::mutex mutex;
+    std::vector<const ThreadPoolCache *> caches;
+    PoolStatistics retired;
+    PoolRegistry() : mutex(), caches(), retired() {}
+};
+
+static PoolRegistry &pool_registry() {
+    static PoolRegistry registry;
+    return registry;
+}
+
+struct ThreadPoolCacheHolder {
+    ThreadPoolCache cache;
+    ThreadPoolCacheHolder() {
+        PoolRegistry &registry = pool_registry();
+        {
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            registry.caches.push_back(&cache);
+        }
+        pool_cache_state = PoolCacheState::ALIVE;
+    }
+    ~ThreadPoolCacheHolder() {
+        PoolRegistry &registry = pool_registry();
+        {
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            cache.stats.add_to(registry.retired);
+            registry.caches.erase(std::find(registry.caches.begin(),
+                                            registry.caches.end(), &cache));
+        }
+        pool_cache_state = PoolCacheState::DESTROYED;
+    }
+};
+
+// Returns the cache of the calling thread, or a null pointer if it has
+// already been destroyed.
+static ThreadPoolCache *thread_pool_cache() {
+    if (pool_cache_state == PoolCacheState::DESTROYED) { return nullptr; }
+    static thread_local ThreadPoolCacheHolder holder;
+    return &holder.cache;
+}
+
+// =============================================================================
+
+static void *pool_allocate(std::size_t size) {
+    const std::size_t c = ThreadPoolCache::size_class(size);
+    ThreadPoolCache *const cache = thread_pool_cache();
+    void *const result =
+            (c == POOL_NUM_CLASSES) ? std::malloc(size)
+            : (cache != nullptr) ? cache->allocate(c)
+            : std::malloc(ThreadPoolCache::class_size(c));
+    // GMP offers no way to recover from a failed allocation.
+    if (result == nullptr) { std::abort(); }
+    return result;
+}
+
+static void pool_free(void *ptr, std::size_t size) {
+    const std::size_t c = ThreadPoolCache::size_class(size);
+    ThreadPoolCache *const cache = thread_pool_cache();
+    if ((cache != nullptr) && (c < POOL_NUM_CLASSES)) {
+        cache->release(ptr, c);
+    } else {
+        std::free(ptr);
+    }
+}
+
+static void *pool_reallocate(void *ptr, std::size_t old_size,
+                             std::size_t new_size) {
+    const std::size_t old_c = ThreadPoolCache::size_class(old_size);
+    const std::size_t new_c = ThreadPoolCache::size_class(new_size);
+    ThreadPoolCache *const cache = thread_pool_cache();
+    if (cache != nullptr) {
+        PoolCounters::increment(cache->stats.reallocations);
+    }
+    if (old_c == new_c) {
+        if (old_c < POOL_NUM_CLASSES) { return ptr; }
+        void *const result = std::realloc(ptr, new_size);
+        if (result == nullptr) { std::abort(); }
+        return result;
+    }
+    void *const result = pool_allocate(new_size);
+    std::memcpy(result, ptr, (old_size < new_size) ? old_size : new_size);
+    pool_free(ptr, old_size);
+    return result;
+}
+
+// =============================================================================
+
+// Routes all subsequent GMP and MPFR allocations through the pool. Must be
+// called before any GMP or MPFR object is initialized.
+void install_pool_allocator() {
+    mp_set_memory_functions(pool_allocate, pool_reallocate, pool_free);
+}
+
+// Returns true if GMP and MPFR currently allocate through the pool.
+bool pool_allocator_installed() {
+    void *(*alloc_func)(std::size_t);
+    mp_get_memory_functions(&alloc_func, nullptr, nullptr);
+    return alloc_func == pool_allocate;
+}
+
+// Returns the allocation counters summed over all threads that have used the
+// pool. Counters of threads other than the caller may lag slightly behind.
+PoolStatistics get_pool_statistics() {
+    PoolRegistry &registry = pool_registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    PoolStatistics totals = registry.retired;
+    for (const ThreadPoolCache *const cache : registry.caches) {
+        cache->stats.add_to(totals);
+    }
+    return totals;
+}
+
+#endif // RKTK_MEMORY_POOL_HPP_INCLUDED
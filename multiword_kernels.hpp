@@ -0,0 +1,434 @@
+#ifndef RKTK_MULTIWORD_KERNELS_HPP_INCLUDED
+#define RKTK_MULTIWORD_KERNELS_HPP_INCLUDED
+
+// C++ standard library headers
+#include <cstddef> // for std::size_t
+#include <cstdint> // for std::int64_t, std::uint64_t
+
+// GNU MPFR multiprecision library headers
+#include <mpfr.h>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#define RKTK_HAVE_IFMA_KERNELS
+#endif
+
+/*
+ * The following functions are multiword counterparts of the helper
+ * subroutines in OrderConditionHelpers.hpp, named according to the same
+ * scheme with the data type code w. They represent each number in fixed
+ * point as
+ *
+ *     (-1)^neg * sum_{k < n} limb[k] * 2^(-52 k),    0 <= limb[k] < 2^52,
+ *
+ * with 2 <= n <= MAX_MULTIWORD_LIMBS, so limb 0 holds the integer part and
+ * the remaining limbs hold 52 (n - 1) fractional bits. Results are truncated
+ * to that many fractional bits, so their errors are bounded in absolute
+ * rather than relative terms. This suits the order conditions, whose
+ * residuals only need to be accurate in absolute terms. Any result whose
+ * magnitude reaches 2^52 sets the overflow flag of the workspace, in which
+ * case the caller must discard the computation.
+ *
+ * All numbers live in a single MultiwordWorkspace in structure-of-arrays
+ * layout, where limb k of the number at offset i is stored at
+ * limbs[k * stride + i], and are addressed by their offsets.
+ *
+ * Products of limbs are formed with the AVX-512 IFMA instructions, which
+ * compute the low and high 52-bit halves of eight 52 x 52-bit products at
+ * once, when the processor supports them. Otherwise, the same products are
+ * formed one at a time with 128-bit integer arithmetic. Both code paths
+ * produce bit-for-bit identical results.
+ */
+
+#define MULTIWORD_LIMB_BITS 52
+#define MAX_MULTIWORD_LIMBS 8
+
+struct MultiwordWorkspace {
+    std::size_t num_limbs;
+    std::size_t stride;
+    std::uint64_t *limbs;
+    std::uint64_t *neg;
+    bool use_ifma;
+    bool overflow;
+};
+
+static const std::uint64_t MULTIWORD_LIMB_MASK =
+        (std::uint64_t(1) << MULTIWORD_LIMB_BITS) - 1;
+
+__extension__ typedef unsigned __int128 multiword_product_t;
+
+// Returns true if the processor supports the AVX-512 IFMA instructions.
+static bool cpu_supports_ifma() {
+#ifdef RKTK_HAVE_IFMA_KERNELS
+    static const bool result = __builtin_cpu_supports("avx512f") &&
+                               __builtin_cpu_supports("avx512ifma");
+    return result;
+#else
+    return false;
+#endif
+}
+
+// =============================================================================
+
+/*
+ * Products are accumulated in n + 1 columns, where column c has weight
+ * 2^(-52 (c - 1)); column 0 only receives contributions from numbers too
+ * large to represent. The product of limbs i and j has weight 2^(-52 (i+j)),
+ * so its low half goes to column i + j + 1 and its high half to column i + j.
+ * Low halves which would fall beyond column n are dropped. Every column sum
+ * is below (2n + 1) * 2^52 <= 2^57, leaving room to accumulate 16 products
+ * in a signed 64-bit integer.
+ */
+
+static inline void mulw_columns(std::uint64_t *cols, std::size_t n,
+                                const std::uint64_t *a,
+                                const std::uint64_t *b,
+                                std::size_t stride) {
+    for (std::size_t c = 0; c <= n; ++c) { cols[c] = 0; }
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t j = 0; i + j <= n && j < n; ++j) {
+            const multiword_product_t p =
+                    static_cast<multiword_product_t>(a[i * stride]) *
+                    b[j * stride];
+            if (i + j < n) {
+                cols[i + j + 1] +=
+                        static_cast<std::uint64_t>(p) & MULTIWORD_LIMB_MASK;
+            }
+            cols[i + j] +=
+                    static_cast<std::uint64_t>(p >> MULTIWORD_LIMB_BITS);
+        }
+    }
+}
+
+// Normalizes signed column sums into a multiword number stored at offset
+// dst, flagging overflow if its magnitude is too large.
+static void normalize_columns(MultiwordWorkspace &w, std::size_t dst,
+                              std::int64_t *cols) {
+    const std::size_t n = w.num_limbs;
+    for (std::size_t c = n; c > 0; --c) {
+        cols[c - 1] += cols[c] >> MULTIWORD_LIMB_BITS;
+        cols[c] &= static_cast<std::int64_t>(MULTIWORD_LIMB_MASK);
+    }
+    w.neg[dst] = 0;
+    if (cols[0] < 0) {
+        for (std::size_t c = 0; c <= n; ++c) { cols[c] = -cols[c]; }
+        for (std::size_t c = n; c > 0; --c) {
+            cols[c - 1] += cols[c] >> MULTIWORD_LIMB_BITS;
+            cols[c] &= static_cast<std::int64_t>(MULTIWORD_LIMB_MASK);
+        }
+        w.neg[dst] = 1;
+    }
+    if (cols[0] != 0) { w.overflow = true; }
+    for (std::size_t k = 0; k < n; ++k) {
+        w.limbs[k * w.stride + dst] = static_cast<std::uint64_t>(cols[k + 1]);
+    }
+}
+
+#ifdef RKTK_HAVE_IFMA_KERNELS
+
+__attribute__((target("avx512f,avx512ifma")))
+static inline void mulw_columns_ifma(__m512i *cols, std::size_t n,
+                                     const std::uint64_t *a,
+                                     const std::uint64_t *b,
+                                     std::size_t stride, __mmask8 lanes) {
+    __m512i a_limbs[MAX_MULTIWORD_LIMBS];
+    __m512i b_limbs[MAX_MULTIWORD_LIMBS];
+    for (std::size_t k = 0; k < n; ++k) {
+        a_limbs[k] = _mm512_maskz_loadu_epi64(lanes, a + k * stride);
+        b_limbs[k] = _mm512_maskz_loadu_epi64(lanes, b + k * stride);
+    }
+    for (std::size_t c = 0; c <= n; ++c) { cols[c] = _mm512_setzero_si512(); }
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t j = 0; i + j <= n && j < n; ++j) {
+            if (i + j < n) {
+                cols[i + j + 1] = _mm512_madd52lo_epu64(
+                        cols[i + j + 1], a_limbs[i], b_limbs[j]);
+            }
+            cols[i + j] = _mm512_madd52hi_epu64(
+                    cols[i + j], a_limbs[i], b_limbs[j]);
+        }
+    }
+}
+
+// Elementwise product of num_elems numbers at offsets v and u, eight at a
+// time.
+__attribute__((target("avx512f,avx512ifma")))
+static void elmw_ifma(MultiwordWorkspace &w, std::size_t dst, std::size_t n,
+                      std::size_t v, std::size_t u) {
+    const std::size_t num_limbs = w.num_limbs;
+    const __m512i mask = _mm512_set1_epi64(
+            static_cast<long long>(MULTIWORD_LIMB_MASK));
+    __m512i cols[MAX_MULTIWORD_LIMBS + 1];
+    for (std::size_t i = 0; i < n; i += 8) {
+        const __mmask8 lanes = (n - i >= 8)
+                               ? static_cast<__mmask8>(0xFF)
+                               : static_cast<__mmask8>((1U << (n - i)) - 1);
+        mulw_columns_ifma(cols, num_limbs, w.limbs + v + i, w.limbs + u + i,
+                          w.stride, lanes);
+        for (std::size_t c = num_limbs; c > 0; --c) {
+            cols[c - 1] = _mm512_add_epi64(
+                    cols[c - 1], _mm512_maskz_srli_epi64(
+                            lanes, cols[c], MULTIWORD_LIMB_BITS));
+            cols[c] = _mm512_and_si512(cols[c], mask);
+        }
+        if (_mm512_test_epi64_mask(cols[0], cols[0]) != 0) {
+            w.overflow = true;
+        }
+        for (std::size_t k = 0; k < num_limbs; ++k) {
+            _mm512_mask_storeu_epi64(w.limbs + k * w.stride + dst + i,
+                                     lanes, cols[k + 1]);
+        }
+        _mm512_mask_storeu_epi64(
+                w.neg + dst + i, lanes,
+                _mm512_xor_si512(_mm512_maskz_loadu_epi64(lanes, w.neg + v + i),
+                                 _mm512_maskz_loadu_epi64(lanes, w.neg + u + i)));
+    }
+}
+
+// Accumulates the signed column sums of dot(v, u) over n <= 16 terms into
+// cols, eight terms at a time.
+__attribute__((target("avx512f,avx512ifma")))
+static void dotw_columns_ifma(MultiwordWorkspace &w, std::int64_t *cols,
+                              std::size_t n, std::size_t v, std::size_t u) {
+    const std::size_t num_limbs = w.num_limbs;
+    __m512i acc[MAX_MULTIWORD_LIMBS + 1];
+    __m512i prod[MAX_MULTIWORD_LIMBS + 1];
+    for (std::size_t c = 0; c <= num_limbs; ++c) {
+        acc[c] = _mm512_setzero_si512();
+    }
+    for (std::size_t i = 0; i < n; i += 8) {
+        const __mmask8 lanes = (n - i >= 8)
+                               ? static_cast<__mmask8>(0xFF)
+                               : static_cast<__mmask8>((1U << (n - i)) - 1);
+        mulw_columns_ifma(prod, num_limbs, w.limbs + v + i, w.limbs + u + i,
+                          w.stride, lanes);
+        const __m512i sign = _mm512_xor_si512(
+                _mm512_maskz_loadu_epi64(lanes, w.neg + v + i),
+                _mm512_maskz_loadu_epi64(lanes, w.neg + u + i));
+        const __mmask8 negative = _mm512_test_epi64_mask(sign, sign);
+        for (std::size_t c = 0; c <= num_limbs; ++c) {
+            acc[c] = _mm512_mask_blend_epi64(
+                    negative, _mm512_add_epi64(acc[c], prod[c]),
+                    _mm512_sub_epi64(acc[c], prod[c]));
+        }
+    }
+    std::int64_t sums[8];
+    for (std::size_t c = 0; c <= num_limbs; ++c) {
+        _mm512_storeu_si512(sums, acc[c]);
+        for (std::size_t i = 0; i < 8; ++i) { cols[c] += sums[i]; }
+    }
+}
+
+#endif // RKTK_HAVE_IFMA_KERNELS
+
+// Accumulates the signed column sums of dot(v, u) into cols.
+static void dotw_columns(MultiwordWorkspace &w, std::int64_t *cols,
+                         std::size_t n, std::size_t v, std::size_t u) {
+#ifdef RKTK_HAVE_IFMA_KERNELS
+    if (w.use_ifma) {
+        dotw_columns_ifma(w, cols, n, v, u);
+        return;
+    }
+#endif
+    std::uint64_t prod[MAX_MULTIWORD_LIMBS + 1];
+    for (std::size_t i = 0; i < n; ++i) {
+        mulw_columns(prod, w.num_limbs, w.limbs + v + i, w.limbs + u + i,
+                     w.stride);
+        const bool negative = (w.neg[v + i] != w.neg[u + i]);
+        for (std::size_t c = 0; c <= w.num_limbs; ++c) {
+            const auto p = static_cast<std::int64_t>(prod[c]);
+            cols[c] += negative ? -p : p;
+        }
+    }
+}
+
+// =============================================================================
+
+// Converts src to a multiword number stored at offset dst, using z as
+// scratch space. The conversion rounds to nearest.
+void setw(MultiwordWorkspace &w, std::size_t dst, mpfr_t src,
+          mpfr_t tmp, mpz_t z) {
+    const std::size_t n = w.num_limbs;
+    mpfr_set_prec(tmp, mpfr_get_prec(src));
+    mpfr_mul_2ui(tmp, src, MULTIWORD_LIMB_BITS * (n - 1), MPFR_RNDN);
+    mpfr_get_z(z, tmp, MPFR_RNDN);
+    w.neg[dst] = (mpz_sgn(z) < 0) ? 1 : 0;
+    mpz_abs(z, z);
+    for (std::size_t k = n; k-- > 0;) {
+        w.limbs[k * w.stride + dst] = mpz_get_ui(z) & MULTIWORD_LIMB_MASK;
+        mpz_tdiv_q_2exp(z, z, MULTIWORD_LIMB_BITS);
+    }
+    if (mpz_sgn(z) != 0) { w.overflow = true; }
+}
+
+// Converts the multiword number at offset src to dst, using z as scratch
+// space. The conversion is exact if dst has at least 52 * num_limbs bits.
+void getw(mpfr_t dst, MultiwordWorkspace &w, std::size_t src,
+          mpz_t z, mpfr_rnd_t rnd) {
+    const std::size_t n = w.num_limbs;
+    mpz_set_ui(z, 0);
+    for (std::size_t k = 0; k < n; ++k) {
+        mpz_mul_2exp(z, z, MULTIWORD_LIMB_BITS);
+        mpz_add_ui(z, z, w.limbs[k * w.stride + src]);
+    }
+    if (w.neg[src] != 0) { mpz_neg(z, z); }
+    mpfr_set_z_2exp(dst, z, -static_cast<mpfr_exp_t>(
+            MULTIWORD_LIMB_BITS * (n - 1)), rnd);
+}
+
+// =============================================================================
+
+void lrsw(MultiwordWorkspace &w, std::size_t dst,
+          std::size_t dst_size,
+          std::size_t mat) {
+    std::int64_t cols[MAX_MULTIWORD_LIMBS + 1];
+    std::size_t k = mat;
+    for (std::size_t i = 0; i < dst_size; ++i) {
+        for (std::size_t c = 0; c <= w.num_limbs; ++c) { cols[c] = 0; }
+        for (std::size_t j = 0; j <= i; ++j, ++k) {
+            for (std::size_t l = 0; l < w.num_limbs; ++l) {
+                const auto limb = static_cast<std::int64_t>(
+                        w.limbs[l * w.stride + k]);
+                cols[l + 1] += (w.neg[k] != 0) ? -limb : limb;
+            }
+        }
+        normalize_columns(w, dst + i, cols);
+    }
+}
+
+// =============================================================================
+
+void elmw(MultiwordWorkspace &w, std::size_t dst,
+          std::size_t n,
+          std::size_t v, std::size_t u) {
+#ifdef RKTK_HAVE_IFMA_KERNELS
+    if (w.use_ifma) {
+        elmw_ifma(w, dst, n, v, u);
+        return;
+    }
+#endif
+    std::uint64_t cols[MAX_MULTIWORD_LIMBS + 1];
+    for (std::size_t i = 0; i < n; ++i) {
+        mulw_columns(cols, w.num_limbs, w.limbs + v + i, w.limbs + u + i,
+                     w.stride);
+        for (std::size_t c = w.num_limbs; c > 0; --c) {
+            cols[c - 1] += cols[c] >> MULTIWORD_LIMB_BITS;
+            cols[c] &= MULTIWORD_LIMB_MASK;
+        }
+        if (cols[0] != 0) { w.overflow = true; }
+        for (std::size_t k = 0; k < w.num_limbs; ++k) {
+            w.limbs[k * w.stride + dst + i] = cols[k + 1];
+        }
+        w.neg[dst + i] = w.neg[v + i] ^ w.neg[u + i];
+    }
+}
+
+// =============================================================================
+
+void esqw(MultiwordWorkspace &w, std::size_t dst,
+          std::size_t n,
+          std::size_t v) {
+    elmw(w, dst, n, v, v);
+}
+
+// =============================================================================
+
+void dotw(MultiwordWorkspace &w, std::size_t dst,
+          std::size_t n,
+          std::size_t v, std::size_t u) {
+    std::int64_t cols[MAX_MULTIWORD_LIMBS + 1] = {};
+    dotw_columns(w, cols, n, v, u);
+    normalize_columns(w, dst, cols);
+}
+
+// =============================================================================
+
+void lvmw(MultiwordWorkspace &w, std::size_t dst,
+          std::size_t dst_size, std::size_t mat_size,
+          std::size_t mat, std::size_t vec) {
+    std::size_t skp = mat_size - dst_size;
+    std::size_t idx = skp * (skp + 1) / 2 - 1;
+    for (std::size_t i = 0; i < dst_size; ++i, idx += skp, ++skp) {
+        dotw(w, dst + i, i + 1, mat + idx, vec);
+    }
+}
+
+// =============================================================================
+
+// Computes the residual dot(m, x) - gamma into the multiword number at
+// offset dst. Since gamma is subtracted before the result is normalized,
+// the cancellation between the two incurs no rounding error.
+void resw(MultiwordWorkspace &w, std::size_t dst,
+          std::size_t n,
+          std::size_t m, std::size_t x, std::size_t gamma) {
+    std::int64_t cols[MAX_MULTIWORD_LIMBS + 1] = {};
+    dotw_columns(w, cols, n, m, x);
+    for (std::size_t k = 0; k < w.num_limbs; ++k) {
+        const auto limb = static_cast<std::int64_t>(
+                w.limbs[k * w.stride + gamma]);
+        cols[k + 1] += (w.neg[gamma] != 0) ? limb : -limb;
+    }
+    normalize_columns(w, dst, cols);
+}
+
+// =============================================================================
+
+/*
+ * The following functions compute tangent parts for forward-mode
+ * differentiation in multiword arithmetic, like the t functions of
+ * OrderConditionHelpers.hpp, taking both the real and dual parts of their
+ * operands as offsets. Each result is the sum of two products or dot
+ * products, whose columns are accumulated together and normalized once.
+ * Since every dot product has at most 16 terms, at most 32 products are
+ * accumulated per column, which stays below 2^62.
+ */
+
+void elmwt(MultiwordWorkspace &w, std::size_t dst_du,
+           std::size_t n,
+           std::size_t v_re, std::size_t v_du,
+           std::size_t u_re, std::size_t u_du) {
+    std::int64_t cols[MAX_MULTIWORD_LIMBS + 1];
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t c = 0; c <= w.num_limbs; ++c) { cols[c] = 0; }
+        dotw_columns(w, cols, 1, v_re + i, u_du + i);
+        dotw_columns(w, cols, 1, v_du + i, u_re + i);
+        normalize_columns(w, dst_du + i, cols);
+    }
+}
+
+void esqwt(MultiwordWorkspace &w, std::size_t dst_du,
+           std::size_t n,
+           std::size_t v_re, std::size_t v_du) {
+    elmwt(w, dst_du, n, v_re, v_du, v_re, v_du);
+}
+
+void lvmwt(MultiwordWorkspace &w, std::size_t dst_du,
+           std::size_t dst_size, std::size_t mat_size,
+           std::size_t mat_re, std::size_t mat_du,
+           std::size_t vec_re, std::size_t vec_du) {
+    std::int64_t cols[MAX_MULTIWORD_LIMBS + 1];
+    std::size_t skp = mat_size - dst_size;
+    std::size_t idx = skp * (skp + 1) / 2 - 1;
+    for (std::size_t i = 0; i < dst_size; ++i, idx += skp, ++skp) {
+        for (std::size_t c = 0; c <= w.num_limbs; ++c) { cols[c] = 0; }
+        dotw_columns(w, cols, i + 1, mat_re + idx, vec_du);
+        dotw_columns(w, cols, i + 1, mat_du + idx, vec_re);
+        normalize_columns(w, dst_du + i, cols);
+    }
+}
+
+// Computes the dual part of the residual dot(m, x) - gamma, where gamma is
+// constant.
+void reswt(MultiwordWorkspace &w, std::size_t dst_du,
+           std::size_t n,
+           std::size_t m_re, std::size_t m_du,
+           std::size_t x_re, std::size_t x_du) {
+    std::int64_t cols[MAX_MULTIWORD_LIMBS + 1] = {};
+    dotw_columns(w, cols, n, m_du, x_re);
+    dotw_columns(w, cols, n, m_re, x_du);
+    normalize_columns(w, dst_du, cols);
+}
+
+// =============================================================================
+
+#endif // RKTK_MULTIWORD_KERNELS_HPP_INCLUDED
@@ -15,12 +15,25 @@
 
 // RKTK headers
 #include "objective_function.hpp"
+#include "objective_evaluator.hpp"
+#include "background_worker.hpp"
 #include "bfgs_subroutines.hpp"
+#include "least_squares.hpp"
+#include "line_searchers.hpp"
+#include "low_precision_hessian.hpp"
+#include "memory_pool.hpp"
+#include "speculative_gradient.hpp"
+#include "truncated_newton.hpp"
+#include "trust_region.hpp"
 #include "FilenameHelpers.hpp"
 
-#include <dznl/MPFRMatrix.hpp>
 #include <dznl/MPFRVector.hpp>
-#include <dznl/MPFRQuadraticLineSearcher.hpp>
+
+// Changes the precision of n variables, rounding their current values.
+static inline void round_to_precision(mpfr_t *v, std::size_t n,
+                                      mpfr_prec_t p, mpfr_rnd_t rnd) {
+    for (std::size_t i = 0; i < n; ++i) { mpfr_prec_round(v[i], p, rnd); }
+}
 
 static inline void nan_check(const char *msg) {
     if (mpfr_nanflag_p()) {
@@ -31,16 +44,34 @@ static inline void nan_check(const char *msg) {
 }
 
 enum class StepType {
-    BFGS, GRAD, NONE
+    BFGS, GRAD, LM, GN, NEWTON, SR1, NONE
+};
+
+// Rule used to update the dense approximate inverse Hessian after each BFGS
+// step: the standard BFGS update (update_inverse_hessian), or the modified
+// update MBFGS-T (update_inverse_hessian_mbfgst), which also uses the change
+// in the objective function value.
+enum class InverseHessianUpdate {
+    BFGS, MBFGST
 };
 
+// Maximum number of increasingly damped trial steps per Levenberg-Marquardt
+// iteration before the current point is considered a local minimum.
+#define LM_MAX_TRIAL_STEPS 16
+
+// Maximum number of trial steps with shrinking trust-region radius per SR1
+// trust-region iteration before the current point is considered a local
+// minimum.
+#define TR_MAX_TRIAL_STEPS 32
+
 class BFGSOptimizer {
 
     typedef std::numeric_limits<std::uint64_t> uint64_limits;
 
 private: // ======================================================= DATA MEMBERS
 
-    const mpfr_prec_t prec;
+    mpfr_prec_t prec;
+    const mpfr_prec_t max_prec;
     const mpfr_rnd_t rnd;
     StepType step_type;
 
@@ -49,9 +80,90 @@ private: // ======================================================= DATA MEMBERS
 
     mpfr_t func, func_grad, func_new;
     mpfr_t step_size, step_size_grad, step_size_new;
+    mpfr_t predicted_reduction, actual_reduction;
     dznl::MPFRVector grad_dir, step_dir;
 
-    dznl::MPFRMatrix hess_inv;
+    PackedSymmetricMatrix hess_inv;
+    InverseHessianUpdate update_rule = InverseHessianUpdate::BFGS;
+
+    // In limited-memory mode, the approximate inverse Hessian is represented
+    // by recent steps and gradient differences instead of hess_inv, which is
+    // then kept at minimal precision.
+    LimitedMemoryInverseHessian *limited_memory = nullptr;
+
+    // In low-precision mode, the approximate inverse Hessian is stored in
+    // double or double-double arithmetic instead of hess_inv, which is then
+    // kept at minimal precision.
+    LowPrecisionInverseHessian *low_precision = nullptr;
+
+    // In Levenberg-Marquardt mode, steps are computed from the residuals and
+    // their Jacobian instead of the approximate inverse Hessian, and hess_inv
+    // is kept at minimal precision. has_jacobian records whether those
+    // stored in least_squares belong to x.
+    LevenbergMarquardtSolver *least_squares = nullptr;
+    bool has_jacobian = false;
+
+    // In Newton-CG mode, steps are computed by conjugate gradients on
+    // Hessian-vector products, and hess_inv is kept at minimal precision.
+    // cg_iterations records the number of CG iterations in the last step.
+    TruncatedNewtonSolver *truncated_newton = nullptr;
+    std::size_t cg_iterations = 0;
+
+    // In SR1 trust-region mode, steps minimize a quadratic model within a
+    // trust region instead of following a line search, and hess_inv is kept
+    // at minimal precision.
+    SR1TrustRegion *trust_region = nullptr;
+
+    // In Wolfe mode, each BFGS iteration performs a single strong Wolfe line
+    // search (see WolfeLineSearcher) along the quasi-Newton direction instead
+    // of two quadratic line searches. line_search_evaluations records the
+    // number of trial points in the last iteration.
+    bool wolfe_line_search = false;
+    std::size_t line_search_evaluations = 0;
+
+    // In concurrent mode, the quadratic line search along the steepest
+    // descent direction runs on line_search_worker while the one along the
+    // quasi-Newton direction runs on the calling thread.
+    BackgroundWorker *line_search_worker = nullptr;
+
+    // Once the quasi-Newton direction has won gradient_search_skip_streak
+    // consecutive comparisons of the quadratic line searches, the steepest
+    // descent direction is only searched every gradient_search_skip_streak
+    // iterations. bfgs_win_streak records the current number of consecutive
+    // wins, and zero disables skipping.
+    std::size_t gradient_search_skip_streak = 0;
+    std::size_t bfgs_win_streak = 0;
+
+    // In ladder mode, each quadratic line search is replaced by a
+    // LadderLineSearcher evaluating ladder_trials step sizes at once on
+    // ladder_pool.
+    WorkerPool *ladder_pool = nullptr;
+    std::size_t ladder_trials = 0;
+
+    // In speculative mode, the gradient at the best trial point found so far
+    // is evaluated on a background thread while the quadratic line searches
+    // continue (see SpeculativeGradient).
+    SpeculativeGradient *speculation = nullptr;
+
+    ObjectiveEvaluator evaluator;
+
+    // Breakdown of func into residual groups (see NUM_RESIDUAL_GROUPS),
+    // retrieved from the evaluator whenever x changes.
+    dznl::MPFRVector func_groups;
+    bool has_func_groups = false;
+
+    // In mixed-precision mode (gradient_guard_bits > 0), gradients at new
+    // points are evaluated at a reduced precision grad_prec chosen from the
+    // current gradient norm. Objective function values are always evaluated
+    // at full precision.
+    mpfr_prec_t gradient_guard_bits = 0;
+    mpfr_prec_t grad_prec;
+
+    // In adaptive-precision mode (precision_guard_bits > 0), the working
+    // precision prec starts out low and is raised as the objective function
+    // and its gradient shrink, up to the precision max_prec requested at
+    // construction. All state is carried over when prec changes.
+    mpfr_prec_t precision_guard_bits = 0;
 
     std::size_t iter_count = std::numeric_limits<std::size_t>::max();
 
@@ -65,17 +177,20 @@ public: // ======================================================== CONSTRUCTORS
 
     explicit BFGSOptimizer(mpfr_prec_t numeric_precision,
                            mpfr_rnd_t rounding_mode) :
-            prec(numeric_precision), rnd(rounding_mode),
+            prec(numeric_precision), max_prec(numeric_precision),
+            rnd(rounding_mode),
             step_type(StepType::NONE),
             x(NUM_VARS, prec), x_new(NUM_VARS, prec),
             grad(NUM_VARS, prec), grad_new(NUM_VARS, prec),
             grad_delta(NUM_VARS, prec), grad_dir(NUM_VARS, prec),
-            step_dir(NUM_VARS, prec), hess_inv(NUM_VARS, prec) {
+            step_dir(NUM_VARS, prec), hess_inv(prec),
+            func_groups(NUM_RESIDUAL_GROUPS, prec), grad_prec(prec) {
         mpfr_inits2(
                 prec,
                 x_norm, x_new_norm, grad_norm, grad_new_norm,
                 func, func_grad, func_new,
                 step_size, step_size_grad, step_size_new,
+                predicted_reduction, actual_reduction,
                 static_cast<mpfr_ptr>(nullptr));
     }
 
@@ -92,7 +207,16 @@ public: // ========================================================== DESTRUCTOR
                 x_norm, x_new_norm, grad_norm, grad_new_norm,
                 func, func_grad, func_new,
                 step_size, step_size_grad, step_size_new,
+                predicted_reduction, actual_reduction,
                 static_cast<mpfr_ptr>(nullptr));
+        delete limited_memory;
+        delete low_precision;
+        delete least_squares;
+        delete truncated_newton;
+        delete trust_region;
+        delete line_search_worker;
+        delete ladder_pool;
+        delete speculation;
     }
 
 public: // ======================================================== INITIALIZERS
@@ -109,17 +233,21 @@ public: // ======================================================== INITIALIZERS
             mpfr_set_ld(x[i], unif(random_engine), rnd);
         }
         x.norm(x_norm, rnd);
-        objective_function(func, x.data(), prec, rnd);
-        objective_gradient(grad.data(), x.data(), prec, rnd);
+        evaluator.objective(func, x.data(), prec, rnd);
+        evaluator.gradient(grad.data(), x.data(), prec, rnd);
         grad.norm(grad_norm, rnd);
+        update_func_groups();
         mpfr_set_zero(step_size, 0);
-        hess_inv.set_identity_matrix();
+        reset_inverse_hessian();
         iter_count = 0;
         uuid_seg0 = random_engine() & 0xFFFFFFFF;
         uuid_seg1 = random_engine() & 0xFFFF;
         uuid_seg2 = random_engine() & 0xFFFF;
         uuid_seg3 = random_engine() & 0xFFFF;
         uuid_seg4 = random_engine() & 0xFFFFFFFFFFFF;
+        if (precision_guard_bits > 0) {
+            set_working_precision(adaptive_precision());
+        }
         nan_check("after workspace initialization");
     }
 
@@ -141,11 +269,12 @@ public: // ======================================================== INITIALIZERS
         std::fclose(input_file);
         std::cout << "Successfully read input file." << std::endl;
         x.norm(x_norm, rnd);
-        objective_function(func, x.data(), prec, rnd);
-        objective_gradient(grad.data(), x.data(), prec, rnd);
+        evaluator.objective(func, x.data(), prec, rnd);
+        evaluator.gradient(grad.data(), x.data(), prec, rnd);
         grad.norm(grad_norm, rnd);
+        update_func_groups();
         mpfr_set_zero(step_size, 0);
-        hess_inv.set_identity_matrix();
+        reset_inverse_hessian();
         if (is_rktk_filename(filename)) {
             iter_count = dec_substr_to_int(filename, 52, 64);
             uuid_seg0 = hex_substr_to_int(filename, 15, 23);
@@ -167,12 +296,35 @@ public: // ======================================================== INITIALIZERS
             uuid_seg3 = random_engine() & 0xFFFF;
             uuid_seg4 = random_engine() & 0xFFFFFFFFFFFF;
         }
+        // The input file is read at full precision, since the accuracy of
+        // its contents is not known until the objective has been evaluated.
+        if (precision_guard_bits > 0) {
+            set_working_precision(adaptive_precision());
+        }
     }
 
 public: // =========================================================== ACCESSORS
 
     std::size_t get_iteration_count() { return iter_count; }
 
+    std::size_t get_max_order() { return evaluator.get_max_order(); }
+
+    mpfr_prec_t get_precision() { return prec; }
+
+    // Returns true if the objective function value at the current point is
+    // less than bound.
+    bool objective_function_is_below(double bound) {
+        return (mpfr_cmp_d(func, bound) < 0);
+    }
+
+    // Returns true if the objective function has been reduced far enough
+    // below the working precision for the current order-continuation stage
+    // to be considered converged. In adaptive-precision mode, this refers to
+    // the highest precision the working precision may be raised to.
+    bool stage_has_converged() {
+        return (mpfr_cmp_si_2exp(func, 1, -(max_prec / 2)) <= 0);
+    }
+
     bool objective_function_has_decreased() {
         return (mpfr_less_p(func_new, func) != 0);
     }
@@ -190,15 +342,88 @@ public: // =========================================================== ACCESSORS
                 print_precision, step_size, print_precision, x_norm);
         switch (step_type) {
             case StepType::BFGS:
-                std::cout << "BFGS" << std::endl;
+                std::cout << "BFGS";
                 break;
             case StepType::GRAD:
-                std::cout << "GRAD" << std::endl;
+                std::cout << "GRAD";
+                break;
+            case StepType::LM:
+                std::cout << "LM";
+                break;
+            case StepType::GN:
+                std::cout << "GN";
+                break;
+            case StepType::NEWTON:
+                std::cout << "NCG";
+                break;
+            case StepType::SR1:
+                std::cout << "SR1";
                 break;
             case StepType::NONE:
-                std::cout << "NONE" << std::endl;
+                std::cout << "NONE";
                 break;
         }
+        // Objective cache statistics, printed as hits/misses.
+        std::cout << " | cache " << evaluator.get_cache_hit_count() << '/'
+                  << evaluator.get_cache_miss_count();
+        // Pooled allocator statistics, summed over all threads and printed
+        // as hits/misses.
+        if (pool_allocator_installed()) {
+            const PoolStatistics pool = get_pool_statistics();
+            std::cout << " | pool " << pool.pool_hits << '/'
+                      << pool.pool_misses;
+        }
+        if (evaluator.get_max_order() < MAX_ORDER) {
+            std::cout << " | order <= " << evaluator.get_max_order();
+        }
+        if (evaluator.get_column_assumptions() > 0) {
+            std::cout << " | D(" << evaluator.get_column_assumptions() << ")";
+        }
+        if (limited_memory != nullptr) {
+            std::cout << " | L-BFGS " << limited_memory->get_history_length();
+        }
+        if (low_precision != nullptr) {
+            std::cout << (low_precision->uses_double_double()
+                          ? " | H double-double" : " | H double");
+        }
+        if (update_rule == InverseHessianUpdate::MBFGST) {
+            std::cout << " | MBFGS-T";
+        }
+        if (truncated_newton != nullptr) {
+            std::cout << " | CG " << cg_iterations;
+        }
+        if (wolfe_line_search) {
+            std::cout << " | Wolfe " << line_search_evaluations;
+        }
+        if (gradient_search_skip_streak > 0) {
+            std::cout << " | BFGS streak " << bfgs_win_streak;
+        }
+        if (ladder_pool != nullptr) {
+            std::cout << " | ladder " << ladder_trials << '/'
+                      << ladder_pool->get_thread_count();
+        }
+        if (speculation != nullptr) {
+            std::cout << " | spec " << speculation->get_used_count() << '/'
+                      << speculation->get_started_count();
+        }
+        if (precision_guard_bits > 0) {
+            std::cout << " | prec " << prec;
+        }
+        if (gradient_guard_bits > 0) {
+            std::cout << " | grad prec " << grad_prec;
+        }
+        // Sums of squared residuals by order, followed by those of the
+        // simplifying assumptions (if any).
+        if (has_func_groups) {
+            std::cout << " |";
+            for (std::size_t k = 1; k <= evaluator.get_max_order(); ++k) {
+                mpfr_printf(" %.1RNe", func_groups[k - 1]);
+            }
+            if (evaluator.get_column_assumptions() > 0) {
+                mpfr_printf(" D %.1RNe", func_groups[MAX_ORDER]);
+            }
+        }
+        std::cout << std::endl;
     }
 
     void write_to_file() {
@@ -239,11 +464,345 @@ public: // =========================================================== ACCESSORS
                      print_precision, step_size);
         mpfr_fprintf(output_file, "Distance from origin:     %+.*RNe\n",
                      print_precision, x_norm);
+        if (evaluator.get_max_order() < MAX_ORDER) {
+            // The values above only account for order conditions up to this
+            // order (order-continuation mode).
+            std::fprintf(output_file, "Maximum order considered: %zu\n",
+                         evaluator.get_max_order());
+        }
+        if (evaluator.get_column_assumptions() > 0) {
+            // The values above include the residuals of the column
+            // simplifying assumptions in place of the order conditions
+            // they imply.
+            std::fprintf(output_file, "Simplifying assumptions:  D(%zu)\n",
+                         evaluator.get_column_assumptions());
+        }
+        if (has_func_groups) {
+            for (std::size_t k = 1; k <= evaluator.get_max_order(); ++k) {
+                mpfr_fprintf(output_file, "Order %2zu residual sum:    "
+                                          "%+.*RNe\n", k,
+                             print_precision, func_groups[k - 1]);
+            }
+            if (evaluator.get_column_assumptions() > 0) {
+                mpfr_fprintf(output_file, "Assumption residual sum:  "
+                                          "%+.*RNe\n",
+                             print_precision, func_groups[MAX_ORDER]);
+            }
+        }
         std::fclose(output_file);
     }
 
 public: // ============================================================ MUTATORS
 
+    // Restricts the objective function to order conditions of order at most
+    // order. Must be called before initialization.
+    void set_max_order(std::size_t order) { evaluator.set_max_order(order); }
+
+    // Enforces the column simplifying assumption D(zeta) in place of the
+    // order conditions it implies. Must be called before initialization.
+    void set_column_assumptions(std::size_t zeta) {
+        evaluator.set_column_assumptions(zeta);
+    }
+
+    // Adds the order conditions of the next higher order to the objective
+    // function and re-evaluates it at the current point. Since the
+    // curvature of the new objective function is unrelated to that of the
+    // old one, the approximate inverse Hessian is reset. Returns false if all
+    // order conditions are already included.
+    bool increase_max_order() {
+        if (evaluator.get_max_order() >= MAX_ORDER) { return false; }
+        evaluator.set_max_order(evaluator.get_max_order() + 1);
+        evaluator.objective(func, x.data(), prec, rnd);
+        evaluator.gradient(grad.data(), x.data(), prec, rnd);
+        grad.norm(grad_norm, rnd);
+        update_func_groups();
+        reset_inverse_hessian();
+        step_type = StepType::NONE;
+        nan_check("while increasing maximum order");
+        return true;
+    }
+
+    // Evaluates gradients in reverse mode, keeping at most budget bytes of
+    // intermediate results and recomputing the rest as needed.
+    void set_gradient_tape_budget(std::size_t budget) {
+        evaluator.set_reverse_mode(budget);
+    }
+
+    // Evaluates objective functions in multiword fixed-point arithmetic
+    // whenever the working precision allows it.
+    void set_multiword_kernels() {
+        evaluator.set_multiword_kernels();
+    }
+
+    // Evaluates objective functions in compensated double-precision
+    // arithmetic whenever the working precision is at most 53 bits.
+    void set_compensated_double() { evaluator.set_compensated_double(); }
+
+    // Selects the rule used to update the dense approximate inverse Hessian.
+    // Has no effect in limited-memory mode.
+    void set_update_rule(InverseHessianUpdate rule) { update_rule = rule; }
+
+    // Enables limited-memory mode, in which the approximate inverse Hessian
+    // is formed from the history_length most recent steps (L-BFGS) rather
+    // than stored as a dense matrix. A value of zero keeps the dense matrix.
+    // Must be called before initialization.
+    void set_limited_memory(std::size_t history_length) {
+        if (history_length == 0) { return; }
+        delete limited_memory;
+        limited_memory = new LimitedMemoryInverseHessian(history_length, prec);
+        set_workspace_precision(hess_inv.data(), NUM_PACKED_ENTRIES,
+                                MPFR_PREC_MIN);
+    }
+
+    // Enables low-precision mode, in which the approximate inverse Hessian
+    // is stored and updated in double (or, if use_double_double is true,
+    // double-double) arithmetic while everything else remains at the
+    // working precision. Must be called before initialization.
+    void set_low_precision_inverse_hessian(bool use_double_double) {
+        delete low_precision;
+        low_precision = new LowPrecisionInverseHessian(use_double_double,
+                                                       prec);
+        set_workspace_precision(hess_inv.data(), NUM_PACKED_ENTRIES,
+                                MPFR_PREC_MIN);
+    }
+
+    // Enables Wolfe mode, in which each BFGS step size is chosen by a strong
+    // Wolfe line search along the quasi-Newton direction alone. The steepest
+    // descent direction is only searched (and the approximate inverse
+    // Hessian reset) when that search makes no progress.
+    void set_wolfe_line_search() { wolfe_line_search = true; }
+
+    // Enables concurrent mode, in which the two quadratic line searches of
+    // each BFGS iteration run on separate threads. Both find exactly the
+    // same step sizes as when run one after the other.
+    void set_concurrent_line_search() {
+        if (line_search_worker == nullptr) {
+            line_search_worker = new BackgroundWorker();
+        }
+    }
+
+    // Stops searching the steepest descent direction in most iterations
+    // once the quasi-Newton direction has won streak consecutive times (see
+    // gradient_search_skip_streak). A streak of zero searches both
+    // directions in every iteration.
+    void set_gradient_search_skip(std::size_t streak) {
+        gradient_search_skip_streak = streak;
+    }
+
+    // Enables ladder mode, in which each quadratic line search evaluates
+    // 4 <= trials <= LADDER_MAX_TRIALS step sizes simultaneously on
+    // num_threads >= 1 threads (see LadderLineSearcher). Takes precedence
+    // over concurrent mode: both line searches would share the WorkerPool,
+    // which runs one batch of tasks at a time, so they run one after the
+    // other instead.
+    void set_ladder_line_search(std::size_t trials, std::size_t num_threads) {
+        delete ladder_pool;
+        ladder_pool = new WorkerPool(num_threads);
+        ladder_trials = trials;
+    }
+
+    // Enables speculative mode, in which the gradient at the best trial
+    // point of the quadratic line searches is evaluated in the background
+    // while they continue, and the work is discarded if a different point
+    // is accepted.
+    void set_speculative_gradient() {
+        if (speculation == nullptr) {
+            speculation = new SpeculativeGradient(evaluator, prec, rnd);
+        }
+    }
+
+    // Enables Levenberg-Marquardt mode, in which each step minimizes a
+    // damped linearization of the residuals of the order conditions (see
+    // LevenbergMarquardtSolver) instead of performing a BFGS line search.
+    // Must be called before initialization, and cannot be combined with
+    // simplifying assumptions.
+    void set_levenberg_marquardt() {
+        delete least_squares;
+        least_squares = new LevenbergMarquardtSolver(prec);
+        has_jacobian = false;
+        set_workspace_precision(hess_inv.data(), NUM_PACKED_ENTRIES,
+                                MPFR_PREC_MIN);
+    }
+
+    // Enables Newton-CG mode, in which each step direction is an inexact
+    // Newton step computed by TruncatedNewtonSolver, followed by a single
+    // line search. Must be called before initialization.
+    void set_truncated_newton() {
+        delete truncated_newton;
+        truncated_newton = new TruncatedNewtonSolver(prec);
+        set_workspace_precision(hess_inv.data(), NUM_PACKED_ENTRIES,
+                                MPFR_PREC_MIN);
+    }
+
+    // Enables SR1 trust-region mode (see SR1TrustRegion). Must be called
+    // before initialization.
+    void set_sr1_trust_region() {
+        delete trust_region;
+        trust_region = new SR1TrustRegion(prec);
+        set_workspace_precision(hess_inv.data(), NUM_PACKED_ENTRIES,
+                                MPFR_PREC_MIN);
+    }
+
+    // Polishes the current point by up to max_iterations Gauss-Newton
+    // iterations at twice the maximum working precision, solving each
+    // linearized least-squares problem by Householder QR factorization (see
+    // gauss_newton_step_qr). Stops early once the objective function, which
+    // is the squared norm of the residuals, no longer decreases. Each
+    // accepted iteration is printed. Returns false if simplifying
+    // assumptions are enforced, since the Jacobian of their residuals is not
+    // available.
+    //
+    // Only the state read by polish, print, and write_to_file is raised to
+    // the higher precision; the approximate inverse Hessian and all other
+    // workspace variables are left as they are, so no other optimization
+    // step may follow.
+    bool polish(std::size_t max_iterations, int print_precision) {
+        if (evaluator.get_column_assumptions() > 0) { return false; }
+        prec = 2 * max_prec;
+        round_to_precision(x.data(), NUM_VARS, prec, rnd);
+        mpfr_prec_round(step_size, prec, rnd);
+        set_workspace_precision(x_new.data(), NUM_VARS, prec);
+        set_workspace_precision(grad.data(), NUM_VARS, prec);
+        set_workspace_precision(step_dir.data(), NUM_VARS, prec);
+        set_workspace_precision(func_groups.data(), NUM_RESIDUAL_GROUPS, prec);
+        mpfr_ptr scalars[] = {x_norm, grad_norm, func, func_new};
+        for (mpfr_ptr scalar : scalars) { mpfr_set_prec(scalar, prec); }
+        x.norm(x_norm, rnd);
+        evaluator.objective(func, x.data(), prec, rnd);
+        update_func_groups();
+        nan_check("while changing working precision for polishing");
+        auto *const res = new mpfr_t[NUM_RESIDUALS];
+        auto *const jac = new mpfr_t[NUM_RESIDUALS * NUM_VARS];
+        for (std::size_t k = 0; k < NUM_RESIDUALS; ++k) {
+            mpfr_init2(res[k], prec);
+        }
+        for (std::size_t k = 0; k < NUM_RESIDUALS * NUM_VARS; ++k) {
+            mpfr_init2(jac[k], prec);
+        }
+        step_type = StepType::GN;
+        for (std::size_t i = 0;; ++i) {
+            // The Jacobian at each new point also yields its gradient.
+            evaluator.residual_jacobian(res, jac, x.data(), prec, rnd);
+            residual_gradient(grad, res, jac, rnd);
+            grad.norm(grad_norm, rnd);
+            nan_check("during evaluation of Jacobian while polishing");
+            if (i > 0) { print(print_precision); }
+            if (i == max_iterations) { break; }
+            gauss_newton_step_qr(step_dir, jac, res, prec, rnd);
+            x_new.set_add(x, step_dir, rnd);
+            evaluator.objective(func_new, x_new.data(), prec, rnd);
+            nan_check("during Gauss-Newton step while polishing");
+            if (!objective_function_has_decreased()) { break; }
+            x.swap(x_new);
+            x.norm(x_norm, rnd);
+            mpfr_set(func, func_new, rnd);
+            step_dir.norm(step_size, rnd);
+            update_func_groups();
+            ++iter_count;
+        }
+        for (std::size_t k = 0; k < NUM_RESIDUALS; ++k) { mpfr_clear(res[k]); }
+        for (std::size_t k = 0; k < NUM_RESIDUALS * NUM_VARS; ++k) {
+            mpfr_clear(jac[k]);
+        }
+        delete[] res;
+        delete[] jac;
+        return true;
+    }
+
+    // Enables mixed-precision mode, in which gradients are evaluated with
+    // guard_bits bits beyond the magnitude of the current gradient norm.
+    // A value of zero disables mixed-precision mode.
+    void set_mixed_precision(mpfr_prec_t guard_bits) {
+        gradient_guard_bits = guard_bits;
+    }
+
+    // Enables adaptive-precision mode, in which the working precision is
+    // kept guard_bits bits beyond the magnitudes of the current residuals
+    // and gradient norm. A value of zero disables adaptive-precision mode.
+    // Must be called before initialization.
+    void set_adaptive_precision(mpfr_prec_t guard_bits) {
+        precision_guard_bits = guard_bits;
+    }
+
+    // When running below the maximum precision (in adaptive-precision mode
+    // or after select_precision), doubles the working precision (up to the
+    // maximum) once no further progress can be made at the current one.
+    // Returns false if the working precision cannot be increased.
+    bool increase_precision() {
+        if (prec >= max_prec) { return false; }
+        set_working_precision((2 * prec < max_prec) ? 2 * prec : max_prec);
+        return true;
+    }
+
+    // Evaluates the objective function at the current point in ball
+    // arithmetic, first at the working precision and then at successively
+    // larger multiples of 64 bits, and switches to the lowest of these
+    // precisions at which the objective function is guaranteed to agree
+    // with its value at the working precision to correct_bits bits. The
+    // error bounds obtained along the way are printed. Returns false if the
+    // objective function cannot be evaluated in ball arithmetic.
+    bool select_precision(mpfr_prec_t correct_bits) {
+        mpfr_t f_ref, f_ref_rad, f_trial, f_trial_rad, err, tolerance;
+        mpfr_t res_rad[NUM_ORDER_CONDITIONS];
+        mpfr_init2(f_ref, prec);
+        mpfr_init2(f_trial, prec);
+        mpfr_inits2(BALL_RADIUS_PRECISION,
+                    f_ref_rad, f_trial_rad, err, tolerance,
+                    static_cast<mpfr_ptr>(nullptr));
+        for (std::size_t k = 0; k < NUM_ORDER_CONDITIONS; ++k) {
+            mpfr_init2(res_rad[k], BALL_RADIUS_PRECISION);
+        }
+        const bool supported = evaluator.objective_error_bound(
+                f_ref, f_ref_rad, res_rad, x.data(), prec, rnd);
+        mpfr_prec_t selected = prec;
+        if (supported) {
+            std::size_t worst = 0;
+            for (std::size_t k = 1; k < NUM_ORDER_CONDITIONS; ++k) {
+                if (mpfr_greater_p(res_rad[k], res_rad[worst])) { worst = k; }
+            }
+            mpfr_printf("Objective function at %ld bits: %.6RNe +/- %.3RUe "
+                        "(largest residual error bound %.3RUe in order "
+                        "condition %zu)\n", static_cast<long>(prec), f_ref,
+                        f_ref_rad, res_rad[worst], worst);
+            mpfr_mul_2si(tolerance, f_ref, -correct_bits, MPFR_RNDD);
+            if (mpfr_greater_p(f_ref_rad, tolerance)) {
+                std::cout << "NOTICE: Objective function is not reliable to "
+                          << correct_bits << " bits at the working "
+                             "precision." << std::endl;
+            }
+            for (mpfr_prec_t p = 64; p < prec; p += 64) {
+                mpfr_set_prec(f_trial, p);
+                evaluator.objective_error_bound(
+                        f_trial, f_trial_rad, nullptr, x.data(), p, rnd);
+                // The point itself is rounded to p bits, so the difference
+                // between the two midpoints also counts as error.
+                mpfr_sub(err, f_trial, f_ref, MPFR_RNDU);
+                mpfr_abs(err, err, MPFR_RNDU);
+                mpfr_add(err, err, f_trial_rad, MPFR_RNDU);
+                mpfr_add(err, err, f_ref_rad, MPFR_RNDU);
+                mpfr_printf("Objective function at %ld bits: %.6RNe "
+                            "(error bound %.3RUe)\n", static_cast<long>(p),
+                            f_trial, err);
+                if (mpfr_lessequal_p(err, tolerance)) {
+                    selected = p;
+                    break;
+                }
+            }
+        }
+        mpfr_clears(f_ref, f_trial, f_ref_rad, f_trial_rad, err, tolerance,
+                    static_cast<mpfr_ptr>(nullptr));
+        for (std::size_t k = 0; k < NUM_ORDER_CONDITIONS; ++k) {
+            mpfr_clear(res_rad[k]);
+        }
+        set_working_precision(selected);
+        return supported;
+    }
+
+    void update_func_groups() {
+        has_func_groups = evaluator.breakdown(
+                func_groups.data(), x.data(), prec, rnd);
+    }
+
     void set_step_size() {
         mpfr_set_ui(step_size, 1, rnd);
         mpfr_div_2ui(step_size, step_size,
@@ -251,38 +810,47 @@ public: // ============================================================ MUTATORS
     }
 
     void step(int print_precision) {
+        if (least_squares != nullptr) {
+            levenberg_marquardt_step();
+            return;
+        }
+        if (truncated_newton != nullptr) {
+            truncated_newton_step(print_precision);
+            return;
+        }
+        if (trust_region != nullptr) {
+            trust_region_step();
+            return;
+        }
         nan_check("before performing BFGS iteration");
         // Compute a quasi-Newton step direction by multiplying the approximate
         // inverse Hessian matrix by the gradient vector. Negate the result to
         // obtain a direction of local decrease (rather than increase).
         grad_dir = grad;
         grad_dir.negate_and_normalize(func_new, rnd);
-        step_dir.set_matrix_vector_multiply(hess_inv, grad, rnd);
+        if (limited_memory != nullptr) {
+            limited_memory->multiply(step_dir, grad, rnd);
+        } else if (low_precision != nullptr) {
+            low_precision->multiply(step_dir, grad, rnd);
+        } else {
+            hess_inv.multiply(step_dir, grad, rnd);
+        }
         nan_check("during calculation of BFGS step direction");
+        // In Wolfe mode, the length of the full quasi-Newton step is the
+        // initial step size of the line search.
+        if (wolfe_line_search) { step_dir.norm(step_size_grad, rnd); }
         // Normalize the step direction to ensure consistency of step sizes.
         step_dir.negate_and_normalize(func_new, rnd);
         nan_check("during normalization of BFGS step direction");
-        // Compute a near-optimal step size via quadratic line search.
-        {
-            dznl::MPFRQuadraticLineSearcher grad_searcher(
-                    func_grad, step_size_grad,
-                    objective_function, x, func, grad_dir, prec, rnd);
-            grad_searcher.search(step_size);
-            dznl::MPFRQuadraticLineSearcher bfgs_searcher(
-                    func_new, step_size_new,
-                    objective_function, x, func, step_dir, prec, rnd);
-            bfgs_searcher.search(step_size);
-            if (mpfr_less_p(func_grad, func_new)) {
-                step_dir = grad_dir;
-                hess_inv.set_identity_matrix();
-                mpfr_set(func_new, func_grad, rnd);
-                mpfr_set(step_size_new, step_size_grad, rnd);
-                step_type = StepType::GRAD;
-            } else {
-                step_type = StepType::BFGS;
+        if (wolfe_line_search) {
+            wolfe_step();
+        } else {
+            if (speculation != nullptr) {
+                speculation->begin(func, prec, gradient_precision());
             }
+            quadratic_step();
         }
-        nan_check("during quadratic line search");
+        nan_check("during line search");
         if (mpfr_zero_p(step_size_new)) {
             print(print_precision);
             std::cout << "NOTICE: Optimal step size reduced to zero. BFGS "
@@ -290,24 +858,355 @@ public: // ============================================================ MUTATORS
                       << std::endl;
             return;
         }
-        // Take a step using the computed step direction and step size.
-        x_new.set_axpy(step_size_new, step_dir, x, rnd);
-        x_new.norm(x_new_norm, rnd);
-        objective_function(func_new, x_new.data(), prec, rnd);
-        // Evaluate the gradient vector at the new point.
-        objective_gradient(grad_new.data(), x_new.data(), prec, rnd);
-        nan_check("during evaluation of objective gradient at new point");
-        grad_new.norm(grad_new_norm, rnd);
-        nan_check("while evaluating norm of objective gradient");
+        // The accept/reject decision above was made at full precision, but
+        // the gradient only determines the next search direction, so it may
+        // be less accurate.
+        grad_prec = gradient_precision();
+        evaluate_new_point();
         // Use difference between previous and current gradient vectors to
         // perform a rank-one update of the approximate inverse Hessian matrix.
         grad_delta.set_sub(grad_new, grad, rnd);
         nan_check("while subtracting consecutive gradient vectors");
-        update_inverse_hessian(hess_inv,
-                               grad_delta, step_size_new, step_dir, prec, rnd);
+        if (limited_memory != nullptr) {
+            limited_memory->update(grad_delta, step_size_new, step_dir, rnd);
+        } else if (low_precision != nullptr) {
+            low_precision->update(grad_delta, step_size_new, step_dir, rnd);
+        } else if (update_rule == InverseHessianUpdate::MBFGST) {
+            // Until shift() is called, func and grad still hold the objective
+            // function value and gradient at the previous point.
+            update_inverse_hessian_mbfgst(hess_inv, func, func_new,
+                                          grad, grad_new, grad_delta,
+                                          step_size_new, step_dir, prec, rnd);
+        } else {
+            update_inverse_hessian(hess_inv, grad_delta, step_size_new,
+                                   step_dir, prec, rnd);
+        }
         nan_check("while updating approximate inverse Hessian");
     }
 
+    // Chooses the BFGS step size by a strong Wolfe line search along
+    // step_dir, starting from the full quasi-Newton step, whose length step()
+    // leaves in step_size_grad. If that search makes no progress, the
+    // steepest descent direction grad_dir is searched instead and the
+    // approximate inverse Hessian is reset. The objective function value at
+    // the accepted point is cached by the line search, so evaluate_new_point
+    // only computes its gradient.
+    void wolfe_step() {
+        WolfeLineSearcher bfgs_searcher(
+                evaluator, func_new, step_size_new,
+                x, func, grad, step_dir, prec, rnd);
+        bfgs_searcher.search(step_size_grad);
+        line_search_evaluations = bfgs_searcher.get_evaluation_count();
+        step_type = StepType::BFGS;
+        if (!mpfr_zero_p(step_size_new)) { return; }
+        WolfeLineSearcher grad_searcher(
+                evaluator, func_new, step_size_new,
+                x, func, grad, grad_dir, prec, rnd);
+        grad_searcher.search(step_size);
+        line_search_evaluations += grad_searcher.get_evaluation_count();
+        if (mpfr_zero_p(step_size_new)) { return; }
+        step_dir = grad_dir;
+        reset_inverse_hessian();
+        step_type = StepType::GRAD;
+    }
+
+    // Computes near-optimal step sizes via quadratic line searches along
+    // grad_dir and step_dir, and keeps whichever direction decreases the
+    // objective function more. If the steepest descent direction wins, the
+    // approximate inverse Hessian is reset.
+    void quadratic_step() {
+        if (ladder_pool != nullptr) {
+            LadderLineSearcher grad_searcher(
+                    evaluator, *ladder_pool, ladder_trials,
+                    func_grad, step_size_grad,
+                    x, func, grad_dir, prec, rnd, speculation);
+            LadderLineSearcher bfgs_searcher(
+                    evaluator, *ladder_pool, ladder_trials,
+                    func_new, step_size_new,
+                    x, func, step_dir, prec, rnd, speculation);
+            compare_line_searches(grad_searcher, bfgs_searcher);
+        } else {
+            BoundedQuadraticLineSearcher grad_searcher(
+                    evaluator, func_grad, step_size_grad,
+                    x, func, grad, grad_dir, prec, rnd, speculation);
+            BoundedQuadraticLineSearcher bfgs_searcher(
+                    evaluator, func_new, step_size_new,
+                    x, func, grad, step_dir, prec, rnd, speculation);
+            compare_line_searches(grad_searcher, bfgs_searcher);
+        }
+    }
+
+    // Runs the line searches of quadratic_step, skipping or overlapping
+    // the one along grad_dir as configured, and keeps the better step.
+    template <typename LineSearcher>
+    void compare_line_searches(LineSearcher &grad_searcher,
+                               LineSearcher &bfgs_searcher) {
+        bool searched_grad = !skips_gradient_search();
+        if (searched_grad && (line_search_worker != nullptr) &&
+            (ladder_pool == nullptr)) {
+            // The searches only share read-only inputs and the evaluator,
+            // whose cache and workspaces are safe for concurrent use.
+            line_search_worker->start([&grad_searcher, this] {
+                grad_searcher.search(step_size);
+            });
+            bfgs_searcher.search(step_size);
+            line_search_worker->wait();
+        } else {
+            if (searched_grad) { grad_searcher.search(step_size); }
+            bfgs_searcher.search(step_size);
+            if (!searched_grad && mpfr_zero_p(step_size_new)) {
+                // Convergence is only declared if neither direction makes
+                // progress.
+                grad_searcher.search(step_size);
+                searched_grad = true;
+            }
+        }
+        if (searched_grad && mpfr_less_p(func_grad, func_new)) {
+            step_dir = grad_dir;
+            reset_inverse_hessian();
+            mpfr_set(func_new, func_grad, rnd);
+            mpfr_set(step_size_new, step_size_grad, rnd);
+            step_type = StepType::GRAD;
+            bfgs_win_streak = 0;
+        } else {
+            step_type = StepType::BFGS;
+            ++bfgs_win_streak;
+        }
+    }
+
+    bool skips_gradient_search() const {
+        return (gradient_search_skip_streak > 0) &&
+               (bfgs_win_streak >= gradient_search_skip_streak) &&
+               (bfgs_win_streak % gradient_search_skip_streak != 0);
+    }
+
+    // Takes a step of size step_size_new along step_dir, and evaluates the
+    // objective function at the new point and its gradient at grad_prec bits.
+    void evaluate_new_point() {
+        x_new.set_axpy(step_size_new, step_dir, x, rnd);
+        x_new.norm(x_new_norm, rnd);
+        // The line search has usually evaluated this exact point already, in
+        // which case the objective cache returns its value immediately. The
+        // same holds for the gradient if it has been evaluated speculatively.
+        evaluator.objective(func_new, x_new.data(), prec, rnd);
+        if (speculation != nullptr) { speculation->finish(x_new); }
+        evaluator.gradient(grad_new.data(), x_new.data(), grad_prec, rnd);
+        if (speculation != nullptr) { speculation->wait(); }
+        nan_check("during evaluation of objective gradient at new point");
+        grad_new.norm(grad_new_norm, rnd);
+        nan_check("while evaluating norm of objective gradient");
+    }
+
+    // Performs one Newton-CG iteration. The length of the Newton step is
+    // the initial step size of the line search along its direction. Since
+    // Hessian-vector products difference gradients at the current point,
+    // gradients are always evaluated at full precision in this mode.
+    void truncated_newton_step(int print_precision) {
+        nan_check("before performing Newton-CG iteration");
+        cg_iterations = truncated_newton->solve(
+                step_dir, evaluator, x, x_norm, grad, grad_norm, prec, rnd);
+        nan_check("during conjugate gradient iteration");
+        step_dir.norm(step_size, rnd);
+        for (std::size_t i = 0; i < NUM_VARS; ++i) {
+            mpfr_div(step_dir[i], step_dir[i], step_size, rnd);
+        }
+        nan_check("during normalization of Newton step direction");
+        step_type = StepType::NEWTON;
+        {
+            BoundedQuadraticLineSearcher searcher(
+                    evaluator, func_new, step_size_new,
+                    x, func, grad, step_dir, prec, rnd);
+            searcher.search(step_size);
+        }
+        nan_check("during quadratic line search");
+        if (mpfr_zero_p(step_size_new)) {
+            print(print_precision);
+            std::cout << "NOTICE: Optimal step size reduced to zero. Newton-CG "
+                         "iteration has converged to the requested precision."
+                      << std::endl;
+            return;
+        }
+        grad_prec = prec;
+        evaluate_new_point();
+    }
+
+    // Performs one SR1 trust-region iteration. Trial steps are computed with
+    // shrinking trust-region radius until one reduces the objective
+    // function; if none of TR_MAX_TRIAL_STEPS does, func_new is left equal
+    // to func. The gradient is evaluated at every trial point, since each
+    // trial step updates the SR1 approximation whether accepted or not.
+    void trust_region_step() {
+        nan_check("before performing SR1 trust-region iteration");
+        step_type = StepType::SR1;
+        bool accepted = false;
+        for (int i = 0; (i < TR_MAX_TRIAL_STEPS) && !accepted; ++i) {
+            trust_region->solve(step_dir, predicted_reduction,
+                                grad, grad_norm, rnd);
+            nan_check("during Steihaug-CG iteration");
+            step_dir.norm(step_size_new, rnd);
+            if (mpfr_zero_p(step_size_new)) { break; }
+            for (std::size_t j = 0; j < NUM_VARS; ++j) {
+                mpfr_div(step_dir[j], step_dir[j], step_size_new, rnd);
+            }
+            grad_prec = gradient_precision();
+            evaluate_new_point();
+            mpfr_sub(actual_reduction, func, func_new, rnd);
+            grad_delta.set_sub(grad_new, grad, rnd);
+            trust_region->update(grad_delta, step_size_new, step_dir, rnd);
+            nan_check("while updating SR1 approximate Hessian");
+            accepted = trust_region->update_radius(
+                    actual_reduction, predicted_reduction, step_size_new, rnd);
+        }
+        if (!accepted) { mpfr_set(func_new, func, rnd); }
+    }
+
+    // Performs one Levenberg-Marquardt iteration. Trial steps are damped
+    // more and more heavily until one reduces the objective function; if
+    // none of LM_MAX_TRIAL_STEPS does, func_new is left equal to func. The
+    // residuals and Jacobian at an accepted point are kept for the next
+    // iteration, and also yield the gradient there.
+    void levenberg_marquardt_step() {
+        nan_check("before performing Levenberg-Marquardt iteration");
+        if (!has_jacobian) {
+            evaluator.residual_jacobian(least_squares->residuals(),
+                                        least_squares->jacobian(),
+                                        x.data(), prec, rnd);
+            has_jacobian = true;
+        }
+        least_squares->prepare(rnd);
+        nan_check("while forming normal equations");
+        step_type = StepType::LM;
+        bool accepted = false;
+        for (int i = 0; (i < LM_MAX_TRIAL_STEPS) && !accepted; ++i) {
+            if (!least_squares->solve(step_dir, predicted_reduction, rnd)) {
+                least_squares->reject(rnd);
+                continue;
+            }
+            x_new.set_add(x, step_dir, rnd);
+            evaluator.objective(func_new, x_new.data(), prec, rnd);
+            mpfr_sub(actual_reduction, func, func_new, rnd);
+            accepted = least_squares->update_damping(
+                    actual_reduction, predicted_reduction, rnd);
+        }
+        nan_check("during Levenberg-Marquardt trial steps");
+        if (!accepted) {
+            mpfr_set(func_new, func, rnd);
+            return;
+        }
+        step_dir.norm(step_size_new, rnd);
+        x_new.norm(x_new_norm, rnd);
+        evaluator.residual_jacobian(least_squares->new_residuals(),
+                                    least_squares->new_jacobian(),
+                                    x_new.data(), prec, rnd);
+        least_squares->gradient(grad_new, true, rnd);
+        grad_new.norm(grad_new_norm, rnd);
+        nan_check("during evaluation of Jacobian at new point");
+    }
+
+    void reset_inverse_hessian() {
+        if (least_squares != nullptr) {
+            least_squares->reset();
+            has_jacobian = false;
+        }
+        if (trust_region != nullptr) { trust_region->reset(); }
+        if (limited_memory != nullptr) {
+            limited_memory->clear();
+        } else if (low_precision != nullptr) {
+            low_precision->clear();
+        } else {
+            hess_inv.set_identity_matrix();
+        }
+    }
+
+    // Rounding errors in a gradient evaluated with p bits of precision are
+    // on the order of 2^(-p) in absolute terms, since the intermediate
+    // quantities have magnitude roughly one. Hence the gradient retains
+    // about gradient_guard_bits correct bits if p exceeds -log2(grad_norm)
+    // by that amount. The result is rounded up to a multiple of 64 bits
+    // (so workspaces are resized only occasionally) and never exceeds prec.
+    mpfr_prec_t gradient_precision() {
+        if ((gradient_guard_bits == 0) || !mpfr_regular_p(grad_norm)) {
+            return prec;
+        }
+        const mpfr_exp_t magnitude = mpfr_get_exp(grad_norm);
+        mpfr_prec_t result = gradient_guard_bits;
+        if (magnitude < 0) { result -= magnitude; }
+        result = ((result + 63) / 64) * 64;
+        return (result < prec) ? result : prec;
+    }
+
+    // Rounding errors in the objective function are on the order of 2^(-p)
+    // times the magnitude of its residuals, which is roughly sqrt(func), and
+    // those in the gradient are on the order of 2^(-p) in absolute terms
+    // (see gradient_precision). Hence both retain about precision_guard_bits
+    // correct bits if p exceeds -log2 of the smaller of these magnitudes by
+    // that amount. As in gradient_precision, the result is rounded up to a
+    // multiple of 64 bits and never exceeds max_prec.
+    mpfr_prec_t adaptive_precision() {
+        if (!mpfr_regular_p(func)) { return max_prec; }
+        mpfr_exp_t magnitude = mpfr_get_exp(func) / 2;
+        if (mpfr_regular_p(grad_norm) &&
+            (mpfr_get_exp(grad_norm) < magnitude)) {
+            magnitude = mpfr_get_exp(grad_norm);
+        }
+        mpfr_prec_t result = precision_guard_bits;
+        if (magnitude < 0) { result -= magnitude; }
+        result = ((result + 63) / 64) * 64;
+        return (result < max_prec) ? result : max_prec;
+    }
+
+    // Changes the working precision to new_prec, rounding the current
+    // iterate, approximate inverse Hessian, and step size, and re-evaluates
+    // the objective function and its gradient at the new precision. Values
+    // computed at a lower precision are not accurate enough to be compared
+    // against those computed at a higher one. The contents of all other
+    // workspace variables are discarded.
+    void set_working_precision(mpfr_prec_t new_prec) {
+        if (new_prec == prec) { return; }
+        prec = new_prec;
+        round_to_precision(x.data(), NUM_VARS, prec, rnd);
+        if (least_squares != nullptr) {
+            least_squares->set_precision(prec, rnd);
+            has_jacobian = false;
+        }
+        if (truncated_newton != nullptr) {
+            truncated_newton->set_precision(prec);
+        }
+        if (trust_region != nullptr) {
+            trust_region->set_precision(prec, rnd);
+        }
+        if (limited_memory != nullptr) {
+            limited_memory->set_precision(prec, rnd);
+        } else if (low_precision != nullptr) {
+            low_precision->set_precision(prec);
+        } else if ((least_squares == nullptr) &&
+                   (truncated_newton == nullptr) &&
+                   (trust_region == nullptr)) {
+            hess_inv.set_precision(prec, rnd);
+        }
+        mpfr_prec_round(step_size, prec, rnd);
+        set_workspace_precision(x_new.data(), NUM_VARS, prec);
+        set_workspace_precision(grad.data(), NUM_VARS, prec);
+        set_workspace_precision(grad_new.data(), NUM_VARS, prec);
+        set_workspace_precision(grad_delta.data(), NUM_VARS, prec);
+        set_workspace_precision(grad_dir.data(), NUM_VARS, prec);
+        set_workspace_precision(step_dir.data(), NUM_VARS, prec);
+        set_workspace_precision(func_groups.data(), NUM_RESIDUAL_GROUPS, prec);
+        mpfr_ptr scalars[] = {
+                x_norm, x_new_norm, grad_norm, grad_new_norm,
+                func, func_grad, func_new, step_size_grad, step_size_new,
+                predicted_reduction, actual_reduction
+        };
+        for (mpfr_ptr scalar : scalars) { mpfr_set_prec(scalar, prec); }
+        x.norm(x_norm, rnd);
+        evaluator.objective(func, x.data(), prec, rnd);
+        evaluator.gradient(grad.data(), x.data(), prec, rnd);
+        grad.norm(grad_norm, rnd);
+        update_func_groups();
+        grad_prec = prec;
+        nan_check("while changing working precision");
+    }
+
     void shift() {
         x.swap(x_new);
         mpfr_set(x_norm, x_new_norm, rnd);
@@ -315,7 +1214,12 @@ public: // ============================================================ MUTATORS
         grad.swap(grad_new);
         mpfr_set(grad_norm, grad_new_norm, rnd);
         mpfr_set(step_size, step_size_new, rnd);
+        if (least_squares != nullptr) { least_squares->accept_new_point(); }
+        update_func_groups();
         ++iter_count;
+        if ((precision_guard_bits > 0) && (adaptive_precision() > prec)) {
+            set_working_precision(adaptive_precision());
+        }
     }
 
 };
@@ -0,0 +1,240 @@
+#ifndef RKTK_OBJECTIVE_CACHE_HPP_INCLUDED
+#define RKTK_OBJECTIVE_CACHE_HPP_INCLUDED
+
+// C++ standard library headers
+#include <cstddef> // for std::size_t
+#include <mutex>   // for std::mutex, std::lock_guard
+
+// GNU MPFR multiprecision library headers
+#include <mpfr.h>
+
+// RKTK headers
+#include "objective_function.hpp"          // for NUM_VARS
+#include "order_condition_schedule.hpp" // for NUM_RESIDUAL_GROUPS
+
+/*
+ * ObjectiveCache remembers recently computed objective function values and
+ * gradient vectors. Entries are keyed by the exact values of all NUM_VARS
+ * coordinates together with the working precision, so a lookup only
+ * succeeds when the requested evaluation would reproduce the cached result
+ * bit for bit. When the cache is full, the least recently used entry is
+ * evicted.
+ *
+ * Objective function values may be stored together with their breakdown
+ * into residual groups, which can later be retrieved for reporting without
+ * re-evaluating the objective function.
+ *
+ * Lookups and insertions hold a mutex, so that line searches running on
+ * different threads can share a cache.
+ */
+class ObjectiveCache {
+
+private: // ======================================================= DATA MEMBERS
+
+    struct Entry {
+        mpfr_t x[NUM_VARS];
+        mpfr_t f;
+        mpfr_t groups[NUM_RESIDUAL_GROUPS];
+        mpfr_t grad[NUM_VARS];
+        mpfr_prec_t prec;
+        bool has_f;
+        bool has_groups;
+        bool has_grad;
+        std::size_t last_use;
+    };
+
+    const std::size_t capacity;
+    Entry *const entries;
+    std::size_t num_entries;
+    std::size_t use_count;
+    std::size_t hit_count;
+    std::size_t miss_count;
+    std::mutex mutex;
+
+public: // ======================================================== CONSTRUCTORS
+
+    explicit ObjectiveCache(std::size_t num_entries_max) :
+            capacity(num_entries_max), entries(new Entry[num_entries_max]),
+            num_entries(0), use_count(0), hit_count(0), miss_count(0) {}
+
+    // explicitly disallow copy construction
+    ObjectiveCache(const ObjectiveCache &) = delete;
+
+    // explicitly disallow copy assignment
+    ObjectiveCache &operator=(const ObjectiveCache &) = delete;
+
+public: // ========================================================== DESTRUCTOR
+
+    ~ObjectiveCache() {
+        for (std::size_t k = 0; k < num_entries; ++k) {
+            for (std::size_t i = 0; i < NUM_VARS; ++i) {
+                mpfr_clear(entries[k].x[i]);
+                mpfr_clear(entries[k].grad[i]);
+            }
+            mpfr_clear(entries[k].f);
+            for (std::size_t i = 0; i < NUM_RESIDUAL_GROUPS; ++i) {
+                mpfr_clear(entries[k].groups[i]);
+            }
+        }
+        delete[] entries;
+    }
+
+public: // =========================================================== ACCESSORS
+
+    std::size_t get_hit_count() const { return hit_count; }
+
+    std::size_t get_miss_count() const { return miss_count; }
+
+public: // ============================================================ MUTATORS
+
+    // Copies the cached objective function value at x into f and returns
+    // true if one is available. Otherwise, returns false.
+    bool find_objective(mpfr_t f, mpfr_t *x, mpfr_prec_t prec, mpfr_rnd_t rnd) {
+        std::lock_guard<std::mutex> lock(mutex);
+        Entry *entry = find(x, prec);
+        if (entry == nullptr || !entry->has_f) {
+            ++miss_count;
+            return false;
+        }
+        mpfr_set(f, entry->f, rnd);
+        ++hit_count;
+        return true;
+    }
+
+    // Copies the cached breakdown of the objective function value at x into
+    // groups and returns true if one is available. Otherwise, returns false.
+    // Since breakdowns are only used for reporting, lookups are not counted
+    // as cache hits or misses.
+    bool find_breakdown(mpfr_t *groups, mpfr_t *x,
+                        mpfr_prec_t prec, mpfr_rnd_t rnd) {
+        std::lock_guard<std::mutex> lock(mutex);
+        Entry *entry = find(x, prec);
+        if (entry == nullptr || !entry->has_groups) { return false; }
+        for (std::size_t i = 0; i < NUM_RESIDUAL_GROUPS; ++i) {
+            mpfr_set(groups[i], entry->groups[i], rnd);
+        }
+        return true;
+    }
+
+    // Copies the cached gradient vector at x into dst and returns true if
+    // one is available. Otherwise, returns false.
+    bool find_gradient(mpfr_t *dst, mpfr_t *x,
+                       mpfr_prec_t prec, mpfr_rnd_t rnd) {
+        std::lock_guard<std::mutex> lock(mutex);
+        Entry *entry = find(x, prec);
+        if (entry == nullptr || !entry->has_grad) {
+            ++miss_count;
+            return false;
+        }
+        for (std::size_t i = 0; i < NUM_VARS; ++i) {
+            mpfr_set(dst[i], entry->grad[i], rnd);
+        }
+        ++hit_count;
+        return true;
+    }
+
+    // Stores the objective function value f at x, together with its
+    // breakdown into residual groups unless groups is a null pointer.
+    void store_objective(mpfr_t *x, mpfr_t f, mpfr_t *groups,
+                         mpfr_prec_t prec, mpfr_rnd_t rnd) {
+        std::lock_guard<std::mutex> lock(mutex);
+        Entry *entry = find(x, prec);
+        if (entry == nullptr) { entry = insert(x, prec, rnd); }
+        mpfr_set(entry->f, f, rnd);
+        entry->has_f = true;
+        if (groups != nullptr) {
+            for (std::size_t i = 0; i < NUM_RESIDUAL_GROUPS; ++i) {
+                mpfr_set(entry->groups[i], groups[i], rnd);
+            }
+            entry->has_groups = true;
+        }
+    }
+
+    void store_gradient(mpfr_t *x, mpfr_t *grad,
+                        mpfr_prec_t prec, mpfr_rnd_t rnd) {
+        std::lock_guard<std::mutex> lock(mutex);
+        Entry *entry = find(x, prec);
+        if (entry == nullptr) { entry = insert(x, prec, rnd); }
+        for (std::size_t i = 0; i < NUM_VARS; ++i) {
+            mpfr_set(entry->grad[i], grad[i], rnd);
+        }
+        entry->has_grad = true;
+    }
+
+    // Forgets all cached results (but not the hit and miss counts). This
+    // must be called whenever the function being evaluated changes.
+    void clear() {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (std::size_t k = 0; k < num_entries; ++k) {
+            entries[k].has_f = false;
+            entries[k].has_groups = false;
+            entries[k].has_grad = false;
+        }
+    }
+
+private: // ===================================================== HELPER METHODS
+
+    Entry *find(mpfr_t *x, mpfr_prec_t prec) {
+        for (std::size_t k = 0; k < num_entries; ++k) {
+            Entry &entry = entries[k];
+            if (entry.prec != prec) { continue; }
+            bool match = true;
+            for (std::size_t i = 0; i < NUM_VARS; ++i) {
+                if (!mpfr_equal_p(entry.x[i], x[i])) {
+                    match = false;
+                    break;
+                }
+            }
+            if (match) {
+                entry.last_use = ++use_count;
+                return &entry;
+            }
+        }
+        return nullptr;
+    }
+
+    Entry *insert(mpfr_t *x, mpfr_prec_t prec, mpfr_rnd_t rnd) {
+        Entry *entry;
+        if (num_entries < capacity) {
+            entry = entries + num_entries;
+            ++num_entries;
+            for (std::size_t i = 0; i < NUM_VARS; ++i) {
+                mpfr_init2(entry->x[i], mpfr_get_prec(x[i]));
+                mpfr_init2(entry->grad[i], prec);
+            }
+            mpfr_init2(entry->f, prec);
+            for (std::size_t i = 0; i < NUM_RESIDUAL_GROUPS; ++i) {
+                mpfr_init2(entry->groups[i], prec);
+            }
+        } else {
+            entry = entries;
+            for (std::size_t k = 1; k < num_entries; ++k) {
+                if (entries[k].last_use < entry->last_use) {
+                    entry = entries + k;
+                }
+            }
+            for (std::size_t i = 0; i < NUM_VARS; ++i) {
+                // Keys must be stored exactly, so they are kept at the
+                // precision of the point that was evaluated.
+                mpfr_set_prec(entry->x[i], mpfr_get_prec(x[i]));
+                mpfr_set_prec(entry->grad[i], prec);
+            }
+            mpfr_set_prec(entry->f, prec);
+            for (std::size_t i = 0; i < NUM_RESIDUAL_GROUPS; ++i) {
+                mpfr_set_prec(entry->groups[i], prec);
+            }
+        }
+        for (std::size_t i = 0; i < NUM_VARS; ++i) {
+            mpfr_set(entry->x[i], x[i], rnd);
+        }
+        entry->prec = prec;
+        entry->has_f = false;
+        entry->has_groups = false;
+        entry->has_grad = false;
+        entry->last_use = ++use_count;
+        return entry;
+    }
+
+};
+
+#endif // RKTK_OBJECTIVE_CACHE_HPP_INCLUDED
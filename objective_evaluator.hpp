@@ -0,0 +1,426 @@
+#ifndef RKTK_OBJECTIVE_EVALUATOR_HPP_INCLUDED
+#define RKTK_OBJECTIVE_EVALUATOR_HPP_INCLUDED
+
+// C++ standard library headers
+#include <atomic>  // for std::atomic
+#include <cstddef> // for std::size_t
+#include <vector>  // for std::vector
+
+// GNU MPFR multiprecision library headers
+#include <mpfr.h>
+
+// RKTK headers
+#include "objective_cache.hpp"
+#include "objective_function.hpp"
+#include "order_condition_schedule.hpp"
+#include "scheduled_evaluators.hpp"
+#include "simplifying_assumptions.hpp"
+
+/*
+ * ObjectiveEvaluator is the single point through which the optimizers
+ * evaluate the objective function and its gradient. It determines which
+ * order conditions participate in the objective function, adds the residuals
+ * of any enforced simplifying assumptions, dispatches to the
+ * machine-generated evaluators when the objective function is unmodified,
+ * and memoizes results in an ObjectiveCache.
+ */
+class ObjectiveEvaluator {
+
+private: // ======================================================= DATA MEMBERS
+
+    // The cache is large enough to retain the current point together with
+    // the trial points of two ladder line searches (see LADDER_MAX_TRIALS).
+    ObjectiveCache cache;
+    std::size_t max_order;
+    std::size_t column_assumptions;
+    // Gradients may be evaluated on several threads at once (see
+    // SpeculativeGradient), which all read and write this precision.
+    std::atomic<mpfr_prec_t> generated_gradient_prec;
+    bool reverse_mode;
+    std::size_t tape_budget;
+    bool multiword;
+    bool compensated_double;
+    bool active[NUM_ORDER_CONDITIONS];
+
+public: // ======================================================== CONSTRUCTORS
+
+    ObjectiveEvaluator() :
+            cache(32), max_order(MAX_ORDER), column_assumptions(0),
+            generated_gradient_prec(0), reverse_mode(false), tape_budget(0),
+            multiword(false), compensated_double(false) {
+        for (std::size_t k = 0; k < NUM_ORDER_CONDITIONS; ++k) {
+            active[k] = true;
+        }
+    }
+
+    // explicitly disallow copy construction
+    ObjectiveEvaluator(const ObjectiveEvaluator &) = delete;
+
+    // explicitly disallow copy assignment
+    ObjectiveEvaluator &operator=(const ObjectiveEvaluator &) = delete;
+
+public: // =========================================================== ACCESSORS
+
+    std::size_t get_max_order() const { return max_order; }
+
+    std::size_t get_column_assumptions() const { return column_assumptions; }
+
+    std::size_t get_active_count() const {
+        std::size_t count = 0;
+        for (std::size_t k = 0; k < NUM_ORDER_CONDITIONS; ++k) {
+            if (active[k]) { ++count; }
+        }
+        return count;
+    }
+
+    std::size_t get_cache_hit_count() const { return cache.get_hit_count(); }
+
+    std::size_t get_cache_miss_count() const { return cache.get_miss_count(); }
+
+public: // ============================================================ MUTATORS
+
+    // Restricts the objective function to the order conditions of order at
+    // most order, where 2 <= order <= MAX_ORDER.
+    void set_max_order(std::size_t order) {
+        max_order = order;
+        update_active_order_conditions();
+    }
+
+    // Enforces the column simplifying assumption D(zeta) as additional
+    // residuals and drops the order conditions it implies, where
+    // 0 <= zeta <= MAX_COLUMN_ASSUMPTION_ORDER and zeta = 0 enforces none.
+    void set_column_assumptions(std::size_t zeta) {
+        column_assumptions = zeta;
+        update_active_order_conditions();
+    }
+
+    // Evaluates all subsequent gradients in reverse mode (see
+    // objective_gradient_reverse), keeping at most budget bytes of
+    // intermediate results.
+    void set_reverse_mode(std::size_t budget) {
+        reverse_mode = true;
+        tape_budget = budget;
+    }
+
+    // Evaluates all subsequent objective functions whose precision is
+    // supported by objective_function_multiword in multiword arithmetic.
+    void set_multiword_kernels() { multiword = true; }
+
+    // Evaluates all subsequent objective functions at precisions of at most
+    // 53 bits in compensated double-precision arithmetic (see
+    // objective_function_double).
+    void set_compensated_double() { compensated_double = true; }
+
+    // Evaluates the objective function. Its breakdown into residual groups
+    // is computed along the way and cached for later retrieval.
+    void objective(mpfr_t f, mpfr_t *x, mpfr_prec_t prec, mpfr_rnd_t rnd) {
+        if (cache.find_objective(f, x, prec, rnd)) { return; }
+        mpfr_t groups[NUM_RESIDUAL_GROUPS];
+        init_groups(groups, prec);
+        if (uses_double_precision(x, prec)) {
+            // Compensated double-precision arithmetic is both faster and
+            // more accurate than MPFR at this precision.
+            objective_function_double(f, x, active_order_conditions(),
+                                      groups, rnd);
+        } else if (!uses_multiword(prec) || !objective_function_multiword(
+                f, x, active_order_conditions(), groups, prec, rnd)) {
+            // When the objective function is unmodified, this performs
+            // exactly the same operations as the machine-generated
+            // objective_function.
+            objective_function_subset(f, x, active_order_conditions(),
+                                      groups, prec, rnd);
+        }
+        add_assumption_residuals(f, groups, x, prec, rnd);
+        cache.store_objective(x, f, groups, prec, rnd);
+        clear_groups(groups);
+    }
+
+    // Evaluates the objective function at the n points x[0], ..., x[n - 1],
+    // storing the values in f[0], ..., f[n - 1]. The results agree exactly
+    // with those of objective, but the points not found in the cache share
+    // a single walk through the order condition schedule (see
+    // objective_function_batch).
+    void objective_batch(mpfr_ptr *f, mpfr_t **x, std::size_t n,
+                         mpfr_prec_t prec, mpfr_rnd_t rnd) {
+        if (uses_double_precision(x[0], prec) || uses_multiword(prec)) {
+            for (std::size_t i = 0; i < n; ++i) {
+                objective(f[i], x[i], prec, rnd);
+            }
+            return;
+        }
+        std::vector<std::size_t> misses;
+        for (std::size_t i = 0; i < n; ++i) {
+            if (!cache.find_objective(f[i], x[i], prec, rnd)) {
+                misses.push_back(i);
+            }
+        }
+        const std::size_t num_points = misses.size();
+        if (num_points == 0) { return; }
+        auto *const points = new mpfr_t[NUM_VARS * num_points];
+        auto *const values = new mpfr_t[num_points];
+        auto *const groups = new mpfr_t[NUM_RESIDUAL_GROUPS * num_points];
+        for (std::size_t q = 0; q < num_points; ++q) {
+            mpfr_t *const point = x[misses[q]];
+            for (std::size_t i = 0; i < NUM_VARS; ++i) {
+                // Copy each component at its own precision, so that the
+                // points are not rounded.
+                mpfr_ptr component = points[i * num_points + q];
+                mpfr_init2(component, mpfr_get_prec(point[i]));
+                mpfr_set(component, point[i], rnd);
+            }
+            mpfr_init2(values[q], mpfr_get_prec(f[misses[q]]));
+            init_groups(groups + q * NUM_RESIDUAL_GROUPS, prec);
+        }
+        objective_function_batch(values, points, num_points,
+                                 active_order_conditions(), groups, prec, rnd);
+        for (std::size_t q = 0; q < num_points; ++q) {
+            mpfr_t *const point = x[misses[q]];
+            mpfr_t *const point_groups = groups + q * NUM_RESIDUAL_GROUPS;
+            add_assumption_residuals(values[q], point_groups, point,
+                                     prec, rnd);
+            mpfr_set(f[misses[q]], values[q], rnd);
+            cache.store_objective(point, values[q], point_groups, prec, rnd);
+            mpfr_clear(values[q]);
+            clear_groups(point_groups);
+        }
+        for (std::size_t i = 0; i < NUM_VARS * num_points; ++i) {
+            mpfr_clear(points[i]);
+        }
+        delete[] points;
+        delete[] values;
+        delete[] groups;
+    }
+
+    // Evaluates the objective function, but may stop early once its value is
+    // known to exceed bound. Returns true if the evaluation ran to completion.
+    bool bounded_objective(mpfr_t f, mpfr_t *x, mpfr_t bound,
+                           mpfr_prec_t prec, mpfr_rnd_t rnd) {
+        // A full evaluation in double precision or multiword arithmetic is
+        // cheaper than the bookkeeping needed to stop early, and keeps the
+        // values compared by the line searchers consistent.
+        if (uses_double_precision(x, prec) || uses_multiword(prec)) {
+            objective(f, x, prec, rnd);
+            return true;
+        }
+        if (cache.find_objective(f, x, prec, rnd)) { return true; }
+        mpfr_t groups[NUM_RESIDUAL_GROUPS];
+        init_groups(groups, prec);
+        // The simplifying assumption residuals are cheap, so they are
+        // evaluated first and deducted from the bound. Rounding the reduced
+        // bound upward ensures that no evaluation is abandoned unless its
+        // value really exceeds the original bound.
+        mpfr_t reduced_bound;
+        mpfr_init2(reduced_bound, prec);
+        mpfr_set_zero(groups[MAX_ORDER], 0);
+        add_column_assumption_residuals(
+                groups[MAX_ORDER], x, column_assumptions, prec, rnd);
+        mpfr_sub(reduced_bound, bound, groups[MAX_ORDER], MPFR_RNDU);
+        const bool completed = objective_function_bounded(
+                f, x, reduced_bound, active_order_conditions(), groups,
+                prec, rnd);
+        mpfr_add(f, f, groups[MAX_ORDER], rnd);
+        if (completed) { cache.store_objective(x, f, groups, prec, rnd); }
+        mpfr_clear(reduced_bound);
+        clear_groups(groups);
+        return completed;
+    }
+
+    // Evaluates the objective function together with its directional
+    // derivative df along dx (see objective_directional_derivative), which
+    // is far cheaper than the full gradient. Both are computed by the same
+    // kind of arithmetic objective would use, so the value of f agrees
+    // exactly with the value objective would compute, and is cached.
+    void objective_derivative(mpfr_t f, mpfr_t df, mpfr_t *x, mpfr_t *dx,
+                              mpfr_prec_t prec, mpfr_rnd_t rnd) {
+        mpfr_t groups[NUM_RESIDUAL_GROUPS];
+        init_groups(groups, prec);
+        // Set when objective would use multiword arithmetic but f had to be
+        // computed by MPFR instead.
+        bool inconsistent = false;
+        if (uses_double_precision(x, prec)) {
+            objective_directional_derivative_double(
+                    f, df, x, dx, active_order_conditions(), groups, rnd);
+        } else if (!uses_multiword(prec) ||
+                   !objective_directional_derivative_multiword(
+                           f, df, x, dx, active_order_conditions(), groups,
+                           prec, rnd)) {
+            objective_directional_derivative(f, df, x, dx,
+                                             active_order_conditions(),
+                                             groups, prec, rnd);
+            inconsistent = uses_multiword(prec);
+        }
+        add_assumption_residuals(f, groups, x, prec, rnd);
+        if (column_assumptions > 0) {
+            // The simplifying assumption residuals are cheap, so their
+            // contribution to df is taken from their full gradient.
+            mpfr_t grad[NUM_VARS];
+            for (std::size_t i = 0; i < NUM_VARS; ++i) {
+                mpfr_init2(grad[i], prec);
+                mpfr_set_zero(grad[i], 0);
+            }
+            add_column_assumption_gradient(grad, x, column_assumptions,
+                                           prec, rnd);
+            for (std::size_t i = 0; i < NUM_VARS; ++i) {
+                mpfr_fma(df, grad[i], dx[i], df, rnd);
+                mpfr_clear(grad[i]);
+            }
+        }
+        if (inconsistent) {
+            // The multiword evaluation overflowed, possibly in a dual part
+            // only, in which case objective may still succeed in multiword
+            // arithmetic. Take f from it to keep the values the line
+            // searchers compare consistent.
+            objective(f, x, prec, rnd);
+        } else {
+            cache.store_objective(x, f, groups, prec, rnd);
+        }
+        clear_groups(groups);
+    }
+
+    // Evaluates the objective function with prec bits of precision in ball
+    // arithmetic, storing a rigorous bound on the error in f in f_rad and,
+    // unless res_rad is a null pointer, bounds on the errors in the residuals
+    // of the NUM_ORDER_CONDITIONS order conditions in res_rad. As with
+    // gradient, x is first rounded to prec bits if necessary. Returns false
+    // if simplifying assumptions are enforced, since their residuals are not
+    // evaluated in ball arithmetic.
+    bool objective_error_bound(mpfr_t f, mpfr_t f_rad, mpfr_t *res_rad,
+                               mpfr_t *x, mpfr_prec_t prec, mpfr_rnd_t rnd) {
+        if (column_assumptions > 0) { return false; }
+        if (mpfr_get_prec(x[0]) > prec) {
+            mpfr_t x_rounded[NUM_VARS];
+            for (std::size_t i = 0; i < NUM_VARS; ++i) {
+                mpfr_init2(x_rounded[i], prec);
+                mpfr_set(x_rounded[i], x[i], rnd);
+            }
+            objective_function_ball(f, f_rad, res_rad, x_rounded,
+                                    active_order_conditions(), prec, rnd);
+            for (std::size_t i = 0; i < NUM_VARS; ++i) {
+                mpfr_clear(x_rounded[i]);
+            }
+        } else {
+            objective_function_ball(f, f_rad, res_rad, x,
+                                    active_order_conditions(), prec, rnd);
+        }
+        return true;
+    }
+
+    // Evaluates the NUM_RESIDUALS residuals whose squares make up the
+    // objective function, together with their Jacobian (see
+    // objective_residual_jacobian). Returns false if simplifying assumptions
+    // are enforced, since the Jacobian of their residuals is not available.
+    bool residual_jacobian(mpfr_t *res, mpfr_t *jac, mpfr_t *x,
+                           mpfr_prec_t prec, mpfr_rnd_t rnd) {
+        if (column_assumptions > 0) { return false; }
+        objective_residual_jacobian(res, jac, x, active_order_conditions(),
+                                    prec, rnd);
+        return true;
+    }
+
+    // Retrieves the breakdown of the objective function at x into residual
+    // groups, as described for NUM_RESIDUAL_GROUPS, without evaluating
+    // anything. Returns false if the objective function at x has not been
+    // evaluated recently.
+    bool breakdown(mpfr_t *groups, mpfr_t *x,
+                   mpfr_prec_t prec, mpfr_rnd_t rnd) {
+        return cache.find_breakdown(groups, x, prec, rnd);
+    }
+
+    // Evaluates the gradient with all intermediate results rounded to prec
+    // bits. If prec is lower than the precision of x, the point is rounded
+    // to prec bits first, which yields an approximate gradient at a fraction
+    // of the cost of a full-precision one. The entries of dst keep their own
+    // precision.
+    void gradient(mpfr_t *dst, mpfr_t *x, mpfr_prec_t prec, mpfr_rnd_t rnd) {
+        if (cache.find_gradient(dst, x, prec, rnd)) { return; }
+        if (!reverse_mode && is_unmodified() &&
+            ((generated_gradient_prec == 0) ||
+             (generated_gradient_prec == prec))) {
+            // The machine-generated code allocates its workspace at the
+            // precision of its first call, so it can only be used again at
+            // that same precision.
+            generated_gradient_prec = prec;
+            objective_gradient(dst, x, prec, rnd);
+        } else if (mpfr_get_prec(x[0]) > prec) {
+            mpfr_t x_rounded[NUM_VARS];
+            for (std::size_t i = 0; i < NUM_VARS; ++i) {
+                mpfr_init2(x_rounded[i], prec);
+                mpfr_set(x_rounded[i], x[i], rnd);
+            }
+            subset_gradient(dst, x_rounded, prec, rnd);
+            for (std::size_t i = 0; i < NUM_VARS; ++i) {
+                mpfr_clear(x_rounded[i]);
+            }
+        } else {
+            subset_gradient(dst, x, prec, rnd);
+        }
+        cache.store_gradient(x, dst, prec, rnd);
+    }
+
+private: // ===================================================== HELPER METHODS
+
+    static void init_groups(mpfr_t *groups, mpfr_prec_t prec) {
+        for (std::size_t i = 0; i < NUM_RESIDUAL_GROUPS; ++i) {
+            mpfr_init2(groups[i], prec);
+        }
+    }
+
+    static void clear_groups(mpfr_t *groups) {
+        for (std::size_t i = 0; i < NUM_RESIDUAL_GROUPS; ++i) {
+            mpfr_clear(groups[i]);
+        }
+    }
+
+    // Adds the simplifying assumption residuals to f, recording their sum in
+    // the last residual group.
+    void add_assumption_residuals(mpfr_t f, mpfr_t *groups, mpfr_t *x,
+                                  mpfr_prec_t prec, mpfr_rnd_t rnd) {
+        mpfr_set_zero(groups[MAX_ORDER], 0);
+        add_column_assumption_residuals(
+                groups[MAX_ORDER], x, column_assumptions, prec, rnd);
+        mpfr_add(f, f, groups[MAX_ORDER], rnd);
+    }
+
+    void subset_gradient(mpfr_t *dst, mpfr_t *x,
+                         mpfr_prec_t prec, mpfr_rnd_t rnd) {
+        if (reverse_mode) {
+            objective_gradient_reverse(
+                    dst, x, active_order_conditions(),
+                    reverse_mode_stored_orders(tape_budget, prec), prec, rnd);
+        } else {
+            objective_gradient_subset(dst, x, active_order_conditions(),
+                                      prec, rnd);
+        }
+        add_column_assumption_gradient(dst, x, column_assumptions, prec, rnd);
+    }
+
+    // Returns true if the objective function at x should be evaluated by
+    // objective_function_double, which requires x to consist of doubles.
+    bool uses_double_precision(mpfr_t *x, mpfr_prec_t prec) const {
+        return compensated_double && (prec <= 53) &&
+               (mpfr_get_prec(x[0]) <= 53);
+    }
+
+    bool uses_multiword(mpfr_prec_t prec) const {
+        return multiword && (multiword_limb_count(prec) != 0);
+    }
+
+    bool is_unmodified() const {
+        return (max_order == MAX_ORDER) && (column_assumptions == 0);
+    }
+
+    const bool *active_order_conditions() const {
+        return is_unmodified() ? nullptr : active;
+    }
+
+    void update_active_order_conditions() {
+        for (std::size_t k = 0; k < NUM_ORDER_CONDITIONS; ++k) {
+            active[k] = (k < ORDER_CONDITION_OFFSETS[max_order - 1]) &&
+                        !implied_by_column_assumptions(k, column_assumptions);
+        }
+        cache.clear();
+    }
+
+};
+
+#endif // RKTK_OBJECTIVE_EVALUATOR_HPP_INCLUDED
@@ -3641,11 +3641,11 @@ void objective_function(mpfr_t f, mpfr_t *x, mpfr_prec_t p, mpfr_rnd_t r) {
 
 void objective_function_partial(mpfr_t f_du, mpfr_t *x, std::size_t i,
                                 mpfr_prec_t p, mpfr_rnd_t r) {
-    static mpfr_t *m_re = nullptr;
-    static mpfr_t *m_du = nullptr;
-    static mpfr_t *g = nullptr;
-    static mpfr_t tmp_re;
-    static mpfr_t tmp_du;
+    static thread_local mpfr_t *m_re = nullptr;
+    static thread_local mpfr_t *m_du = nullptr;
+    static thread_local mpfr_t *g = nullptr;
+    static thread_local mpfr_t tmp_re;
+    static thread_local mpfr_t tmp_du;
     if (m_re == nullptr) {
         m_re = new mpfr_t[14253];
         for (std::size_t j = 0; j < 14253; ++j) { mpfr_init2(m_re[j], p); }
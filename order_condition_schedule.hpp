@@ -0,0 +1,1310 @@
+#ifndef RKTK_ORDER_CONDITION_SCHEDULE_HPP_INCLUDED
+#define RKTK_ORDER_CONDITION_SCHEDULE_HPP_INCLUDED
+
+// C++ standard library headers
+#include <cstddef> // for std::size_t
+
+/*
+ * The order-condition schedule is a table-driven description of the
+ * computation performed by the machine-generated code in
+ * objective_function.hpp. Each entry produces one intermediate vector in
+ * the shared workspace m, and each intermediate vector corresponds to
+ * exactly one rooted tree (order condition), whose residual is
+ *
+ *     dot(m + dst, x + (NUM_VARS - size)) - 1 / gamma.
+ *
+ * Entries are listed in the same order as the generated code, which groups
+ * trees by increasing order. Consequently, the order conditions of order
+ * at most k occupy the index range [0, ORDER_CONDITION_OFFSETS[k - 1]), and
+ * the workspace entries they depend on form a prefix of m.
+ *
+ * The opcodes correspond to the helper subroutines of the same names in
+ * OrderConditionHelpers.hpp:
+ *
+ *     LRS - dst = row sums of the Runge-Kutta matrix (no operands)
+ *     LVM - dst = lower-triangular matrix-vector product with m + lhs
+ *     ESQ - dst = elementwise square of m + lhs
+ *     ELM - dst = elementwise product of m + lhs and m + rhs
+ *
+ * Unused operand fields are set to zero.
+ */
+
+#define NUM_STAGES 16
+#define NUM_ORDER_CONDITIONS 1204
+#define SCHEDULE_WORKSPACE_SIZE 14253
+#define MAX_ORDER 10
+
+// For reporting, the objective function is split into NUM_RESIDUAL_GROUPS
+// partial sums of squared residuals: group k - 1 holds the order conditions
+// of order k (group 0 being the order-one condition), and group MAX_ORDER
+// holds the residuals of any enforced simplifying assumptions.
+#define NUM_RESIDUAL_GROUPS (MAX_ORDER + 1)
+
+enum class ScheduleOp {
+    LRS, LVM, ESQ, ELM
+};
+
+struct ScheduleEntry {
+    ScheduleOp op;
+    std::size_t dst;
+    std::size_t size;
+    std::size_t lhs;
+    std::size_t rhs;
+    unsigned long gamma;
+};
+
+// ORDER_CONDITION_OFFSETS[k - 1] is the index of the first order condition
+// of order k + 1 (equivalently, the number of order conditions of order at
+// most k) for k = 1, ..., MAX_ORDER.
+static const std::size_t ORDER_CONDITION_OFFSETS[MAX_ORDER] = {
+        0, 1, 3, 7, 16, 36, 84, 199, 485, 1204
+};
+
+static inline std::size_t order_condition_order(std::size_t index) {
+    std::size_t order = 2;
+    while (ORDER_CONDITION_OFFSETS[order - 1] <= index) { ++order; }
+    return order;
+}
+
+static const ScheduleEntry ORDER_CONDITION_SCHEDULE[NUM_ORDER_CONDITIONS] = {
+    // order 2
+    {ScheduleOp::LRS, 0, 15, 0, 0, 2},
+
+    // order 3
+    {ScheduleOp::LVM, 15, 14, 0, 0, 6},
+    {ScheduleOp::ESQ, 29, 15, 0, 0, 3},
+
+    // order 4
+    {ScheduleOp::LVM, 44, 13, 15, 0, 24},
+    {ScheduleOp::LVM, 57, 14, 29, 0, 12},
+    {ScheduleOp::ELM, 71, 14, 1, 15, 8},
+    {ScheduleOp::ELM, 85, 15, 0, 29, 4},
+
+    // order 5
+    {ScheduleOp::LVM, 100, 12, 44, 0, 120},
+    {ScheduleOp::LVM, 112, 13, 57, 0, 60},
+    {ScheduleOp::LVM, 125, 13, 71, 0, 40},
+    {ScheduleOp::LVM, 138, 14, 85, 0, 20},
+    {ScheduleOp::ELM, 152, 13, 2, 44, 30},
+    {ScheduleOp::ELM, 165, 14, 1, 57, 15},
+    {ScheduleOp::ESQ, 179, 14, 15, 0, 20},
+    {ScheduleOp::ELM, 193, 14, 30, 15, 10},
+    {ScheduleOp::ELM, 207, 15, 0, 85, 5},
+
+    // order 6
+    {ScheduleOp::LVM, 222, 11, 100, 0, 720},
+    {ScheduleOp::LVM, 233, 12, 112, 0, 360},
+    {ScheduleOp::LVM, 245, 12, 125, 0, 240},
+    {ScheduleOp::LVM, 257, 13, 138, 0, 120},
+    {ScheduleOp::LVM, 270, 12, 152, 0, 180},
+    {ScheduleOp::LVM, 282, 13, 165, 0, 90},
+    {ScheduleOp::LVM, 295, 13, 179, 0, 120},
+    {ScheduleOp::LVM, 308, 13, 193, 0, 60},
+    {ScheduleOp::LVM, 321, 14, 207, 0, 30},
+    {ScheduleOp::ELM, 335, 12, 3, 100, 144},
+    {ScheduleOp::ELM, 347, 13, 2, 112, 72},
+    {ScheduleOp::ELM, 360, 13, 2, 125, 48},
+    {ScheduleOp::ELM, 373, 14, 1, 138, 24},
+    {ScheduleOp::ELM, 387, 13, 16, 44, 72},
+    {ScheduleOp::ELM, 400, 14, 15, 57, 36},
+    {ScheduleOp::ELM, 414, 13, 31, 44, 36},
+    {ScheduleOp::ELM, 427, 14, 30, 57, 18},
+    {ScheduleOp::ELM, 441, 14, 1, 179, 24},
+    {ScheduleOp::ELM, 455, 14, 86, 15, 12},
+    {ScheduleOp::ELM, 469, 15, 0, 207, 6},
+
+    // order 7
+    {ScheduleOp::LVM, 484, 10, 222, 0, 5040},
+    {ScheduleOp::LVM, 494, 11, 233, 0, 2520},
+    {ScheduleOp::LVM, 505, 11, 245, 0, 1680},
+    {ScheduleOp::LVM, 516, 12, 257, 0, 840},
+    {ScheduleOp::LVM, 528, 11, 270, 0, 1260},
+    {ScheduleOp::LVM, 539, 12, 282, 0, 630},
+    {ScheduleOp::LVM, 551, 12, 295, 0, 840},
+    {ScheduleOp::LVM, 563, 12, 308, 0, 420},
+    {ScheduleOp::LVM, 575, 13, 321, 0, 210},
+    {ScheduleOp::LVM, 588, 11, 335, 0, 1008},
+    {ScheduleOp::LVM, 599, 12, 347, 0, 504},
+    {ScheduleOp::LVM, 611, 12, 360, 0, 336},
+    {ScheduleOp::LVM, 623, 13, 373, 0, 168},
+    {ScheduleOp::LVM, 636, 12, 387, 0, 504},
+    {ScheduleOp::LVM, 648, 13, 400, 0, 252},
+    {ScheduleOp::LVM, 661, 12, 414, 0, 252},
+    {ScheduleOp::LVM, 673, 13, 427, 0, 126},
+    {ScheduleOp::LVM, 686, 13, 441, 0, 168},
+    {ScheduleOp::LVM, 699, 13, 455, 0, 84},
+    {ScheduleOp::LVM, 712, 14, 469, 0, 42},
+    {ScheduleOp::ELM, 726, 11, 4, 222, 840},
+    {ScheduleOp::ELM, 737, 12, 3, 233, 420},
+    {ScheduleOp::ELM, 749, 12, 3, 245, 280},
+    {ScheduleOp::ELM, 761, 13, 2, 257, 140},
+    {ScheduleOp::ELM, 774, 12, 3, 270, 210},
+    {ScheduleOp::ELM, 786, 13, 2, 282, 105},
+    {ScheduleOp::ELM, 799, 13, 2, 295, 140},
+    {ScheduleOp::ELM, 812, 13, 2, 308, 70},
+    {ScheduleOp::ELM, 825, 14, 1, 321, 35},
+    {ScheduleOp::ELM, 839, 12, 17, 100, 336},
+    {ScheduleOp::ELM, 851, 13, 16, 112, 168},
+    {ScheduleOp::ELM, 864, 13, 16, 125, 112},
+    {ScheduleOp::ELM, 877, 14, 15, 138, 56},
+    {ScheduleOp::ELM, 891, 12, 32, 100, 168},
+    {ScheduleOp::ELM, 903, 13, 31, 112, 84},
+    {ScheduleOp::ELM, 916, 13, 31, 125, 56},
+    {ScheduleOp::ELM, 929, 14, 30, 138, 28},
+    {ScheduleOp::ESQ, 943, 13, 44, 0, 252},
+    {ScheduleOp::ESQ, 956, 14, 57, 0, 63},
+    {ScheduleOp::ELM, 970, 13, 58, 44, 126},
+    {ScheduleOp::ELM, 983, 13, 2, 387, 84},
+    {ScheduleOp::ELM, 996, 14, 1, 400, 42},
+    {ScheduleOp::ELM, 1010, 13, 87, 44, 42},
+    {ScheduleOp::ELM, 1023, 14, 86, 57, 21},
+    {ScheduleOp::ELM, 1037, 14, 15, 179, 56},
+    {ScheduleOp::ELM, 1051, 14, 30, 179, 28},
+    {ScheduleOp::ELM, 1065, 14, 208, 15, 14},
+    {ScheduleOp::ELM, 1079, 15, 0, 469, 7},
+
+    // order 8
+    {ScheduleOp::LVM, 1094, 9, 484, 0, 40320},
+    {ScheduleOp::LVM, 1103, 10, 494, 0, 20160},
+    {ScheduleOp::LVM, 1113, 10, 505, 0, 13440},
+    {ScheduleOp::LVM, 1123, 11, 516, 0, 6720},
+    {ScheduleOp::LVM, 1134, 10, 528, 0, 10080},
+    {ScheduleOp::LVM, 1144, 11, 539, 0, 5040},
+    {ScheduleOp::LVM, 1155, 11, 551, 0, 6720},
+    {ScheduleOp::LVM, 1166, 11, 563, 0, 3360},
+    {ScheduleOp::LVM, 1177, 12, 575, 0, 1680},
+    {ScheduleOp::LVM, 1189, 10, 588, 0, 8064},
+    {ScheduleOp::LVM, 1199, 11, 599, 0, 4032},
+    {ScheduleOp::LVM, 1210, 11, 611, 0, 2688},
+    {ScheduleOp::LVM, 1221, 12, 623, 0, 1344},
+    {ScheduleOp::LVM, 1233, 11, 636, 0, 4032},
+    {ScheduleOp::LVM, 1244, 12, 648, 0, 2016},
+    {ScheduleOp::LVM, 1256, 11, 661, 0, 2016},
+    {ScheduleOp::LVM, 1267, 12, 673, 0, 1008},
+    {ScheduleOp::LVM, 1279, 12, 686, 0, 1344},
+    {ScheduleOp::LVM, 1291, 12, 699, 0, 672},
+    {ScheduleOp::LVM, 1303, 13, 712, 0, 336},
+    {ScheduleOp::LVM, 1316, 10, 726, 0, 6720},
+    {ScheduleOp::LVM, 1326, 11, 737, 0, 3360},
+    {ScheduleOp::LVM, 1337, 11, 749, 0, 2240},
+    {ScheduleOp::LVM, 1348, 12, 761, 0, 1120},
+    {ScheduleOp::LVM, 1360, 11, 774, 0, 1680},
+    {ScheduleOp::LVM, 1371, 12, 786, 0, 840},
+    {ScheduleOp::LVM, 1383, 12, 799, 0, 1120},
+    {ScheduleOp::LVM, 1395, 12, 812, 0, 560},
+    {ScheduleOp::LVM, 1407, 13, 825, 0, 280},
+    {ScheduleOp::LVM, 1420, 11, 839, 0, 2688},
+    {ScheduleOp::LVM, 1431, 12, 851, 0, 1344},
+    {ScheduleOp::LVM, 1443, 12, 864, 0, 896},
+    {ScheduleOp::LVM, 1455, 13, 877, 0, 448},
+    {ScheduleOp::LVM, 1468, 11, 891, 0, 1344},
+    {ScheduleOp::LVM, 1479, 12, 903, 0, 672},
+    {ScheduleOp::LVM, 1491, 12, 916, 0, 448},
+    {ScheduleOp::LVM, 1503, 13, 929, 0, 224},
+    {ScheduleOp::LVM, 1516, 12, 943, 0, 2016},
+    {ScheduleOp::LVM, 1528, 13, 956, 0, 504},
+    {ScheduleOp::LVM, 1541, 12, 970, 0, 1008},
+    {ScheduleOp::LVM, 1553, 12, 983, 0, 672},
+    {ScheduleOp::LVM, 1565, 13, 996, 0, 336},
+    {ScheduleOp::LVM, 1578, 12, 1010, 0, 336},
+    {ScheduleOp::LVM, 1590, 13, 1023, 0, 168},
+    {ScheduleOp::LVM, 1603, 13, 1037, 0, 448},
+    {ScheduleOp::LVM, 1616, 13, 1051, 0, 224},
+    {ScheduleOp::LVM, 1629, 13, 1065, 0, 112},
+    {ScheduleOp::LVM, 1642, 14, 1079, 0, 56},
+    {ScheduleOp::ELM, 1656, 10, 5, 484, 5760},
+    {ScheduleOp::ELM, 1666, 11, 4, 494, 2880},
+    {ScheduleOp::ELM, 1677, 11, 4, 505, 1920},
+    {ScheduleOp::ELM, 1688, 12, 3, 516, 960},
+    {ScheduleOp::ELM, 1700, 11, 4, 528, 1440},
+    {ScheduleOp::ELM, 1711, 12, 3, 539, 720},
+    {ScheduleOp::ELM, 1723, 12, 3, 551, 960},
+    {ScheduleOp::ELM, 1735, 12, 3, 563, 480},
+    {ScheduleOp::ELM, 1747, 13, 2, 575, 240},
+    {ScheduleOp::ELM, 1760, 11, 4, 588, 1152},
+    {ScheduleOp::ELM, 1771, 12, 3, 599, 576},
+    {ScheduleOp::ELM, 1783, 12, 3, 611, 384},
+    {ScheduleOp::ELM, 1795, 13, 2, 623, 192},
+    {ScheduleOp::ELM, 1808, 12, 3, 636, 576},
+    {ScheduleOp::ELM, 1820, 13, 2, 648, 288},
+    {ScheduleOp::ELM, 1833, 12, 3, 661, 288},
+    {ScheduleOp::ELM, 1845, 13, 2, 673, 144},
+    {ScheduleOp::ELM, 1858, 13, 2, 686, 192},
+    {ScheduleOp::ELM, 1871, 13, 2, 699, 96},
+    {ScheduleOp::ELM, 1884, 14, 1, 712, 48},
+    {ScheduleOp::ELM, 1898, 11, 18, 222, 1920},
+    {ScheduleOp::ELM, 1909, 12, 17, 233, 960},
+    {ScheduleOp::ELM, 1921, 12, 17, 245, 640},
+    {ScheduleOp::ELM, 1933, 13, 16, 257, 320},
+    {ScheduleOp::ELM, 1946, 12, 17, 270, 480},
+    {ScheduleOp::ELM, 1958, 13, 16, 282, 240},
+    {ScheduleOp::ELM, 1971, 13, 16, 295, 320},
+    {ScheduleOp::ELM, 1984, 13, 16, 308, 160},
+    {ScheduleOp::ELM, 1997, 14, 15, 321, 80},
+    {ScheduleOp::ELM, 2011, 11, 33, 222, 960},
+    {ScheduleOp::ELM, 2022, 12, 32, 233, 480},
+    {ScheduleOp::ELM, 2034, 12, 32, 245, 320},
+    {ScheduleOp::ELM, 2046, 13, 31, 257, 160},
+    {ScheduleOp::ELM, 2059, 12, 32, 270, 240},
+    {ScheduleOp::ELM, 2071, 13, 31, 282, 120},
+    {ScheduleOp::ELM, 2084, 13, 31, 295, 160},
+    {ScheduleOp::ELM, 2097, 13, 31, 308, 80},
+    {ScheduleOp::ELM, 2110, 14, 30, 321, 40},
+    {ScheduleOp::ELM, 2124, 12, 45, 100, 1152},
+    {ScheduleOp::ELM, 2136, 12, 59, 100, 576},
+    {ScheduleOp::ELM, 2148, 13, 44, 112, 576},
+    {ScheduleOp::ELM, 2161, 13, 58, 112, 288},
+    {ScheduleOp::ELM, 2174, 13, 125, 44, 384},
+    {ScheduleOp::ELM, 2187, 13, 58, 125, 192},
+    {ScheduleOp::ELM, 2200, 13, 139, 44, 192},
+    {ScheduleOp::ELM, 2213, 14, 57, 138, 96},
+    {ScheduleOp::ELM, 2227, 12, 3, 839, 384},
+    {ScheduleOp::ELM, 2239, 13, 2, 851, 192},
+    {ScheduleOp::ELM, 2252, 13, 2, 864, 128},
+    {ScheduleOp::ELM, 2265, 14, 1, 877, 64},
+    {ScheduleOp::ELM, 2279, 12, 88, 100, 192},
+    {ScheduleOp::ELM, 2291, 13, 87, 112, 96},
+    {ScheduleOp::ELM, 2304, 13, 87, 125, 64},
+    {ScheduleOp::ELM, 2317, 14, 86, 138, 32},
+    {ScheduleOp::ELM, 2331, 13, 2, 943, 288},
+    {ScheduleOp::ELM, 2344, 14, 1, 956, 72},
+    {ScheduleOp::ELM, 2358, 13, 2, 970, 144},
+    {ScheduleOp::ELM, 2371, 13, 180, 44, 192},
+    {ScheduleOp::ELM, 2384, 14, 179, 57, 96},
+    {ScheduleOp::ELM, 2398, 13, 31, 387, 96},
+    {ScheduleOp::ELM, 2411, 14, 30, 400, 48},
+    {ScheduleOp::ELM, 2425, 13, 209, 44, 48},
+    {ScheduleOp::ELM, 2438, 14, 208, 57, 24},
+    {ScheduleOp::ELM, 2452, 14, 1, 1037, 64},
+    {ScheduleOp::ELM, 2466, 14, 86, 179, 32},
+    {ScheduleOp::ELM, 2480, 14, 470, 15, 16},
+    {ScheduleOp::ELM, 2494, 15, 0, 1079, 8},
+
+    // order 9
+    {ScheduleOp::LVM, 2509, 8, 1094, 0, 362880},
+    {ScheduleOp::LVM, 2517, 9, 1103, 0, 181440},
+    {ScheduleOp::LVM, 2526, 9, 1113, 0, 120960},
+    {ScheduleOp::LVM, 2535, 10, 1123, 0, 60480},
+    {ScheduleOp::LVM, 2545, 9, 1134, 0, 90720},
+    {ScheduleOp::LVM, 2554, 10, 1144, 0, 45360},
+    {ScheduleOp::LVM, 2564, 10, 1155, 0, 60480},
+    {ScheduleOp::LVM, 2574, 10, 1166, 0, 30240},
+    {ScheduleOp::LVM, 2584, 11, 1177, 0, 15120},
+    {ScheduleOp::LVM, 2595, 9, 1189, 0, 72576},
+    {ScheduleOp::LVM, 2604, 10, 1199, 0, 36288},
+    {ScheduleOp::LVM, 2614, 10, 1210, 0, 24192},
+    {ScheduleOp::LVM, 2624, 11, 1221, 0, 12096},
+    {ScheduleOp::LVM, 2635, 10, 1233, 0, 36288},
+    {ScheduleOp::LVM, 2645, 11, 1244, 0, 18144},
+    {ScheduleOp::LVM, 2656, 10, 1256, 0, 18144},
+    {ScheduleOp::LVM, 2666, 11, 1267, 0, 9072},
+    {ScheduleOp::LVM, 2677, 11, 1279, 0, 12096},
+    {ScheduleOp::LVM, 2688, 11, 1291, 0, 6048},
+    {ScheduleOp::LVM, 2699, 12, 1303, 0, 3024},
+    {ScheduleOp::LVM, 2711, 9, 1316, 0, 60480},
+    {ScheduleOp::LVM, 2720, 10, 1326, 0, 30240},
+    {ScheduleOp::LVM, 2730, 10, 1337, 0, 20160},
+    {ScheduleOp::LVM, 2740, 11, 1348, 0, 10080},
+    {ScheduleOp::LVM, 2751, 10, 1360, 0, 15120},
+    {ScheduleOp::LVM, 2761, 11, 1371, 0, 7560},
+    {ScheduleOp::LVM, 2772, 11, 1383, 0, 10080},
+    {ScheduleOp::LVM, 2783, 11, 1395, 0, 5040},
+    {ScheduleOp::LVM, 2794, 12, 1407, 0, 2520},
+    {ScheduleOp::LVM, 2806, 10, 1420, 0, 24192},
+    {ScheduleOp::LVM, 2816, 11, 1431, 0, 12096},
+    {ScheduleOp::LVM, 2827, 11, 1443, 0, 8064},
+    {ScheduleOp::LVM, 2838, 12, 1455, 0, 4032},
+    {ScheduleOp::LVM, 2850, 10, 1468, 0, 12096},
+    {ScheduleOp::LVM, 2860, 11, 1479, 0, 6048},
+    {ScheduleOp::LVM, 2871, 11, 1491, 0, 4032},
+    {ScheduleOp::LVM, 2882, 12, 1503, 0, 2016},
+    {ScheduleOp::LVM, 2894, 11, 1516, 0, 18144},
+    {ScheduleOp::LVM, 2905, 12, 1528, 0, 4536},
+    {ScheduleOp::LVM, 2917, 11, 1541, 0, 9072},
+    {ScheduleOp::LVM, 2928, 11, 1553, 0, 6048},
+    {ScheduleOp::LVM, 2939, 12, 1565, 0, 3024},
+    {ScheduleOp::LVM, 2951, 11, 1578, 0, 3024},
+    {ScheduleOp::LVM, 2962, 12, 1590, 0, 1512},
+    {ScheduleOp::LVM, 2974, 12, 1603, 0, 4032},
+    {ScheduleOp::LVM, 2986, 12, 1616, 0, 2016},
+    {ScheduleOp::LVM, 2998, 12, 1629, 0, 1008},
+    {ScheduleOp::LVM, 3010, 13, 1642, 0, 504},
+    {ScheduleOp::LVM, 3023, 9, 1656, 0, 51840},
+    {ScheduleOp::LVM, 3032, 10, 1666, 0, 25920},
+    {ScheduleOp::LVM, 3042, 10, 1677, 0, 17280},
+    {ScheduleOp::LVM, 3052, 11, 1688, 0, 8640},
+    {ScheduleOp::LVM, 3063, 10, 1700, 0, 12960},
+    {ScheduleOp::LVM, 3073, 11, 1711, 0, 6480},
+    {ScheduleOp::LVM, 3084, 11, 1723, 0, 8640},
+    {ScheduleOp::LVM, 3095, 11, 1735, 0, 4320},
+    {ScheduleOp::LVM, 3106, 12, 1747, 0, 2160},
+    {ScheduleOp::LVM, 3118, 10, 1760, 0, 10368},
+    {ScheduleOp::LVM, 3128, 11, 1771, 0, 5184},
+    {ScheduleOp::LVM, 3139, 11, 1783, 0, 3456},
+    {ScheduleOp::LVM, 3150, 12, 1795, 0, 1728},
+    {ScheduleOp::LVM, 3162, 11, 1808, 0, 5184},
+    {ScheduleOp::LVM, 3173, 12, 1820, 0, 2592},
+    {ScheduleOp::LVM, 3185, 11, 1833, 0, 2592},
+    {ScheduleOp::LVM, 3196, 12, 1845, 0, 1296},
+    {ScheduleOp::LVM, 3208, 12, 1858, 0, 1728},
+    {ScheduleOp::LVM, 3220, 12, 1871, 0, 864},
+    {ScheduleOp::LVM, 3232, 13, 1884, 0, 432},
+    {ScheduleOp::LVM, 3245, 10, 1898, 0, 17280},
+    {ScheduleOp::LVM, 3255, 11, 1909, 0, 8640},
+    {ScheduleOp::LVM, 3266, 11, 1921, 0, 5760},
+    {ScheduleOp::LVM, 3277, 12, 1933, 0, 2880},
+    {ScheduleOp::LVM, 3289, 11, 1946, 0, 4320},
+    {ScheduleOp::LVM, 3300, 12, 1958, 0, 2160},
+    {ScheduleOp::LVM, 3312, 12, 1971, 0, 2880},
+    {ScheduleOp::LVM, 3324, 12, 1984, 0, 1440},
+    {ScheduleOp::LVM, 3336, 13, 1997, 0, 720},
+    {ScheduleOp::LVM, 3349, 10, 2011, 0, 8640},
+    {ScheduleOp::LVM, 3359, 11, 2022, 0, 4320},
+    {ScheduleOp::LVM, 3370, 11, 2034, 0, 2880},
+    {ScheduleOp::LVM, 3381, 12, 2046, 0, 1440},
+    {ScheduleOp::LVM, 3393, 11, 2059, 0, 2160},
+    {ScheduleOp::LVM, 3404, 12, 2071, 0, 1080},
+    {ScheduleOp::LVM, 3416, 12, 2084, 0, 1440},
+    {ScheduleOp::LVM, 3428, 12, 2097, 0, 720},
+    {ScheduleOp::LVM, 3440, 13, 2110, 0, 360},
+    {ScheduleOp::LVM, 3453, 11, 2124, 0, 10368},
+    {ScheduleOp::LVM, 3464, 11, 2136, 0, 5184},
+    {ScheduleOp::LVM, 3475, 12, 2148, 0, 5184},
+    {ScheduleOp::LVM, 3487, 12, 2161, 0, 2592},
+    {ScheduleOp::LVM, 3499, 12, 2174, 0, 3456},
+    {ScheduleOp::LVM, 3511, 12, 2187, 0, 1728},
+    {ScheduleOp::LVM, 3523, 12, 2200, 0, 1728},
+    {ScheduleOp::LVM, 3535, 13, 2213, 0, 864},
+    {ScheduleOp::LVM, 3548, 11, 2227, 0, 3456},
+    {ScheduleOp::LVM, 3559, 12, 2239, 0, 1728},
+    {ScheduleOp::LVM, 3571, 12, 2252, 0, 1152},
+    {ScheduleOp::LVM, 3583, 13, 2265, 0, 576},
+    {ScheduleOp::LVM, 3596, 11, 2279, 0, 1728},
+    {ScheduleOp::LVM, 3607, 12, 2291, 0, 864},
+    {ScheduleOp::LVM, 3619, 12, 2304, 0, 576},
+    {ScheduleOp::LVM, 3631, 13, 2317, 0, 288},
+    {ScheduleOp::LVM, 3644, 12, 2331, 0, 2592},
+    {ScheduleOp::LVM, 3656, 13, 2344, 0, 648},
+    {ScheduleOp::LVM, 3669, 12, 2358, 0, 1296},
+    {ScheduleOp::LVM, 3681, 12, 2371, 0, 1728},
+    {ScheduleOp::LVM, 3693, 13, 2384, 0, 864},
+    {ScheduleOp::LVM, 3706, 12, 2398, 0, 864},
+    {ScheduleOp::LVM, 3718, 13, 2411, 0, 432},
+    {ScheduleOp::LVM, 3731, 12, 2425, 0, 432},
+    {ScheduleOp::LVM, 3743, 13, 2438, 0, 216},
+    {ScheduleOp::LVM, 3756, 13, 2452, 0, 576},
+    {ScheduleOp::LVM, 3769, 13, 2466, 0, 288},
+    {ScheduleOp::LVM, 3782, 13, 2480, 0, 144},
+    {ScheduleOp::LVM, 3795, 14, 2494, 0, 72},
+    {ScheduleOp::ELM, 3809, 9, 6, 1094, 45360},
+    {ScheduleOp::ELM, 3818, 10, 5, 1103, 22680},
+    {ScheduleOp::ELM, 3828, 10, 5, 1113, 15120},
+    {ScheduleOp::ELM, 3838, 11, 4, 1123, 7560},
+    {ScheduleOp::ELM, 3849, 10, 5, 1134, 11340},
+    {ScheduleOp::ELM, 3859, 11, 4, 1144, 5670},
+    {ScheduleOp::ELM, 3870, 11, 4, 1155, 7560},
+    {ScheduleOp::ELM, 3881, 11, 4, 1166, 3780},
+    {ScheduleOp::ELM, 3892, 12, 3, 1177, 1890},
+    {ScheduleOp::ELM, 3904, 10, 5, 1189, 9072},
+    {ScheduleOp::ELM, 3914, 11, 4, 1199, 4536},
+    {ScheduleOp::ELM, 3925, 11, 4, 1210, 3024},
+    {ScheduleOp::ELM, 3936, 12, 3, 1221, 1512},
+    {ScheduleOp::ELM, 3948, 11, 4, 1233, 4536},
+    {ScheduleOp::ELM, 3959, 12, 3, 1244, 2268},
+    {ScheduleOp::ELM, 3971, 11, 4, 1256, 2268},
+    {ScheduleOp::ELM, 3982, 12, 3, 1267, 1134},
+    {ScheduleOp::ELM, 3994, 12, 3, 1279, 1512},
+    {ScheduleOp::ELM, 4006, 12, 3, 1291, 756},
+    {ScheduleOp::ELM, 4018, 13, 2, 1303, 378},
+    {ScheduleOp::ELM, 4031, 10, 5, 1316, 7560},
+    {ScheduleOp::ELM, 4041, 11, 4, 1326, 3780},
+    {ScheduleOp::ELM, 4052, 11, 4, 1337, 2520},
+    {ScheduleOp::ELM, 4063, 12, 3, 1348, 1260},
+    {ScheduleOp::ELM, 4075, 11, 4, 1360, 1890},
+    {ScheduleOp::ELM, 4086, 12, 3, 1371, 945},
+    {ScheduleOp::ELM, 4098, 12, 3, 1383, 1260},
+    {ScheduleOp::ELM, 4110, 12, 3, 1395, 630},
+    {ScheduleOp::ELM, 4122, 13, 2, 1407, 315},
+    {ScheduleOp::ELM, 4135, 11, 4, 1420, 3024},
+    {ScheduleOp::ELM, 4146, 12, 3, 1431, 1512},
+    {ScheduleOp::ELM, 4158, 12, 3, 1443, 1008},
+    {ScheduleOp::ELM, 4170, 13, 2, 1455, 504},
+    {ScheduleOp::ELM, 4183, 11, 4, 1468, 1512},
+    {ScheduleOp::ELM, 4194, 12, 3, 1479, 756},
+    {ScheduleOp::ELM, 4206, 12, 3, 1491, 504},
+    {ScheduleOp::ELM, 4218, 13, 2, 1503, 252},
+    {ScheduleOp::ELM, 4231, 12, 3, 1516, 2268},
+    {ScheduleOp::ELM, 4243, 13, 2, 1528, 567},
+    {ScheduleOp::ELM, 4256, 12, 3, 1541, 1134},
+    {ScheduleOp::ELM, 4268, 12, 3, 1553, 756},
+    {ScheduleOp::ELM, 4280, 13, 2, 1565, 378},
+    {ScheduleOp::ELM, 4293, 12, 3, 1578, 378},
+    {ScheduleOp::ELM, 4305, 13, 2, 1590, 189},
+    {ScheduleOp::ELM, 4318, 13, 2, 1603, 504},
+    {ScheduleOp::ELM, 4331, 13, 2, 1616, 252},
+    {ScheduleOp::ELM, 4344, 13, 2, 1629, 126},
+    {ScheduleOp::ELM, 4357, 14, 1, 1642, 63},
+    {ScheduleOp::ELM, 4371, 10, 19, 484, 12960},
+    {ScheduleOp::ELM, 4381, 11, 18, 494, 6480},
+    {ScheduleOp::ELM, 4392, 11, 18, 505, 4320},
+    {ScheduleOp::ELM, 4403, 12, 17, 516, 2160},
+    {ScheduleOp::ELM, 4415, 11, 18, 528, 3240},
+    {ScheduleOp::ELM, 4426, 12, 17, 539, 1620},
+    {ScheduleOp::ELM, 4438, 12, 17, 551, 2160},
+    {ScheduleOp::ELM, 4450, 12, 17, 563, 1080},
+    {ScheduleOp::ELM, 4462, 13, 16, 575, 540},
+    {ScheduleOp::ELM, 4475, 11, 18, 588, 2592},
+    {ScheduleOp::ELM, 4486, 12, 17, 599, 1296},
+    {ScheduleOp::ELM, 4498, 12, 17, 611, 864},
+    {ScheduleOp::ELM, 4510, 13, 16, 623, 432},
+    {ScheduleOp::ELM, 4523, 12, 17, 636, 1296},
+    {ScheduleOp::ELM, 4535, 13, 16, 648, 648},
+    {ScheduleOp::ELM, 4548, 12, 17, 661, 648},
+    {ScheduleOp::ELM, 4560, 13, 16, 673, 324},
+    {ScheduleOp::ELM, 4573, 13, 16, 686, 432},
+    {ScheduleOp::ELM, 4586, 13, 16, 699, 216},
+    {ScheduleOp::ELM, 4599, 14, 15, 712, 108},
+    {ScheduleOp::ELM, 4613, 10, 34, 484, 6480},
+    {ScheduleOp::ELM, 4623, 11, 33, 494, 3240},
+    {ScheduleOp::ELM, 4634, 11, 33, 505, 2160},
+    {ScheduleOp::ELM, 4645, 12, 32, 516, 1080},
+    {ScheduleOp::ELM, 4657, 11, 33, 528, 1620},
+    {ScheduleOp::ELM, 4668, 12, 32, 539, 810},
+    {ScheduleOp::ELM, 4680, 12, 32, 551, 1080},
+    {ScheduleOp::ELM, 4692, 12, 32, 563, 540},
+    {ScheduleOp::ELM, 4704, 13, 31, 575, 270},
+    {ScheduleOp::ELM, 4717, 11, 33, 588, 1296},
+    {ScheduleOp::ELM, 4728, 12, 32, 599, 648},
+    {ScheduleOp::ELM, 4740, 12, 32, 611, 432},
+    {ScheduleOp::ELM, 4752, 13, 31, 623, 216},
+    {ScheduleOp::ELM, 4765, 12, 32, 636, 648},
+    {ScheduleOp::ELM, 4777, 13, 31, 648, 324},
+    {ScheduleOp::ELM, 4790, 12, 32, 661, 324},
+    {ScheduleOp::ELM, 4802, 13, 31, 673, 162},
+    {ScheduleOp::ELM, 4815, 13, 31, 686, 216},
+    {ScheduleOp::ELM, 4828, 13, 31, 699, 108},
+    {ScheduleOp::ELM, 4841, 14, 30, 712, 54},
+    {ScheduleOp::ELM, 4855, 11, 46, 222, 6480},
+    {ScheduleOp::ELM, 4866, 11, 60, 222, 3240},
+    {ScheduleOp::ELM, 4877, 12, 45, 233, 3240},
+    {ScheduleOp::ELM, 4889, 12, 59, 233, 1620},
+    {ScheduleOp::ELM, 4901, 12, 45, 245, 2160},
+    {ScheduleOp::ELM, 4913, 12, 59, 245, 1080},
+    {ScheduleOp::ELM, 4925, 13, 44, 257, 1080},
+    {ScheduleOp::ELM, 4938, 13, 58, 257, 540},
+    {ScheduleOp::ELM, 4951, 12, 270, 45, 1620},
+    {ScheduleOp::ELM, 4963, 12, 59, 270, 810},
+    {ScheduleOp::ELM, 4975, 13, 282, 44, 810},
+    {ScheduleOp::ELM, 4988, 13, 58, 282, 405},
+    {ScheduleOp::ELM, 5001, 13, 295, 44, 1080},
+    {ScheduleOp::ELM, 5014, 13, 58, 295, 540},
+    {ScheduleOp::ELM, 5027, 13, 308, 44, 540},
+    {ScheduleOp::ELM, 5040, 13, 58, 308, 270},
+    {ScheduleOp::ELM, 5053, 13, 322, 44, 270},
+    {ScheduleOp::ELM, 5066, 14, 57, 321, 135},
+    {ScheduleOp::ELM, 5080, 11, 4, 1898, 2160},
+    {ScheduleOp::ELM, 5091, 12, 3, 1909, 1080},
+    {ScheduleOp::ELM, 5103, 12, 3, 1921, 720},
+    {ScheduleOp::ELM, 5115, 13, 2, 1933, 360},
+    {ScheduleOp::ELM, 5128, 12, 3, 1946, 540},
+    {ScheduleOp::ELM, 5140, 13, 2, 1958, 270},
+    {ScheduleOp::ELM, 5153, 13, 2, 1971, 360},
+    {ScheduleOp::ELM, 5166, 13, 2, 1984, 180},
+    {ScheduleOp::ELM, 5179, 14, 1, 1997, 90},
+    {ScheduleOp::ELM, 5193, 11, 89, 222, 1080},
+    {ScheduleOp::ELM, 5204, 12, 88, 233, 540},
+    {ScheduleOp::ELM, 5216, 12, 88, 245, 360},
+    {ScheduleOp::ELM, 5228, 13, 87, 257, 180},
+    {ScheduleOp::ELM, 5241, 12, 88, 270, 270},
+    {ScheduleOp::ELM, 5253, 13, 87, 282, 135},
+    {ScheduleOp::ELM, 5266, 13, 87, 295, 180},
+    {ScheduleOp::ELM, 5279, 13, 87, 308, 90},
+    {ScheduleOp::ELM, 5292, 14, 86, 321, 45},
+    {ScheduleOp::ESQ, 5306, 12, 100, 0, 5184},
+    {ScheduleOp::ESQ, 5318, 13, 112, 0, 1296},
+    {ScheduleOp::ESQ, 5331, 13, 125, 0, 576},
+    {ScheduleOp::ESQ, 5344, 14, 138, 0, 144},
+    {ScheduleOp::ELM, 5358, 12, 113, 100, 2592},
+    {ScheduleOp::ELM, 5370, 12, 126, 100, 1728},
+    {ScheduleOp::ELM, 5382, 12, 140, 100, 864},
+    {ScheduleOp::ELM, 5394, 13, 125, 112, 864},
+    {ScheduleOp::ELM, 5407, 13, 139, 112, 432},
+    {ScheduleOp::ELM, 5420, 13, 139, 125, 288},
+    {ScheduleOp::ELM, 5433, 12, 3, 2124, 1296},
+    {ScheduleOp::ELM, 5445, 12, 3, 2136, 648},
+    {ScheduleOp::ELM, 5457, 13, 2, 2148, 648},
+    {ScheduleOp::ELM, 5470, 13, 2, 2161, 324},
+    {ScheduleOp::ELM, 5483, 13, 2, 2174, 432},
+    {ScheduleOp::ELM, 5496, 13, 2, 2187, 216},
+    {ScheduleOp::ELM, 5509, 13, 2, 2200, 216},
+    {ScheduleOp::ELM, 5522, 14, 1, 2213, 108},
+    {ScheduleOp::ELM, 5536, 12, 181, 100, 864},
+    {ScheduleOp::ELM, 5548, 13, 180, 112, 432},
+    {ScheduleOp::ELM, 5561, 13, 180, 125, 288},
+    {ScheduleOp::ELM, 5574, 14, 179, 138, 144},
+    {ScheduleOp::ELM, 5588, 12, 32, 839, 432},
+    {ScheduleOp::ELM, 5600, 13, 31, 851, 216},
+    {ScheduleOp::ELM, 5613, 13, 31, 864, 144},
+    {ScheduleOp::ELM, 5626, 14, 30, 877, 72},
+    {ScheduleOp::ELM, 5640, 12, 210, 100, 216},
+    {ScheduleOp::ELM, 5652, 13, 209, 112, 108},
+    {ScheduleOp::ELM, 5665, 13, 209, 125, 72},
+    {ScheduleOp::ELM, 5678, 14, 208, 138, 36},
+    {ScheduleOp::ELM, 5692, 13, 16, 943, 648},
+    {ScheduleOp::ELM, 5705, 14, 15, 956, 162},
+    {ScheduleOp::ELM, 5719, 13, 16, 970, 324},
+    {ScheduleOp::ELM, 5732, 13, 31, 943, 324},
+    {ScheduleOp::ELM, 5745, 14, 30, 956, 81},
+    {ScheduleOp::ELM, 5759, 13, 31, 970, 162},
+    {ScheduleOp::ELM, 5772, 13, 2, 2371, 216},
+    {ScheduleOp::ELM, 5785, 14, 1, 2384, 108},
+    {ScheduleOp::ELM, 5799, 13, 87, 387, 108},
+    {ScheduleOp::ELM, 5812, 14, 86, 400, 54},
+    {ScheduleOp::ELM, 5826, 13, 471, 44, 54},
+    {ScheduleOp::ELM, 5839, 14, 470, 57, 27},
+    {ScheduleOp::ELM, 5853, 14, 15, 1037, 144},
+    {ScheduleOp::ELM, 5867, 14, 30, 1037, 72},
+    {ScheduleOp::ELM, 5881, 14, 208, 179, 36},
+    {ScheduleOp::ELM, 5895, 14, 1080, 15, 18},
+    {ScheduleOp::ELM, 5909, 15, 0, 2494, 9},
+
+    // order 10
+    {ScheduleOp::LVM, 5924, 7, 2509, 0, 3628800},
+    {ScheduleOp::LVM, 5931, 8, 2517, 0, 1814400},
+    {ScheduleOp::LVM, 5939, 8, 2526, 0, 1209600},
+    {ScheduleOp::LVM, 5947, 9, 2535, 0, 604800},
+    {ScheduleOp::LVM, 5956, 8, 2545, 0, 907200},
+    {ScheduleOp::LVM, 5964, 9, 2554, 0, 453600},
+    {ScheduleOp::LVM, 5973, 9, 2564, 0, 604800},
+    {ScheduleOp::LVM, 5982, 9, 2574, 0, 302400},
+    {ScheduleOp::LVM, 5991, 10, 2584, 0, 151200},
+    {ScheduleOp::LVM, 6001, 8, 2595, 0, 725760},
+    {ScheduleOp::LVM, 6009, 9, 2604, 0, 362880},
+    {ScheduleOp::LVM, 6018, 9, 2614, 0, 241920},
+    {ScheduleOp::LVM, 6027, 10, 2624, 0, 120960},
+    {ScheduleOp::LVM, 6037, 9, 2635, 0, 362880},
+    {ScheduleOp::LVM, 6046, 10, 2645, 0, 181440},
+    {ScheduleOp::LVM, 6056, 9, 2656, 0, 181440},
+    {ScheduleOp::LVM, 6065, 10, 2666, 0, 90720},
+    {ScheduleOp::LVM, 6075, 10, 2677, 0, 120960},
+    {ScheduleOp::LVM, 6085, 10, 2688, 0, 60480},
+    {ScheduleOp::LVM, 6095, 11, 2699, 0, 30240},
+    {ScheduleOp::LVM, 6106, 8, 2711, 0, 604800},
+    {ScheduleOp::LVM, 6114, 9, 2720, 0, 302400},
+    {ScheduleOp::LVM, 6123, 9, 2730, 0, 201600},
+    {ScheduleOp::LVM, 6132, 10, 2740, 0, 100800},
+    {ScheduleOp::LVM, 6142, 9, 2751, 0, 151200},
+    {ScheduleOp::LVM, 6151, 10, 2761, 0, 75600},
+    {ScheduleOp::LVM, 6161, 10, 2772, 0, 100800},
+    {ScheduleOp::LVM, 6171, 10, 2783, 0, 50400},
+    {ScheduleOp::LVM, 6181, 11, 2794, 0, 25200},
+    {ScheduleOp::LVM, 6192, 9, 2806, 0, 241920},
+    {ScheduleOp::LVM, 6201, 10, 2816, 0, 120960},
+    {ScheduleOp::LVM, 6211, 10, 2827, 0, 80640},
+    {ScheduleOp::LVM, 6221, 11, 2838, 0, 40320},
+    {ScheduleOp::LVM, 6232, 9, 2850, 0, 120960},
+    {ScheduleOp::LVM, 6241, 10, 2860, 0, 60480},
+    {ScheduleOp::LVM, 6251, 10, 2871, 0, 40320},
+    {ScheduleOp::LVM, 6261, 11, 2882, 0, 20160},
+    {ScheduleOp::LVM, 6272, 10, 2894, 0, 181440},
+    {ScheduleOp::LVM, 6282, 11, 2905, 0, 45360},
+    {ScheduleOp::LVM, 6293, 10, 2917, 0, 90720},
+    {ScheduleOp::LVM, 6303, 10, 2928, 0, 60480},
+    {ScheduleOp::LVM, 6313, 11, 2939, 0, 30240},
+    {ScheduleOp::LVM, 6324, 10, 2951, 0, 30240},
+    {ScheduleOp::LVM, 6334, 11, 2962, 0, 15120},
+    {ScheduleOp::LVM, 6345, 11, 2974, 0, 40320},
+    {ScheduleOp::LVM, 6356, 11, 2986, 0, 20160},
+    {ScheduleOp::LVM, 6367, 11, 2998, 0, 10080},
+    {ScheduleOp::LVM, 6378, 12, 3010, 0, 5040},
+    {ScheduleOp::LVM, 6390, 8, 3023, 0, 518400},
+    {ScheduleOp::LVM, 6398, 9, 3032, 0, 259200},
+    {ScheduleOp::LVM, 6407, 9, 3042, 0, 172800},
+    {ScheduleOp::LVM, 6416, 10, 3052, 0, 86400},
+    {ScheduleOp::LVM, 6426, 9, 3063, 0, 129600},
+    {ScheduleOp::LVM, 6435, 10, 3073, 0, 64800},
+    {ScheduleOp::LVM, 6445, 10, 3084, 0, 86400},
+    {ScheduleOp::LVM, 6455, 10, 3095, 0, 43200},
+    {ScheduleOp::LVM, 6465, 11, 3106, 0, 21600},
+    {ScheduleOp::LVM, 6476, 9, 3118, 0, 103680},
+    {ScheduleOp::LVM, 6485, 10, 3128, 0, 51840},
+    {ScheduleOp::LVM, 6495, 10, 3139, 0, 34560},
+    {ScheduleOp::LVM, 6505, 11, 3150, 0, 17280},
+    {ScheduleOp::LVM, 6516, 10, 3162, 0, 51840},
+    {ScheduleOp::LVM, 6526, 11, 3173, 0, 25920},
+    {ScheduleOp::LVM, 6537, 10, 3185, 0, 25920},
+    {ScheduleOp::LVM, 6547, 11, 3196, 0, 12960},
+    {ScheduleOp::LVM, 6558, 11, 3208, 0, 17280},
+    {ScheduleOp::LVM, 6569, 11, 3220, 0, 8640},
+    {ScheduleOp::LVM, 6580, 12, 3232, 0, 4320},
+    {ScheduleOp::LVM, 6592, 9, 3245, 0, 172800},
+    {ScheduleOp::LVM, 6601, 10, 3255, 0, 86400},
+    {ScheduleOp::LVM, 6611, 10, 3266, 0, 57600},
+    {ScheduleOp::LVM, 6621, 11, 3277, 0, 28800},
+    {ScheduleOp::LVM, 6632, 10, 3289, 0, 43200},
+    {ScheduleOp::LVM, 6642, 11, 3300, 0, 21600},
+    {ScheduleOp::LVM, 6653, 11, 3312, 0, 28800},
+    {ScheduleOp::LVM, 6664, 11, 3324, 0, 14400},
+    {ScheduleOp::LVM, 6675, 12, 3336, 0, 7200},
+    {ScheduleOp::LVM, 6687, 9, 3349, 0, 86400},
+    {ScheduleOp::LVM, 6696, 10, 3359, 0, 43200},
+    {ScheduleOp::LVM, 6706, 10, 3370, 0, 28800},
+    {ScheduleOp::LVM, 6716, 11, 3381, 0, 14400},
+    {ScheduleOp::LVM, 6727, 10, 3393, 0, 21600},
+    {ScheduleOp::LVM, 6737, 11, 3404, 0, 10800},
+    {ScheduleOp::LVM, 6748, 11, 3416, 0, 14400},
+    {ScheduleOp::LVM, 6759, 11, 3428, 0, 7200},
+    {ScheduleOp::LVM, 6770, 12, 3440, 0, 3600},
+    {ScheduleOp::LVM, 6782, 10, 3453, 0, 103680},
+    {ScheduleOp::LVM, 6792, 10, 3464, 0, 51840},
+    {ScheduleOp::LVM, 6802, 11, 3475, 0, 51840},
+    {ScheduleOp::LVM, 6813, 11, 3487, 0, 25920},
+    {ScheduleOp::LVM, 6824, 11, 3499, 0, 34560},
+    {ScheduleOp::LVM, 6835, 11, 3511, 0, 17280},
+    {ScheduleOp::LVM, 6846, 11, 3523, 0, 17280},
+    {ScheduleOp::LVM, 6857, 12, 3535, 0, 8640},
+    {ScheduleOp::LVM, 6869, 10, 3548, 0, 34560},
+    {ScheduleOp::LVM, 6879, 11, 3559, 0, 17280},
+    {ScheduleOp::LVM, 6890, 11, 3571, 0, 11520},
+    {ScheduleOp::LVM, 6901, 12, 3583, 0, 5760},
+    {ScheduleOp::LVM, 6913, 10, 3596, 0, 17280},
+    {ScheduleOp::LVM, 6923, 11, 3607, 0, 8640},
+    {ScheduleOp::LVM, 6934, 11, 3619, 0, 5760},
+    {ScheduleOp::LVM, 6945, 12, 3631, 0, 2880},
+    {ScheduleOp::LVM, 6957, 11, 3644, 0, 25920},
+    {ScheduleOp::LVM, 6968, 12, 3656, 0, 6480},
+    {ScheduleOp::LVM, 6980, 11, 3669, 0, 12960},
+    {ScheduleOp::LVM, 6991, 11, 3681, 0, 17280},
+    {ScheduleOp::LVM, 7002, 12, 3693, 0, 8640},
+    {ScheduleOp::LVM, 7014, 11, 3706, 0, 8640},
+    {ScheduleOp::LVM, 7025, 12, 3718, 0, 4320},
+    {ScheduleOp::LVM, 7037, 11, 3731, 0, 4320},
+    {ScheduleOp::LVM, 7048, 12, 3743, 0, 2160},
+    {ScheduleOp::LVM, 7060, 12, 3756, 0, 5760},
+    {ScheduleOp::LVM, 7072, 12, 3769, 0, 2880},
+    {ScheduleOp::LVM, 7084, 12, 3782, 0, 1440},
+    {ScheduleOp::LVM, 7096, 13, 3795, 0, 720},
+    {ScheduleOp::LVM, 7109, 8, 3809, 0, 453600},
+    {ScheduleOp::LVM, 7117, 9, 3818, 0, 226800},
+    {ScheduleOp::LVM, 7126, 9, 3828, 0, 151200},
+    {ScheduleOp::LVM, 7135, 10, 3838, 0, 75600},
+    {ScheduleOp::LVM, 7145, 9, 3849, 0, 113400},
+    {ScheduleOp::LVM, 7154, 10, 3859, 0, 56700},
+    {ScheduleOp::LVM, 7164, 10, 3870, 0, 75600},
+    {ScheduleOp::LVM, 7174, 10, 3881, 0, 37800},
+    {ScheduleOp::LVM, 7184, 11, 3892, 0, 18900},
+    {ScheduleOp::LVM, 7195, 9, 3904, 0, 90720},
+    {ScheduleOp::LVM, 7204, 10, 3914, 0, 45360},
+    {ScheduleOp::LVM, 7214, 10, 3925, 0, 30240},
+    {ScheduleOp::LVM, 7224, 11, 3936, 0, 15120},
+    {ScheduleOp::LVM, 7235, 10, 3948, 0, 45360},
+    {ScheduleOp::LVM, 7245, 11, 3959, 0, 22680},
+    {ScheduleOp::LVM, 7256, 10, 3971, 0, 22680},
+    {ScheduleOp::LVM, 7266, 11, 3982, 0, 11340},
+    {ScheduleOp::LVM, 7277, 11, 3994, 0, 15120},
+    {ScheduleOp::LVM, 7288, 11, 4006, 0, 7560},
+    {ScheduleOp::LVM, 7299, 12, 4018, 0, 3780},
+    {ScheduleOp::LVM, 7311, 9, 4031, 0, 75600},
+    {ScheduleOp::LVM, 7320, 10, 4041, 0, 37800},
+    {ScheduleOp::LVM, 7330, 10, 4052, 0, 25200},
+    {ScheduleOp::LVM, 7340, 11, 4063, 0, 12600},
+    {ScheduleOp::LVM, 7351, 10, 4075, 0, 18900},
+    {ScheduleOp::LVM, 7361, 11, 4086, 0, 9450},
+    {ScheduleOp::LVM, 7372, 11, 4098, 0, 12600},
+    {ScheduleOp::LVM, 7383, 11, 4110, 0, 6300},
+    {ScheduleOp::LVM, 7394, 12, 4122, 0, 3150},
+    {ScheduleOp::LVM, 7406, 10, 4135, 0, 30240},
+    {ScheduleOp::LVM, 7416, 11, 4146, 0, 15120},
+    {ScheduleOp::LVM, 7427, 11, 4158, 0, 10080},
+    {ScheduleOp::LVM, 7438, 12, 4170, 0, 5040},
+    {ScheduleOp::LVM, 7450, 10, 4183, 0, 15120},
+    {ScheduleOp::LVM, 7460, 11, 4194, 0, 7560},
+    {ScheduleOp::LVM, 7471, 11, 4206, 0, 5040},
+    {ScheduleOp::LVM, 7482, 12, 4218, 0, 2520},
+    {ScheduleOp::LVM, 7494, 11, 4231, 0, 22680},
+    {ScheduleOp::LVM, 7505, 12, 4243, 0, 5670},
+    {ScheduleOp::LVM, 7517, 11, 4256, 0, 11340},
+    {ScheduleOp::LVM, 7528, 11, 4268, 0, 7560},
+    {ScheduleOp::LVM, 7539, 12, 4280, 0, 3780},
+    {ScheduleOp::LVM, 7551, 11, 4293, 0, 3780},
+    {ScheduleOp::LVM, 7562, 12, 4305, 0, 1890},
+    {ScheduleOp::LVM, 7574, 12, 4318, 0, 5040},
+    {ScheduleOp::LVM, 7586, 12, 4331, 0, 2520},
+    {ScheduleOp::LVM, 7598, 12, 4344, 0, 1260},
+    {ScheduleOp::LVM, 7610, 13, 4357, 0, 630},
+    {ScheduleOp::LVM, 7623, 9, 4371, 0, 129600},
+    {ScheduleOp::LVM, 7632, 10, 4381, 0, 64800},
+    {ScheduleOp::LVM, 7642, 10, 4392, 0, 43200},
+    {ScheduleOp::LVM, 7652, 11, 4403, 0, 21600},
+    {ScheduleOp::LVM, 7663, 10, 4415, 0, 32400},
+    {ScheduleOp::LVM, 7673, 11, 4426, 0, 16200},
+    {ScheduleOp::LVM, 7684, 11, 4438, 0, 21600},
+    {ScheduleOp::LVM, 7695, 11, 4450, 0, 10800},
+    {ScheduleOp::LVM, 7706, 12, 4462, 0, 5400},
+    {ScheduleOp::LVM, 7718, 10, 4475, 0, 25920},
+    {ScheduleOp::LVM, 7728, 11, 4486, 0, 12960},
+    {ScheduleOp::LVM, 7739, 11, 4498, 0, 8640},
+    {ScheduleOp::LVM, 7750, 12, 4510, 0, 4320},
+    {ScheduleOp::LVM, 7762, 11, 4523, 0, 12960},
+    {ScheduleOp::LVM, 7773, 12, 4535, 0, 6480},
+    {ScheduleOp::LVM, 7785, 11, 4548, 0, 6480},
+    {ScheduleOp::LVM, 7796, 12, 4560, 0, 3240},
+    {ScheduleOp::LVM, 7808, 12, 4573, 0, 4320},
+    {ScheduleOp::LVM, 7820, 12, 4586, 0, 2160},
+    {ScheduleOp::LVM, 7832, 13, 4599, 0, 1080},
+    {ScheduleOp::LVM, 7845, 9, 4613, 0, 64800},
+    {ScheduleOp::LVM, 7854, 10, 4623, 0, 32400},
+    {ScheduleOp::LVM, 7864, 10, 4634, 0, 21600},
+    {ScheduleOp::LVM, 7874, 11, 4645, 0, 10800},
+    {ScheduleOp::LVM, 7885, 10, 4657, 0, 16200},
+    {ScheduleOp::LVM, 7895, 11, 4668, 0, 8100},
+    {ScheduleOp::LVM, 7906, 11, 4680, 0, 10800},
+    {ScheduleOp::LVM, 7917, 11, 4692, 0, 5400},
+    {ScheduleOp::LVM, 7928, 12, 4704, 0, 2700},
+    {ScheduleOp::LVM, 7940, 10, 4717, 0, 12960},
+    {ScheduleOp::LVM, 7950, 11, 4728, 0, 6480},
+    {ScheduleOp::LVM, 7961, 11, 4740, 0, 4320},
+    {ScheduleOp::LVM, 7972, 12, 4752, 0, 2160},
+    {ScheduleOp::LVM, 7984, 11, 4765, 0, 6480},
+    {ScheduleOp::LVM, 7995, 12, 4777, 0, 3240},
+    {ScheduleOp::LVM, 8007, 11, 4790, 0, 3240},
+    {ScheduleOp::LVM, 8018, 12, 4802, 0, 1620},
+    {ScheduleOp::LVM, 8030, 12, 4815, 0, 2160},
+    {ScheduleOp::LVM, 8042, 12, 4828, 0, 1080},
+    {ScheduleOp::LVM, 8054, 13, 4841, 0, 540},
+    {ScheduleOp::LVM, 8067, 10, 4855, 0, 64800},
+    {ScheduleOp::LVM, 8077, 10, 4866, 0, 32400},
+    {ScheduleOp::LVM, 8087, 11, 4877, 0, 32400},
+    {ScheduleOp::LVM, 8098, 11, 4889, 0, 16200},
+    {ScheduleOp::LVM, 8109, 11, 4901, 0, 21600},
+    {ScheduleOp::LVM, 8120, 11, 4913, 0, 10800},
+    {ScheduleOp::LVM, 8131, 12, 4925, 0, 10800},
+    {ScheduleOp::LVM, 8143, 12, 4938, 0, 5400},
+    {ScheduleOp::LVM, 8155, 11, 4951, 0, 16200},
+    {ScheduleOp::LVM, 8166, 11, 4963, 0, 8100},
+    {ScheduleOp::LVM, 8177, 12, 4975, 0, 8100},
+    {ScheduleOp::LVM, 8189, 12, 4988, 0, 4050},
+    {ScheduleOp::LVM, 8201, 12, 5001, 0, 10800},
+    {ScheduleOp::LVM, 8213, 12, 5014, 0, 5400},
+    {ScheduleOp::LVM, 8225, 12, 5027, 0, 5400},
+    {ScheduleOp::LVM, 8237, 12, 5040, 0, 2700},
+    {ScheduleOp::LVM, 8249, 12, 5053, 0, 2700},
+    {ScheduleOp::LVM, 8261, 13, 5066, 0, 1350},
+    {ScheduleOp::LVM, 8274, 10, 5080, 0, 21600},
+    {ScheduleOp::LVM, 8284, 11, 5091, 0, 10800},
+    {ScheduleOp::LVM, 8295, 11, 5103, 0, 7200},
+    {ScheduleOp::LVM, 8306, 12, 5115, 0, 3600},
+    {ScheduleOp::LVM, 8318, 11, 5128, 0, 5400},
+    {ScheduleOp::LVM, 8329, 12, 5140, 0, 2700},
+    {ScheduleOp::LVM, 8341, 12, 5153, 0, 3600},
+    {ScheduleOp::LVM, 8353, 12, 5166, 0, 1800},
+    {ScheduleOp::LVM, 8365, 13, 5179, 0, 900},
+    {ScheduleOp::LVM, 8378, 10, 5193, 0, 10800},
+    {ScheduleOp::LVM, 8388, 11, 5204, 0, 5400},
+    {ScheduleOp::LVM, 8399, 11, 5216, 0, 3600},
+    {ScheduleOp::LVM, 8410, 12, 5228, 0, 1800},
+    {ScheduleOp::LVM, 8422, 11, 5241, 0, 2700},
+    {ScheduleOp::LVM, 8433, 12, 5253, 0, 1350},
+    {ScheduleOp::LVM, 8445, 12, 5266, 0, 1800},
+    {ScheduleOp::LVM, 8457, 12, 5279, 0, 900},
+    {ScheduleOp::LVM, 8469, 13, 5292, 0, 450},
+    {ScheduleOp::LVM, 8482, 11, 5306, 0, 51840},
+    {ScheduleOp::LVM, 8493, 12, 5318, 0, 12960},
+    {ScheduleOp::LVM, 8505, 12, 5331, 0, 5760},
+    {ScheduleOp::LVM, 8517, 13, 5344, 0, 1440},
+    {ScheduleOp::LVM, 8530, 11, 5358, 0, 25920},
+    {ScheduleOp::LVM, 8541, 11, 5370, 0, 17280},
+    {ScheduleOp::LVM, 8552, 11, 5382, 0, 8640},
+    {ScheduleOp::LVM, 8563, 12, 5394, 0, 8640},
+    {ScheduleOp::LVM, 8575, 12, 5407, 0, 4320},
+    {ScheduleOp::LVM, 8587, 12, 5420, 0, 2880},
+    {ScheduleOp::LVM, 8599, 11, 5433, 0, 12960},
+    {ScheduleOp::LVM, 8610, 11, 5445, 0, 6480},
+    {ScheduleOp::LVM, 8621, 12, 5457, 0, 6480},
+    {ScheduleOp::LVM, 8633, 12, 5470, 0, 3240},
+    {ScheduleOp::LVM, 8645, 12, 5483, 0, 4320},
+    {ScheduleOp::LVM, 8657, 12, 5496, 0, 2160},
+    {ScheduleOp::LVM, 8669, 12, 5509, 0, 2160},
+    {ScheduleOp::LVM, 8681, 13, 5522, 0, 1080},
+    {ScheduleOp::LVM, 8694, 11, 5536, 0, 8640},
+    {ScheduleOp::LVM, 8705, 12, 5548, 0, 4320},
+    {ScheduleOp::LVM, 8717, 12, 5561, 0, 2880},
+    {ScheduleOp::LVM, 8729, 13, 5574, 0, 1440},
+    {ScheduleOp::LVM, 8742, 11, 5588, 0, 4320},
+    {ScheduleOp::LVM, 8753, 12, 5600, 0, 2160},
+    {ScheduleOp::LVM, 8765, 12, 5613, 0, 1440},
+    {ScheduleOp::LVM, 8777, 13, 5626, 0, 720},
+    {ScheduleOp::LVM, 8790, 11, 5640, 0, 2160},
+    {ScheduleOp::LVM, 8801, 12, 5652, 0, 1080},
+    {ScheduleOp::LVM, 8813, 12, 5665, 0, 720},
+    {ScheduleOp::LVM, 8825, 13, 5678, 0, 360},
+    {ScheduleOp::LVM, 8838, 12, 5692, 0, 6480},
+    {ScheduleOp::LVM, 8850, 13, 5705, 0, 1620},
+    {ScheduleOp::LVM, 8863, 12, 5719, 0, 3240},
+    {ScheduleOp::LVM, 8875, 12, 5732, 0, 3240},
+    {ScheduleOp::LVM, 8887, 13, 5745, 0, 810},
+    {ScheduleOp::LVM, 8900, 12, 5759, 0, 1620},
+    {ScheduleOp::LVM, 8912, 12, 5772, 0, 2160},
+    {ScheduleOp::LVM, 8924, 13, 5785, 0, 1080},
+    {ScheduleOp::LVM, 8937, 12, 5799, 0, 1080},
+    {ScheduleOp::LVM, 8949, 13, 5812, 0, 540},
+    {ScheduleOp::LVM, 8962, 12, 5826, 0, 540},
+    {ScheduleOp::LVM, 8974, 13, 5839, 0, 270},
+    {ScheduleOp::LVM, 8987, 13, 5853, 0, 1440},
+    {ScheduleOp::LVM, 9000, 13, 5867, 0, 720},
+    {ScheduleOp::LVM, 9013, 13, 5881, 0, 360},
+    {ScheduleOp::LVM, 9026, 13, 5895, 0, 180},
+    {ScheduleOp::LVM, 9039, 14, 5909, 0, 90},
+    {ScheduleOp::ELM, 9053, 8, 7, 2509, 403200},
+    {ScheduleOp::ELM, 9061, 9, 6, 2517, 201600},
+    {ScheduleOp::ELM, 9070, 9, 6, 2526, 134400},
+    {ScheduleOp::ELM, 9079, 10, 5, 2535, 67200},
+    {ScheduleOp::ELM, 9089, 9, 6, 2545, 100800},
+    {ScheduleOp::ELM, 9098, 10, 5, 2554, 50400},
+    {ScheduleOp::ELM, 9108, 10, 5, 2564, 67200},
+    {ScheduleOp::ELM, 9118, 10, 5, 2574, 33600},
+    {ScheduleOp::ELM, 9128, 11, 4, 2584, 16800},
+    {ScheduleOp::ELM, 9139, 9, 6, 2595, 80640},
+    {ScheduleOp::ELM, 9148, 10, 5, 2604, 40320},
+    {ScheduleOp::ELM, 9158, 10, 5, 2614, 26880},
+    {ScheduleOp::ELM, 9168, 11, 4, 2624, 13440},
+    {ScheduleOp::ELM, 9179, 10, 5, 2635, 40320},
+    {ScheduleOp::ELM, 9189, 11, 4, 2645, 20160},
+    {ScheduleOp::ELM, 9200, 10, 5, 2656, 20160},
+    {ScheduleOp::ELM, 9210, 11, 4, 2666, 10080},
+    {ScheduleOp::ELM, 9221, 11, 4, 2677, 13440},
+    {ScheduleOp::ELM, 9232, 11, 4, 2688, 6720},
+    {ScheduleOp::ELM, 9243, 12, 3, 2699, 3360},
+    {ScheduleOp::ELM, 9255, 9, 6, 2711, 67200},
+    {ScheduleOp::ELM, 9264, 10, 5, 2720, 33600},
+    {ScheduleOp::ELM, 9274, 10, 5, 2730, 22400},
+    {ScheduleOp::ELM, 9284, 11, 4, 2740, 11200},
+    {ScheduleOp::ELM, 9295, 10, 5, 2751, 16800},
+    {ScheduleOp::ELM, 9305, 11, 4, 2761, 8400},
+    {ScheduleOp::ELM, 9316, 11, 4, 2772, 11200},
+    {ScheduleOp::ELM, 9327, 11, 4, 2783, 5600},
+    {ScheduleOp::ELM, 9338, 12, 3, 2794, 2800},
+    {ScheduleOp::ELM, 9350, 10, 5, 2806, 26880},
+    {ScheduleOp::ELM, 9360, 11, 4, 2816, 13440},
+    {ScheduleOp::ELM, 9371, 11, 4, 2827, 8960},
+    {ScheduleOp::ELM, 9382, 12, 3, 2838, 4480},
+    {ScheduleOp::ELM, 9394, 10, 5, 2850, 13440},
+    {ScheduleOp::ELM, 9404, 11, 4, 2860, 6720},
+    {ScheduleOp::ELM, 9415, 11, 4, 2871, 4480},
+    {ScheduleOp::ELM, 9426, 12, 3, 2882, 2240},
+    {ScheduleOp::ELM, 9438, 11, 4, 2894, 20160},
+    {ScheduleOp::ELM, 9449, 12, 3, 2905, 5040},
+    {ScheduleOp::ELM, 9461, 11, 4, 2917, 10080},
+    {ScheduleOp::ELM, 9472, 11, 4, 2928, 6720},
+    {ScheduleOp::ELM, 9483, 12, 3, 2939, 3360},
+    {ScheduleOp::ELM, 9495, 11, 4, 2951, 3360},
+    {ScheduleOp::ELM, 9506, 12, 3, 2962, 1680},
+    {ScheduleOp::ELM, 9518, 12, 3, 2974, 4480},
+    {ScheduleOp::ELM, 9530, 12, 3, 2986, 2240},
+    {ScheduleOp::ELM, 9542, 12, 3, 2998, 1120},
+    {ScheduleOp::ELM, 9554, 13, 2, 3010, 560},
+    {ScheduleOp::ELM, 9567, 9, 6, 3023, 57600},
+    {ScheduleOp::ELM, 9576, 10, 5, 3032, 28800},
+    {ScheduleOp::ELM, 9586, 10, 5, 3042, 19200},
+    {ScheduleOp::ELM, 9596, 11, 4, 3052, 9600},
+    {ScheduleOp::ELM, 9607, 10, 5, 3063, 14400},
+    {ScheduleOp::ELM, 9617, 11, 4, 3073, 7200},
+    {ScheduleOp::ELM, 9628, 11, 4, 3084, 9600},
+    {ScheduleOp::ELM, 9639, 11, 4, 3095, 4800},
+    {ScheduleOp::ELM, 9650, 12, 3, 3106, 2400},
+    {ScheduleOp::ELM, 9662, 10, 5, 3118, 11520},
+    {ScheduleOp::ELM, 9672, 11, 4, 3128, 5760},
+    {ScheduleOp::ELM, 9683, 11, 4, 3139, 3840},
+    {ScheduleOp::ELM, 9694, 12, 3, 3150, 1920},
+    {ScheduleOp::ELM, 9706, 11, 4, 3162, 5760},
+    {ScheduleOp::ELM, 9717, 12, 3, 3173, 2880},
+    {ScheduleOp::ELM, 9729, 11, 4, 3185, 2880},
+    {ScheduleOp::ELM, 9740, 12, 3, 3196, 1440},
+    {ScheduleOp::ELM, 9752, 12, 3, 3208, 1920},
+    {ScheduleOp::ELM, 9764, 12, 3, 3220, 960},
+    {ScheduleOp::ELM, 9776, 13, 2, 3232, 480},
+    {ScheduleOp::ELM, 9789, 10, 5, 3245, 19200},
+    {ScheduleOp::ELM, 9799, 11, 4, 3255, 9600},
+    {ScheduleOp::ELM, 9810, 11, 4, 3266, 6400},
+    {ScheduleOp::ELM, 9821, 12, 3, 3277, 3200},
+    {ScheduleOp::ELM, 9833, 11, 4, 3289, 4800},
+    {ScheduleOp::ELM, 9844, 12, 3, 3300, 2400},
+    {ScheduleOp::ELM, 9856, 12, 3, 3312, 3200},
+    {ScheduleOp::ELM, 9868, 12, 3, 3324, 1600},
+    {ScheduleOp::ELM, 9880, 13, 2, 3336, 800},
+    {ScheduleOp::ELM, 9893, 10, 5, 3349, 9600},
+    {ScheduleOp::ELM, 9903, 11, 4, 3359, 4800},
+    {ScheduleOp::ELM, 9914, 11, 4, 3370, 3200},
+    {ScheduleOp::ELM, 9925, 12, 3, 3381, 1600},
+    {ScheduleOp::ELM, 9937, 11, 4, 3393, 2400},
+    {ScheduleOp::ELM, 9948, 12, 3, 3404, 1200},
+    {ScheduleOp::ELM, 9960, 12, 3, 3416, 1600},
+    {ScheduleOp::ELM, 9972, 12, 3, 3428, 800},
+    {ScheduleOp::ELM, 9984, 13, 2, 3440, 400},
+    {ScheduleOp::ELM, 9997, 11, 4, 3453, 11520},
+    {ScheduleOp::ELM, 10008, 11, 4, 3464, 5760},
+    {ScheduleOp::ELM, 10019, 12, 3, 3475, 5760},
+    {ScheduleOp::ELM, 10031, 12, 3, 3487, 2880},
+    {ScheduleOp::ELM, 10043, 12, 3, 3499, 3840},
+    {ScheduleOp::ELM, 10055, 12, 3, 3511, 1920},
+    {ScheduleOp::ELM, 10067, 12, 3, 3523, 1920},
+    {ScheduleOp::ELM, 10079, 13, 2, 3535, 960},
+    {ScheduleOp::ELM, 10092, 11, 4, 3548, 3840},
+    {ScheduleOp::ELM, 10103, 12, 3, 3559, 1920},
+    {ScheduleOp::ELM, 10115, 12, 3, 3571, 1280},
+    {ScheduleOp::ELM, 10127, 13, 2, 3583, 640},
+    {ScheduleOp::ELM, 10140, 11, 4, 3596, 1920},
+    {ScheduleOp::ELM, 10151, 12, 3, 3607, 960},
+    {ScheduleOp::ELM, 10163, 12, 3, 3619, 640},
+    {ScheduleOp::ELM, 10175, 13, 2, 3631, 320},
+    {ScheduleOp::ELM, 10188, 12, 3, 3644, 2880},
+    {ScheduleOp::ELM, 10200, 13, 2, 3656, 720},
+    {ScheduleOp::ELM, 10213, 12, 3, 3669, 1440},
+    {ScheduleOp::ELM, 10225, 12, 3, 3681, 1920},
+    {ScheduleOp::ELM, 10237, 13, 2, 3693, 960},
+    {ScheduleOp::ELM, 10250, 12, 3, 3706, 960},
+    {ScheduleOp::ELM, 10262, 13, 2, 3718, 480},
+    {ScheduleOp::ELM, 10275, 12, 3, 3731, 480},
+    {ScheduleOp::ELM, 10287, 13, 2, 3743, 240},
+    {ScheduleOp::ELM, 10300, 13, 2, 3756, 640},
+    {ScheduleOp::ELM, 10313, 13, 2, 3769, 320},
+    {ScheduleOp::ELM, 10326, 13, 2, 3782, 160},
+    {ScheduleOp::ELM, 10339, 14, 1, 3795, 80},
+    {ScheduleOp::ELM, 10353, 9, 20, 1094, 100800},
+    {ScheduleOp::ELM, 10362, 10, 19, 1103, 50400},
+    {ScheduleOp::ELM, 10372, 10, 19, 1113, 33600},
+    {ScheduleOp::ELM, 10382, 11, 18, 1123, 16800},
+    {ScheduleOp::ELM, 10393, 10, 19, 1134, 25200},
+    {ScheduleOp::ELM, 10403, 11, 18, 1144, 12600},
+    {ScheduleOp::ELM, 10414, 11, 18, 1155, 16800},
+    {ScheduleOp::ELM, 10425, 11, 18, 1166, 8400},
+    {ScheduleOp::ELM, 10436, 12, 17, 1177, 4200},
+    {ScheduleOp::ELM, 10448, 10, 19, 1189, 20160},
+    {ScheduleOp::ELM, 10458, 11, 18, 1199, 10080},
+    {ScheduleOp::ELM, 10469, 11, 18, 1210, 6720},
+    {ScheduleOp::ELM, 10480, 12, 17, 1221, 3360},
+    {ScheduleOp::ELM, 10492, 11, 18, 1233, 10080},
+    {ScheduleOp::ELM, 10503, 12, 17, 1244, 5040},
+    {ScheduleOp::ELM, 10515, 11, 18, 1256, 5040},
+    {ScheduleOp::ELM, 10526, 12, 17, 1267, 2520},
+    {ScheduleOp::ELM, 10538, 12, 17, 1279, 3360},
+    {ScheduleOp::ELM, 10550, 12, 17, 1291, 1680},
+    {ScheduleOp::ELM, 10562, 13, 16, 1303, 840},
+    {ScheduleOp::ELM, 10575, 10, 19, 1316, 16800},
+    {ScheduleOp::ELM, 10585, 11, 18, 1326, 8400},
+    {ScheduleOp::ELM, 10596, 11, 18, 1337, 5600},
+    {ScheduleOp::ELM, 10607, 12, 17, 1348, 2800},
+    {ScheduleOp::ELM, 10619, 11, 18, 1360, 4200},
+    {ScheduleOp::ELM, 10630, 12, 17, 1371, 2100},
+    {ScheduleOp::ELM, 10642, 12, 17, 1383, 2800},
+    {ScheduleOp::ELM, 10654, 12, 17, 1395, 1400},
+    {ScheduleOp::ELM, 10666, 13, 16, 1407, 700},
+    {ScheduleOp::ELM, 10679, 11, 18, 1420, 6720},
+    {ScheduleOp::ELM, 10690, 12, 17, 1431, 3360},
+    {ScheduleOp::ELM, 10702, 12, 17, 1443, 2240},
+    {ScheduleOp::ELM, 10714, 13, 16, 1455, 1120},
+    {ScheduleOp::ELM, 10727, 11, 18, 1468, 3360},
+    {ScheduleOp::ELM, 10738, 12, 17, 1479, 1680},
+    {ScheduleOp::ELM, 10750, 12, 17, 1491, 1120},
+    {ScheduleOp::ELM, 10762, 13, 16, 1503, 560},
+    {ScheduleOp::ELM, 10775, 12, 17, 1516, 5040},
+    {ScheduleOp::ELM, 10787, 13, 16, 1528, 1260},
+    {ScheduleOp::ELM, 10800, 12, 17, 1541, 2520},
+    {ScheduleOp::ELM, 10812, 12, 17, 1553, 1680},
+    {ScheduleOp::ELM, 10824, 13, 16, 1565, 840},
+    {ScheduleOp::ELM, 10837, 12, 17, 1578, 840},
+    {ScheduleOp::ELM, 10849, 13, 16, 1590, 420},
+    {ScheduleOp::ELM, 10862, 13, 16, 1603, 1120},
+    {ScheduleOp::ELM, 10875, 13, 16, 1616, 560},
+    {ScheduleOp::ELM, 10888, 13, 16, 1629, 280},
+    {ScheduleOp::ELM, 10901, 14, 15, 1642, 140},
+    {ScheduleOp::ELM, 10915, 9, 35, 1094, 50400},
+    {ScheduleOp::ELM, 10924, 10, 34, 1103, 25200},
+    {ScheduleOp::ELM, 10934, 10, 34, 1113, 16800},
+    {ScheduleOp::ELM, 10944, 11, 33, 1123, 8400},
+    {ScheduleOp::ELM, 10955, 10, 34, 1134, 12600},
+    {ScheduleOp::ELM, 10965, 11, 33, 1144, 6300},
+    {ScheduleOp::ELM, 10976, 11, 33, 1155, 8400},
+    {ScheduleOp::ELM, 10987, 11, 33, 1166, 4200},
+    {ScheduleOp::ELM, 10998, 12, 32, 1177, 2100},
+    {ScheduleOp::ELM, 11010, 10, 34, 1189, 10080},
+    {ScheduleOp::ELM, 11020, 11, 33, 1199, 5040},
+    {ScheduleOp::ELM, 11031, 11, 33, 1210, 3360},
+    {ScheduleOp::ELM, 11042, 12, 32, 1221, 1680},
+    {ScheduleOp::ELM, 11054, 11, 33, 1233, 5040},
+    {ScheduleOp::ELM, 11065, 12, 32, 1244, 2520},
+    {ScheduleOp::ELM, 11077, 11, 33, 1256, 2520},
+    {ScheduleOp::ELM, 11088, 12, 32, 1267, 1260},
+    {ScheduleOp::ELM, 11100, 12, 32, 1279, 1680},
+    {ScheduleOp::ELM, 11112, 12, 32, 1291, 840},
+    {ScheduleOp::ELM, 11124, 13, 31, 1303, 420},
+    {ScheduleOp::ELM, 11137, 10, 34, 1316, 8400},
+    {ScheduleOp::ELM, 11147, 11, 33, 1326, 4200},
+    {ScheduleOp::ELM, 11158, 11, 33, 1337, 2800},
+    {ScheduleOp::ELM, 11169, 12, 32, 1348, 1400},
+    {ScheduleOp::ELM, 11181, 11, 33, 1360, 2100},
+    {ScheduleOp::ELM, 11192, 12, 32, 1371, 1050},
+    {ScheduleOp::ELM, 11204, 12, 32, 1383, 1400},
+    {ScheduleOp::ELM, 11216, 12, 32, 1395, 700},
+    {ScheduleOp::ELM, 11228, 13, 31, 1407, 350},
+    {ScheduleOp::ELM, 11241, 11, 33, 1420, 3360},
+    {ScheduleOp::ELM, 11252, 12, 32, 1431, 1680},
+    {ScheduleOp::ELM, 11264, 12, 32, 1443, 1120},
+    {ScheduleOp::ELM, 11276, 13, 31, 1455, 560},
+    {ScheduleOp::ELM, 11289, 11, 33, 1468, 1680},
+    {ScheduleOp::ELM, 11300, 12, 32, 1479, 840},
+    {ScheduleOp::ELM, 11312, 12, 32, 1491, 560},
+    {ScheduleOp::ELM, 11324, 13, 31, 1503, 280},
+    {ScheduleOp::ELM, 11337, 12, 32, 1516, 2520},
+    {ScheduleOp::ELM, 11349, 13, 31, 1528, 630},
+    {ScheduleOp::ELM, 11362, 12, 32, 1541, 1260},
+    {ScheduleOp::ELM, 11374, 12, 32, 1553, 840},
+    {ScheduleOp::ELM, 11386, 13, 31, 1565, 420},
+    {ScheduleOp::ELM, 11399, 12, 32, 1578, 420},
+    {ScheduleOp::ELM, 11411, 13, 31, 1590, 210},
+    {ScheduleOp::ELM, 11424, 13, 31, 1603, 560},
+    {ScheduleOp::ELM, 11437, 13, 31, 1616, 280},
+    {ScheduleOp::ELM, 11450, 13, 31, 1629, 140},
+    {ScheduleOp::ELM, 11463, 14, 30, 1642, 70},
+    {ScheduleOp::ELM, 11477, 10, 47, 484, 43200},
+    {ScheduleOp::ELM, 11487, 10, 61, 484, 21600},
+    {ScheduleOp::ELM, 11497, 11, 46, 494, 21600},
+    {ScheduleOp::ELM, 11508, 11, 60, 494, 10800},
+    {ScheduleOp::ELM, 11519, 11, 46, 505, 14400},
+    {ScheduleOp::ELM, 11530, 11, 60, 505, 7200},
+    {ScheduleOp::ELM, 11541, 12, 45, 516, 7200},
+    {ScheduleOp::ELM, 11553, 12, 59, 516, 3600},
+    {ScheduleOp::ELM, 11565, 11, 46, 528, 10800},
+    {ScheduleOp::ELM, 11576, 11, 60, 528, 5400},
+    {ScheduleOp::ELM, 11587, 12, 45, 539, 5400},
+    {ScheduleOp::ELM, 11599, 12, 59, 539, 2700},
+    {ScheduleOp::ELM, 11611, 12, 45, 551, 7200},
+    {ScheduleOp::ELM, 11623, 12, 59, 551, 3600},
+    {ScheduleOp::ELM, 11635, 12, 45, 563, 3600},
+    {ScheduleOp::ELM, 11647, 12, 59, 563, 1800},
+    {ScheduleOp::ELM, 11659, 13, 44, 575, 1800},
+    {ScheduleOp::ELM, 11672, 13, 58, 575, 900},
+    {ScheduleOp::ELM, 11685, 11, 588, 46, 8640},
+    {ScheduleOp::ELM, 11696, 11, 60, 588, 4320},
+    {ScheduleOp::ELM, 11707, 12, 599, 45, 4320},
+    {ScheduleOp::ELM, 11719, 12, 59, 599, 2160},
+    {ScheduleOp::ELM, 11731, 12, 611, 45, 2880},
+    {ScheduleOp::ELM, 11743, 12, 59, 611, 1440},
+    {ScheduleOp::ELM, 11755, 13, 623, 44, 1440},
+    {ScheduleOp::ELM, 11768, 13, 58, 623, 720},
+    {ScheduleOp::ELM, 11781, 12, 636, 45, 4320},
+    {ScheduleOp::ELM, 11793, 12, 59, 636, 2160},
+    {ScheduleOp::ELM, 11805, 13, 648, 44, 2160},
+    {ScheduleOp::ELM, 11818, 13, 58, 648, 1080},
+    {ScheduleOp::ELM, 11831, 12, 661, 45, 2160},
+    {ScheduleOp::ELM, 11843, 12, 59, 661, 1080},
+    {ScheduleOp::ELM, 11855, 13, 673, 44, 1080},
+    {ScheduleOp::ELM, 11868, 13, 58, 673, 540},
+    {ScheduleOp::ELM, 11881, 13, 686, 44, 1440},
+    {ScheduleOp::ELM, 11894, 13, 58, 686, 720},
+    {ScheduleOp::ELM, 11907, 13, 699, 44, 720},
+    {ScheduleOp::ELM, 11920, 13, 58, 699, 360},
+    {ScheduleOp::ELM, 11933, 13, 713, 44, 360},
+    {ScheduleOp::ELM, 11946, 14, 57, 712, 180},
+    {ScheduleOp::ELM, 11960, 10, 5, 4371, 14400},
+    {ScheduleOp::ELM, 11970, 11, 4, 4381, 7200},
+    {ScheduleOp::ELM, 11981, 11, 4, 4392, 4800},
+    {ScheduleOp::ELM, 11992, 12, 3, 4403, 2400},
+    {ScheduleOp::ELM, 12004, 11, 4, 4415, 3600},
+    {ScheduleOp::ELM, 12015, 12, 3, 4426, 1800},
+    {ScheduleOp::ELM, 12027, 12, 3, 4438, 2400},
+    {ScheduleOp::ELM, 12039, 12, 3, 4450, 1200},
+    {ScheduleOp::ELM, 12051, 13, 2, 4462, 600},
+    {ScheduleOp::ELM, 12064, 11, 4, 4475, 2880},
+    {ScheduleOp::ELM, 12075, 12, 3, 4486, 1440},
+    {ScheduleOp::ELM, 12087, 12, 3, 4498, 960},
+    {ScheduleOp::ELM, 12099, 13, 2, 4510, 480},
+    {ScheduleOp::ELM, 12112, 12, 3, 4523, 1440},
+    {ScheduleOp::ELM, 12124, 13, 2, 4535, 720},
+    {ScheduleOp::ELM, 12137, 12, 3, 4548, 720},
+    {ScheduleOp::ELM, 12149, 13, 2, 4560, 360},
+    {ScheduleOp::ELM, 12162, 13, 2, 4573, 480},
+    {ScheduleOp::ELM, 12175, 13, 2, 4586, 240},
+    {ScheduleOp::ELM, 12188, 14, 1, 4599, 120},
+    {ScheduleOp::ELM, 12202, 10, 90, 484, 7200},
+    {ScheduleOp::ELM, 12212, 11, 89, 494, 3600},
+    {ScheduleOp::ELM, 12223, 11, 89, 505, 2400},
+    {ScheduleOp::ELM, 12234, 12, 88, 516, 1200},
+    {ScheduleOp::ELM, 12246, 11, 89, 528, 1800},
+    {ScheduleOp::ELM, 12257, 12, 88, 539, 900},
+    {ScheduleOp::ELM, 12269, 12, 88, 551, 1200},
+    {ScheduleOp::ELM, 12281, 12, 88, 563, 600},
+    {ScheduleOp::ELM, 12293, 13, 87, 575, 300},
+    {ScheduleOp::ELM, 12306, 11, 89, 588, 1440},
+    {ScheduleOp::ELM, 12317, 12, 88, 599, 720},
+    {ScheduleOp::ELM, 12329, 12, 88, 611, 480},
+    {ScheduleOp::ELM, 12341, 13, 87, 623, 240},
+    {ScheduleOp::ELM, 12354, 12, 88, 636, 720},
+    {ScheduleOp::ELM, 12366, 13, 87, 648, 360},
+    {ScheduleOp::ELM, 12379, 12, 88, 661, 360},
+    {ScheduleOp::ELM, 12391, 13, 87, 673, 180},
+    {ScheduleOp::ELM, 12404, 13, 87, 686, 240},
+    {ScheduleOp::ELM, 12417, 13, 87, 699, 120},
+    {ScheduleOp::ELM, 12430, 14, 86, 712, 60},
+    {ScheduleOp::ELM, 12444, 11, 101, 222, 28800},
+    {ScheduleOp::ELM, 12455, 11, 114, 222, 14400},
+    {ScheduleOp::ELM, 12466, 11, 127, 222, 9600},
+    {ScheduleOp::ELM, 12477, 11, 141, 222, 4800},
+    {ScheduleOp::ELM, 12488, 12, 100, 233, 14400},
+    {ScheduleOp::ELM, 12500, 12, 113, 233, 7200},
+    {ScheduleOp::ELM, 12512, 12, 126, 233, 4800},
+    {ScheduleOp::ELM, 12524, 12, 140, 233, 2400},
+    {ScheduleOp::ELM, 12536, 12, 245, 100, 9600},
+    {ScheduleOp::ELM, 12548, 12, 113, 245, 4800},
+    {ScheduleOp::ELM, 12560, 12, 126, 245, 3200},
+    {ScheduleOp::ELM, 12572, 12, 140, 245, 1600},
+    {ScheduleOp::ELM, 12584, 12, 258, 100, 4800},
+    {ScheduleOp::ELM, 12596, 13, 112, 257, 2400},
+    {ScheduleOp::ELM, 12609, 13, 125, 257, 1600},
+    {ScheduleOp::ELM, 12622, 13, 139, 257, 800},
+    {ScheduleOp::ELM, 12635, 12, 270, 100, 7200},
+    {ScheduleOp::ELM, 12647, 12, 270, 113, 3600},
+    {ScheduleOp::ELM, 12659, 12, 126, 270, 2400},
+    {ScheduleOp::ELM, 12671, 12, 140, 270, 1200},
+    {ScheduleOp::ELM, 12683, 12, 283, 100, 3600},
+    {ScheduleOp::ELM, 12695, 13, 282, 112, 1800},
+    {ScheduleOp::ELM, 12708, 13, 125, 282, 1200},
+    {ScheduleOp::ELM, 12721, 13, 139, 282, 600},
+    {ScheduleOp::ELM, 12734, 12, 296, 100, 4800},
+    {ScheduleOp::ELM, 12746, 13, 295, 112, 2400},
+    {ScheduleOp::ELM, 12759, 13, 125, 295, 1600},
+    {ScheduleOp::ELM, 12772, 13, 139, 295, 800},
+    {ScheduleOp::ELM, 12785, 12, 309, 100, 2400},
+    {ScheduleOp::ELM, 12797, 13, 308, 112, 1200},
+    {ScheduleOp::ELM, 12810, 13, 125, 308, 800},
+    {ScheduleOp::ELM, 12823, 13, 139, 308, 400},
+    {ScheduleOp::ELM, 12836, 12, 323, 100, 1200},
+    {ScheduleOp::ELM, 12848, 13, 322, 112, 600},
+    {ScheduleOp::ELM, 12861, 13, 322, 125, 400},
+    {ScheduleOp::ELM, 12874, 14, 138, 321, 200},
+    {ScheduleOp::ELM, 12888, 11, 4, 4855, 7200},
+    {ScheduleOp::ELM, 12899, 11, 4, 4866, 3600},
+    {ScheduleOp::ELM, 12910, 12, 3, 4877, 3600},
+    {ScheduleOp::ELM, 12922, 12, 3, 4889, 1800},
+    {ScheduleOp::ELM, 12934, 12, 3, 4901, 2400},
+    {ScheduleOp::ELM, 12946, 12, 3, 4913, 1200},
+    {ScheduleOp::ELM, 12958, 13, 2, 4925, 1200},
+    {ScheduleOp::ELM, 12971, 13, 2, 4938, 600},
+    {ScheduleOp::ELM, 12984, 12, 3, 4951, 1800},
+    {ScheduleOp::ELM, 12996, 12, 3, 4963, 900},
+    {ScheduleOp::ELM, 13008, 13, 2, 4975, 900},
+    {ScheduleOp::ELM, 13021, 13, 2, 4988, 450},
+    {ScheduleOp::ELM, 13034, 13, 2, 5001, 1200},
+    {ScheduleOp::ELM, 13047, 13, 2, 5014, 600},
+    {ScheduleOp::ELM, 13060, 13, 2, 5027, 600},
+    {ScheduleOp::ELM, 13073, 13, 2, 5040, 300},
+    {ScheduleOp::ELM, 13086, 13, 2, 5053, 300},
+    {ScheduleOp::ELM, 13099, 14, 1, 5066, 150},
+    {ScheduleOp::ELM, 13113, 11, 182, 222, 4800},
+    {ScheduleOp::ELM, 13124, 12, 181, 233, 2400},
+    {ScheduleOp::ELM, 13136, 12, 181, 245, 1600},
+    {ScheduleOp::ELM, 13148, 13, 180, 257, 800},
+    {ScheduleOp::ELM, 13161, 12, 181, 270, 1200},
+    {ScheduleOp::ELM, 13173, 13, 180, 282, 600},
+    {ScheduleOp::ELM, 13186, 13, 180, 295, 800},
+    {ScheduleOp::ELM, 13199, 13, 180, 308, 400},
+    {ScheduleOp::ELM, 13212, 14, 179, 321, 200},
+    {ScheduleOp::ELM, 13226, 11, 33, 1898, 2400},
+    {ScheduleOp::ELM, 13237, 12, 32, 1909, 1200},
+    {ScheduleOp::ELM, 13249, 12, 32, 1921, 800},
+    {ScheduleOp::ELM, 13261, 13, 31, 1933, 400},
+    {ScheduleOp::ELM, 13274, 12, 32, 1946, 600},
+    {ScheduleOp::ELM, 13286, 13, 31, 1958, 300},
+    {ScheduleOp::ELM, 13299, 13, 31, 1971, 400},
+    {ScheduleOp::ELM, 13312, 13, 31, 1984, 200},
+    {ScheduleOp::ELM, 13325, 14, 30, 1997, 100},
+    {ScheduleOp::ELM, 13339, 11, 211, 222, 1200},
+    {ScheduleOp::ELM, 13350, 12, 210, 233, 600},
+    {ScheduleOp::ELM, 13362, 12, 210, 245, 400},
+    {ScheduleOp::ELM, 13374, 13, 209, 257, 200},
+    {ScheduleOp::ELM, 13387, 12, 210, 270, 300},
+    {ScheduleOp::ELM, 13399, 13, 209, 282, 150},
+    {ScheduleOp::ELM, 13412, 13, 209, 295, 200},
+    {ScheduleOp::ELM, 13425, 13, 209, 308, 100},
+    {ScheduleOp::ELM, 13438, 14, 208, 321, 50},
+    {ScheduleOp::ELM, 13452, 12, 3, 5306, 5760},
+    {ScheduleOp::ELM, 13464, 13, 2, 5318, 1440},
+    {ScheduleOp::ELM, 13477, 13, 2, 5331, 640},
+    {ScheduleOp::ELM, 13490, 14, 1, 5344, 160},
+    {ScheduleOp::ELM, 13504, 12, 3, 5358, 2880},
+    {ScheduleOp::ELM, 13516, 12, 3, 5370, 1920},
+    {ScheduleOp::ELM, 13528, 12, 3, 5382, 960},
+    {ScheduleOp::ELM, 13540, 13, 2, 5394, 960},
+    {ScheduleOp::ELM, 13553, 13, 2, 5407, 480},
+    {ScheduleOp::ELM, 13566, 13, 2, 5420, 320},
+    {ScheduleOp::ELM, 13579, 12, 17, 2124, 2880},
+    {ScheduleOp::ELM, 13591, 12, 17, 2136, 1440},
+    {ScheduleOp::ELM, 13603, 13, 16, 2148, 1440},
+    {ScheduleOp::ELM, 13616, 13, 16, 2161, 720},
+    {ScheduleOp::ELM, 13629, 13, 16, 2174, 960},
+    {ScheduleOp::ELM, 13642, 13, 16, 2187, 480},
+    {ScheduleOp::ELM, 13655, 13, 16, 2200, 480},
+    {ScheduleOp::ELM, 13668, 14, 15, 2213, 240},
+    {ScheduleOp::ELM, 13682, 12, 32, 2124, 1440},
+    {ScheduleOp::ELM, 13694, 12, 32, 2136, 720},
+    {ScheduleOp::ELM, 13706, 13, 31, 2148, 720},
+    {ScheduleOp::ELM, 13719, 13, 31, 2161, 360},
+    {ScheduleOp::ELM, 13732, 13, 31, 2174, 480},
+    {ScheduleOp::ELM, 13745, 13, 31, 2187, 240},
+    {ScheduleOp::ELM, 13758, 13, 31, 2200, 240},
+    {ScheduleOp::ELM, 13771, 14, 30, 2213, 120},
+    {ScheduleOp::ELM, 13785, 12, 3, 5536, 960},
+    {ScheduleOp::ELM, 13797, 13, 2, 5548, 480},
+    {ScheduleOp::ELM, 13810, 13, 2, 5561, 320},
+    {ScheduleOp::ELM, 13823, 14, 1, 5574, 160},
+    {ScheduleOp::ELM, 13837, 12, 88, 839, 480},
+    {ScheduleOp::ELM, 13849, 13, 87, 851, 240},
+    {ScheduleOp::ELM, 13862, 13, 87, 864, 160},
+    {ScheduleOp::ELM, 13875, 14, 86, 877, 80},
+    {ScheduleOp::ELM, 13889, 12, 472, 100, 240},
+    {ScheduleOp::ELM, 13901, 13, 471, 112, 120},
+    {ScheduleOp::ELM, 13914, 13, 471, 125, 80},
+    {ScheduleOp::ELM, 13927, 14, 470, 138, 40},
+    {ScheduleOp::ELM, 13941, 13, 44, 943, 2160},
+    {ScheduleOp::ELM, 13954, 14, 57, 956, 270},
+    {ScheduleOp::ELM, 13968, 13, 58, 943, 1080},
+    {ScheduleOp::ELM, 13981, 13, 957, 44, 540},
+    {ScheduleOp::ELM, 13994, 13, 2, 5692, 720},
+    {ScheduleOp::ELM, 14007, 14, 1, 5705, 180},
+    {ScheduleOp::ELM, 14021, 13, 2, 5719, 360},
+    {ScheduleOp::ELM, 14034, 13, 87, 943, 360},
+    {ScheduleOp::ELM, 14047, 14, 86, 956, 90},
+    {ScheduleOp::ELM, 14061, 13, 87, 970, 180},
+    {ScheduleOp::ELM, 14074, 13, 1038, 44, 480},
+    {ScheduleOp::ELM, 14087, 14, 1037, 57, 240},
+    {ScheduleOp::ELM, 14101, 13, 31, 2371, 240},
+    {ScheduleOp::ELM, 14114, 14, 30, 2384, 120},
+    {ScheduleOp::ELM, 14128, 13, 209, 387, 120},
+    {ScheduleOp::ELM, 14141, 14, 208, 400, 60},
+    {ScheduleOp::ELM, 14155, 13, 1081, 44, 60},
+    {ScheduleOp::ELM, 14168, 14, 1080, 57, 30},
+    {ScheduleOp::ELM, 14182, 14, 1, 5853, 160},
+    {ScheduleOp::ELM, 14196, 14, 86, 1037, 80},
+    {ScheduleOp::ELM, 14210, 14, 470, 179, 40},
+    {ScheduleOp::ELM, 14224, 14, 2495, 15, 20},
+    {ScheduleOp::ELM, 14238, 15, 0, 5909, 10}
+};
+
+// Returns the index of the schedule entry whose output vector contains the
+// workspace entry at the given offset. Every operand of every schedule entry
+// lies entirely within the output of a single earlier entry.
+static inline std::size_t schedule_entry_containing(std::size_t offset) {
+    std::size_t lo = 0;
+    std::size_t hi = NUM_ORDER_CONDITIONS;
+    while (hi - lo > 1) {
+        const std::size_t mid = lo + (hi - lo) / 2;
+        if (ORDER_CONDITION_SCHEDULE[mid].dst <= offset) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+#endif // RKTK_ORDER_CONDITION_SCHEDULE_HPP_INCLUDED
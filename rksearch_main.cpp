@@ -1,11 +1,16 @@
 // C++ standard library headers
-#include <cmath>    // for std::isfinite
+#include <chrono>   // for std::chrono::steady_clock
+#include <cmath>    // for std::isfinite, std::pow
 #include <cstdlib>  // for std::exit
-#include <cstring>  // for std::strlen
+#include <cstring>  // for std::strlen, std::strncmp
 #include <ctime>    // for std::clock
 #include <iostream> // for std::cout
+#include <string>   // for std::string
+#include <thread>   // for std::thread::hardware_concurrency
+#include <vector>   // for std::vector
 
 // RKTK headers
+#include "memory_pool.hpp"          // for install_pool_allocator
 #include "nonlinear_optimizers.hpp" // for BFGSOptimizer
 
 mpfr_prec_t get_precision(int argc, char **argv) {
@@ -57,7 +62,236 @@ enum class SearchMode {
     EXPLORE, REFINE
 };
 
+// Removes all arguments of the form --name or --name=value from argv,
+// leaving only positional arguments, and returns the new argument count.
+int extract_options(int argc, char **argv,
+                    std::vector<std::string> &options) {
+    int num_positional = 1;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strncmp(argv[i], "--", 2) == 0) {
+            options.emplace_back(argv[i]);
+        } else {
+            argv[num_positional++] = argv[i];
+        }
+    }
+    return num_positional;
+}
+
+// Returns true if option has the form name or name=value. In the latter
+// case, value is parsed as an integer in [min_value, max_value] and stored;
+// otherwise, default_value is stored.
+bool parse_integer_option(const std::string &option, const std::string &name,
+                          std::size_t default_value, std::size_t min_value,
+                          std::size_t max_value, std::size_t &result) {
+    if (option == name) {
+        result = default_value;
+        return true;
+    }
+    if (option.compare(0, name.size() + 1, name + "=") != 0) { return false; }
+    const char *const value = option.c_str() + name.size() + 1;
+    char *end;
+    const long long parsed = std::strtoll(value, &end, 10);
+    const bool read_whole_arg = (*value != '\0') && (*end == '\0');
+    if (!read_whole_arg || parsed < static_cast<long long>(min_value) ||
+        parsed > static_cast<long long>(max_value)) {
+        std::cout << "ERROR: " << name << " requires a value between "
+                  << min_value << " and " << max_value << "." << std::endl;
+        std::exit(EXIT_FAILURE);
+    }
+    result = static_cast<std::size_t>(parsed);
+    return true;
+}
+
+struct SearchOptions {
+    std::size_t initial_max_order = MAX_ORDER;
+    std::size_t column_assumptions = 0;
+    std::size_t gradient_guard_bits = 0;
+    std::size_t precision_guard_bits = 0;
+    bool reverse_mode_gradient = false;
+    std::size_t tape_budget_mib = 0;
+    std::size_t correct_bits = 0;
+    bool multiword_kernels = false;
+    bool compensated_double = false;
+    std::size_t history_length = 0;
+    bool levenberg_marquardt = false;
+    std::size_t polish_iterations = 0;
+    bool truncated_newton = false;
+    bool sr1_trust_region = false;
+    bool mbfgst_update = false;
+    bool wolfe_line_search = false;
+    bool concurrent_line_search = false;
+    std::size_t gradient_search_skip_streak = 0;
+    std::size_t ladder_trials = 0;
+    bool speculative_gradient = false;
+    std::size_t hessian_words = 0;
+    std::size_t target_digits = 0;
+};
+
+// Parses the following options:
+//     --order-continuation[=K]: initially restrict the search to order
+//                               conditions of order at most K (default 6)
+//     --column-assumptions[=Z]: enforce the column simplifying assumption
+//                               D(Z) (default 1)
+//     --mixed-precision[=G]:    evaluate gradients at reduced precision with
+//                               G guard bits (default 64)
+//     --adaptive-precision[=G]: start at reduced working precision and raise
+//                               it as the search converges, keeping G guard
+//                               bits (default 64)
+//     --gradient-tape[=M]:      evaluate gradients in reverse mode, storing
+//                               at most M MiB of intermediate results
+//                               (default 64)
+//     --select-precision[=D]:   start at the lowest precision at which the
+//                               initial objective function value is
+//                               guaranteed to be correct to D bits
+//                               (default 32)
+//     --multiword:              evaluate the objective function in multiword
+//                               fixed-point arithmetic at precisions up to
+//                               364 bits
+//     --compensated-double:     evaluate the objective function in
+//                               compensated double-precision arithmetic at
+//                               precisions up to 53 bits
+//     --lbfgs[=M]:              use limited-memory BFGS with a history of
+//                               M steps (default 8)
+//     --levenberg-marquardt:    minimize the residuals of the order
+//                               conditions by the Levenberg-Marquardt method
+//                               instead of BFGS
+//     --newton-cg:              compute steps by conjugate gradients on
+//                               finite-difference Hessian-vector products
+//                               instead of BFGS
+//     --sr1-trust-region:       minimize a symmetric rank-one quadratic model
+//                               within a trust region instead of BFGS
+//     --mbfgs-t:                update the approximate inverse Hessian by the
+//                               modified BFGS rule MBFGS-T
+//     --wolfe:                  choose BFGS step sizes by a single strong
+//                               Wolfe line search instead of two quadratic
+//                               line searches
+//     --concurrent-line-search: run the two quadratic line searches of each
+//                               BFGS iteration on separate threads
+//     --skip-gradient-search[=N]:
+//                               after N consecutive BFGS steps, search the
+//                               steepest descent direction only every N
+//                               iterations (default 8)
+//     --ladder-search[=N]:      replace each quadratic line search by one
+//                               round of N trial step sizes evaluated in
+//                               parallel (default 8)
+//     --speculative-gradient:   evaluate the gradient at the best trial point
+//                               on a background thread while the quadratic
+//                               line searches continue
+//     --low-precision-hessian[=W]:
+//                               store the approximate inverse Hessian in
+//                               double (W = 1) or double-double (W = 2)
+//                               arithmetic (default 2)
+//     --target[=D]:             report the iteration count and elapsed time
+//                               when the objective function first falls
+//                               below 10^(-D) (default 20)
+//     --polish[=N]:             after locating a candidate local minimum,
+//                               perform up to N Gauss-Newton iterations at
+//                               twice the precision (default 8)
+SearchOptions get_search_options(const std::vector<std::string> &options) {
+    SearchOptions result;
+    for (const std::string &option : options) {
+        if (parse_integer_option(option, "--order-continuation",
+                                 6, 2, MAX_ORDER,
+                                 result.initial_max_order)) { continue; }
+        if (parse_integer_option(option, "--column-assumptions",
+                                 1, 0, MAX_COLUMN_ASSUMPTION_ORDER,
+                                 result.column_assumptions)) { continue; }
+        if (parse_integer_option(option, "--mixed-precision",
+                                 64, 1, 4096,
+                                 result.gradient_guard_bits)) { continue; }
+        if (parse_integer_option(option, "--adaptive-precision",
+                                 64, 1, 4096,
+                                 result.precision_guard_bits)) { continue; }
+        if (parse_integer_option(option, "--gradient-tape",
+                                 64, 0, 1048576,
+                                 result.tape_budget_mib)) {
+            result.reverse_mode_gradient = true;
+            continue;
+        }
+        if (parse_integer_option(option, "--select-precision",
+                                 32, 1, 4096,
+                                 result.correct_bits)) { continue; }
+        if (parse_integer_option(option, "--lbfgs",
+                                 8, 1, 4096,
+                                 result.history_length)) { continue; }
+        if (parse_integer_option(option, "--low-precision-hessian",
+                                 2, 1, 2,
+                                 result.hessian_words)) { continue; }
+        if (parse_integer_option(option, "--target",
+                                 20, 1, 4096,
+                                 result.target_digits)) { continue; }
+        if (parse_integer_option(option, "--skip-gradient-search",
+                                 8, 1, 4096,
+                                 result.gradient_search_skip_streak)) {
+            continue;
+        }
+        if (parse_integer_option(option, "--ladder-search",
+                                 8, 4, LADDER_MAX_TRIALS,
+                                 result.ladder_trials)) { continue; }
+        if (parse_integer_option(option, "--polish",
+                                 8, 1, 1000,
+                                 result.polish_iterations)) { continue; }
+        if (option == "--multiword") {
+            result.multiword_kernels = true;
+            continue;
+        }
+        if (option == "--compensated-double") {
+            result.compensated_double = true;
+            continue;
+        }
+        if (option == "--newton-cg") {
+            result.truncated_newton = true;
+            continue;
+        }
+        if (option == "--sr1-trust-region") {
+            result.sr1_trust_region = true;
+            continue;
+        }
+        if (option == "--mbfgs-t") {
+            result.mbfgst_update = true;
+            continue;
+        }
+        if (option == "--wolfe") {
+            result.wolfe_line_search = true;
+            continue;
+        }
+        if (option == "--speculative-gradient") {
+            result.speculative_gradient = true;
+            continue;
+        }
+        if (option == "--concurrent-line-search") {
+            result.concurrent_line_search = true;
+            continue;
+        }
+        if (option == "--levenberg-marquardt") {
+            result.levenberg_marquardt = true;
+            continue;
+        }
+        std::cout << "ERROR: unrecognized option '"
+                  << option << "'." << std::endl;
+        std::exit(EXIT_FAILURE);
+    }
+    return result;
+}
+
+// Returns the name of the optimization method selected by options.
+const char *method_name(const SearchOptions &options) {
+    if (options.levenberg_marquardt) { return "Levenberg-Marquardt"; }
+    if (options.truncated_newton) { return "Newton-CG"; }
+    if (options.sr1_trust_region) { return "SR1 trust-region"; }
+    if (options.history_length > 0) { return "L-BFGS"; }
+    if (options.mbfgst_update) { return "MBFGS-T"; }
+    if (options.hessian_words == 1) { return "BFGS (double)"; }
+    if (options.hessian_words == 2) { return "BFGS (double-double)"; }
+    return "BFGS";
+}
+
 int main(int argc, char **argv) {
+    // GMP and MPFR allocate through the pool from the very first mpfr_t.
+    install_pool_allocator();
+    std::vector<std::string> options;
+    argc = extract_options(argc, argv, options);
+    const SearchOptions search_options = get_search_options(options);
     const auto clocks_between_prints = static_cast<std::clock_t>(
             get_print_period(argc, argv) * CLOCKS_PER_SEC);
     std::clock_t last_print_clock;
@@ -67,24 +301,225 @@ int main(int argc, char **argv) {
                             ? SearchMode::REFINE
                             : SearchMode::EXPLORE;
     BFGSOptimizer optimizer(prec, MPFR_RNDN);
+    optimizer.set_max_order(search_options.initial_max_order);
+    optimizer.set_column_assumptions(search_options.column_assumptions);
+    optimizer.set_mixed_precision(
+            static_cast<mpfr_prec_t>(search_options.gradient_guard_bits));
+    optimizer.set_adaptive_precision(
+            static_cast<mpfr_prec_t>(search_options.precision_guard_bits));
+    optimizer.set_limited_memory(search_options.history_length);
+    if (search_options.levenberg_marquardt) {
+        if (search_options.column_assumptions > 0) {
+            std::cout << "ERROR: --levenberg-marquardt cannot be combined "
+                         "with --column-assumptions." << std::endl;
+            std::exit(EXIT_FAILURE);
+        }
+        optimizer.set_levenberg_marquardt();
+    }
+    if (search_options.truncated_newton) {
+        if (search_options.levenberg_marquardt ||
+            (search_options.history_length > 0)) {
+            std::cout << "ERROR: --newton-cg cannot be combined with "
+                         "--levenberg-marquardt or --lbfgs." << std::endl;
+            std::exit(EXIT_FAILURE);
+        }
+        optimizer.set_truncated_newton();
+    }
+    if (search_options.sr1_trust_region) {
+        if (search_options.levenberg_marquardt ||
+            search_options.truncated_newton ||
+            (search_options.history_length > 0)) {
+            std::cout << "ERROR: --sr1-trust-region cannot be combined with "
+                         "--levenberg-marquardt, --newton-cg, or --lbfgs."
+                      << std::endl;
+            std::exit(EXIT_FAILURE);
+        }
+        optimizer.set_sr1_trust_region();
+    }
+    if (search_options.mbfgst_update) {
+        if (search_options.levenberg_marquardt ||
+            search_options.truncated_newton ||
+            search_options.sr1_trust_region ||
+            (search_options.history_length > 0)) {
+            std::cout << "ERROR: --mbfgs-t requires the dense inverse Hessian "
+                         "and cannot be combined with --levenberg-marquardt, "
+                         "--newton-cg, --sr1-trust-region, or --lbfgs."
+                      << std::endl;
+            std::exit(EXIT_FAILURE);
+        }
+        optimizer.set_update_rule(InverseHessianUpdate::MBFGST);
+    }
+    if (search_options.hessian_words > 0) {
+        if (search_options.levenberg_marquardt ||
+            search_options.truncated_newton ||
+            search_options.sr1_trust_region ||
+            search_options.mbfgst_update ||
+            (search_options.history_length > 0)) {
+            std::cout << "ERROR: --low-precision-hessian applies to the "
+                         "dense BFGS update only and cannot be combined with "
+                         "--levenberg-marquardt, --newton-cg, "
+                         "--sr1-trust-region, --mbfgs-t, or --lbfgs."
+                      << std::endl;
+            std::exit(EXIT_FAILURE);
+        }
+        optimizer.set_low_precision_inverse_hessian(
+                search_options.hessian_words == 2);
+    }
+    if (search_options.wolfe_line_search) {
+        if (search_options.levenberg_marquardt ||
+            search_options.truncated_newton ||
+            search_options.sr1_trust_region) {
+            std::cout << "ERROR: --wolfe applies to BFGS line searches only "
+                         "and cannot be combined with --levenberg-marquardt, "
+                         "--newton-cg, or --sr1-trust-region." << std::endl;
+            std::exit(EXIT_FAILURE);
+        }
+        optimizer.set_wolfe_line_search();
+    }
+    if (search_options.concurrent_line_search ||
+        (search_options.gradient_search_skip_streak > 0) ||
+        (search_options.ladder_trials > 0) ||
+        search_options.speculative_gradient) {
+        if (search_options.levenberg_marquardt ||
+            search_options.truncated_newton ||
+            search_options.sr1_trust_region ||
+            search_options.wolfe_line_search) {
+            std::cout << "ERROR: --concurrent-line-search, "
+                         "--skip-gradient-search, --ladder-search, and "
+                         "--speculative-gradient apply to quadratic BFGS "
+                         "line searches only and cannot be combined with "
+                         "--levenberg-marquardt, --newton-cg, "
+                         "--sr1-trust-region, or --wolfe." << std::endl;
+            std::exit(EXIT_FAILURE);
+        }
+        optimizer.set_gradient_search_skip(
+                search_options.gradient_search_skip_streak);
+    }
+    if (search_options.concurrent_line_search ||
+        (search_options.ladder_trials > 0) ||
+        search_options.speculative_gradient) {
+        // MPFR keeps its exception flags and constant caches in global
+        // variables unless it was built with thread-local storage.
+        if (!mpfr_buildopt_tls_p()) {
+            std::cout << "ERROR: --concurrent-line-search, --ladder-search, "
+                         "and --speculative-gradient require a thread-safe "
+                         "build of MPFR." << std::endl;
+            std::exit(EXIT_FAILURE);
+        }
+    }
+    if (search_options.concurrent_line_search) {
+        if (search_options.ladder_trials > 0) {
+            std::cout << "ERROR: --concurrent-line-search cannot be combined "
+                         "with --ladder-search." << std::endl;
+            std::exit(EXIT_FAILURE);
+        }
+        optimizer.set_concurrent_line_search();
+    }
+    if (search_options.ladder_trials > 0) {
+        // Use one thread per trial step size, but no more than the hardware
+        // supports.
+        const std::size_t trials = search_options.ladder_trials;
+        std::size_t num_threads = std::thread::hardware_concurrency();
+        if ((num_threads == 0) || (num_threads > trials)) {
+            num_threads = trials;
+        }
+        optimizer.set_ladder_line_search(trials, num_threads);
+    }
+    if (search_options.speculative_gradient) {
+        optimizer.set_speculative_gradient();
+    }
+    if ((search_options.polish_iterations > 0) &&
+        (search_options.column_assumptions > 0)) {
+        std::cout << "ERROR: --polish cannot be combined with "
+                     "--column-assumptions." << std::endl;
+        std::exit(EXIT_FAILURE);
+    }
+    if (search_options.reverse_mode_gradient) {
+        optimizer.set_gradient_tape_budget(
+                search_options.tape_budget_mib << 20);
+    }
+    if (search_options.multiword_kernels) {
+        optimizer.set_multiword_kernels();
+        if (!cpu_supports_ifma()) {
+            std::cout << "AVX-512 IFMA is not available; using portable "
+                         "multiword kernels." << std::endl;
+        }
+    }
+    if (search_options.compensated_double) {
+        optimizer.set_compensated_double();
+    }
     if (mode == SearchMode::REFINE) {
         optimizer.initialize_from_file(std::string(argv[4]));
     } else {
         optimizer.initialize_random();
     }
+    if (search_options.correct_bits > 0) {
+        if (!optimizer.select_precision(
+                static_cast<mpfr_prec_t>(search_options.correct_bits))) {
+            std::cout << "ERROR: --select-precision cannot be combined with "
+                         "--column-assumptions." << std::endl;
+            std::exit(EXIT_FAILURE);
+        }
+    }
     optimizer.print(print_prec);
     optimizer.write_to_file();
     last_print_clock = std::clock();
+    // Time-to-target is measured in wall-clock time from the first step,
+    // so it excludes reading the input file and selecting a precision.
+    const double target = std::pow(
+            10.0, -static_cast<double>(search_options.target_digits));
+    bool reached_target = false;
+    const auto start_time = std::chrono::steady_clock::now();
     optimizer.set_step_size();
     while (true) {
         optimizer.step(print_prec);
-        if (!optimizer.objective_function_has_decreased()) {
+        const bool has_decreased = optimizer.objective_function_has_decreased();
+        if (has_decreased) { optimizer.shift(); }
+        if ((search_options.target_digits > 0) && !reached_target &&
+            optimizer.objective_function_is_below(target)) {
+            reached_target = true;
+            const std::chrono::duration<double> elapsed =
+                    std::chrono::steady_clock::now() - start_time;
+            std::cout << "Reached target 1e-" << search_options.target_digits
+                      << " after " << optimizer.get_iteration_count()
+                      << " iterations in " << elapsed.count() << " s ("
+                      << method_name(search_options) << " at "
+                      << optimizer.get_precision() << " bits)." << std::endl;
+        }
+        // Below full precision (in adaptive-precision mode or after
+        // selecting a precision), a point at which no further progress can
+        // be made is only a candidate local minimum at full precision.
+        if (!has_decreased && optimizer.increase_precision()) {
+            optimizer.print(print_prec);
+            std::cout << "Increasing working precision to "
+                      << optimizer.get_precision() << " bits." << std::endl;
+            last_print_clock = std::clock();
+            continue;
+        }
+        if (!has_decreased || optimizer.stage_has_converged()) {
+            // In order-continuation mode, a local minimum of the truncated
+            // objective function is the starting point for the next order.
+            if (optimizer.increase_max_order()) {
+                optimizer.print(print_prec);
+                std::cout << "Increasing maximum order to "
+                          << optimizer.get_max_order() << "." << std::endl;
+                optimizer.set_step_size();
+                last_print_clock = std::clock();
+                continue;
+            }
+        }
+        if (!has_decreased) {
             optimizer.print(print_prec);
             std::cout << "Located candidate local minimum." << std::endl;
+            if (search_options.polish_iterations > 0) {
+                std::cout << "Polishing at " << 2 * prec
+                          << " bits." << std::endl;
+                optimizer.polish(search_options.polish_iterations,
+                                 print_prec);
+            }
             optimizer.write_to_file();
             return EXIT_SUCCESS;
         }
-        optimizer.shift();
         if (optimizer.get_iteration_count() % 100 == 0) {
             optimizer.write_to_file();
         }
@@ -0,0 +1,1498 @@
+#ifndef RKTK_SCHEDULED_EVALUATORS_HPP_INCLUDED
+#define RKTK_SCHEDULED_EVALUATORS_HPP_INCLUDED
+
+// C++ standard library headers
+#include <algorithm> // for std::sort
+#include <cmath>     // for std::log2
+#include <cstddef>   // for std::size_t
+#include <limits>    // for std::numeric_limits
+#include <vector>    // for std::vector
+
+// GNU MPFR multiprecision library headers
+#include <mpfr.h>
+
+// RKTK headers
+#include "OrderConditionHelpers.hpp"
+#include "multiword_kernels.hpp"
+#include "objective_function.hpp" // for NUM_VARS
+#include "order_condition_schedule.hpp"
+
+/*
+ * The following functions evaluate the objective function by interpreting
+ * ORDER_CONDITION_SCHEDULE instead of running the machine-generated code in
+ * objective_function.hpp. The MPFR evaluators (objective_function_subset,
+ * objective_function_batch, objective_function_bounded, and the objective
+ * function value computed by objective_directional_derivative) perform the
+ * same operations in the same order, so their results agree exactly with the
+ * generated code. The other evaluators make no such guarantee:
+ * objective_function_double and objective_function_multiword compute
+ * different, more accurate results than MPFR at the same precision, and
+ * objective_function_ball returns a rigorous bound on the error in its result
+ * as well as the result itself.
+ *
+ * The evaluators called by the line searchers (objective_function_subset,
+ * objective_function_batch, objective_function_double,
+ * objective_function_multiword, and objective_function_bounded) and the
+ * gradient evaluators (objective_gradient_subset and
+ * objective_gradient_reverse) keep their workspaces in thread-local storage,
+ * so that several line searches, and gradients speculatively evaluated at
+ * their trial points, can run concurrently.
+ */
+
+// =============================================================================
+
+// Applies schedule entry e with its output and operands located at the
+// given addresses instead of at their workspace offsets.
+static inline void apply_schedule_entry_at(mpfr_t *dst,
+                                           mpfr_t *lhs, mpfr_t *rhs,
+                                           mpfr_t *x, const ScheduleEntry &e,
+                                           mpfr_rnd_t r) {
+    switch (e.op) {
+        case ScheduleOp::LRS:
+            lrsm(dst, e.size, x, r);
+            break;
+        case ScheduleOp::LVM:
+            lvmm(dst, e.size, NUM_STAGES, x, lhs, r);
+            break;
+        case ScheduleOp::ESQ:
+            esqm(dst, e.size, lhs, r);
+            break;
+        case ScheduleOp::ELM:
+            elmm(dst, e.size, lhs, rhs, r);
+            break;
+    }
+}
+
+static inline void apply_schedule_entry(mpfr_t *m, mpfr_t *x,
+                                        const ScheduleEntry &e, mpfr_rnd_t r) {
+    apply_schedule_entry_at(m + e.dst, m + e.lhs, m + e.rhs, x, e, r);
+}
+
+// Computes schedule entry k after recursively computing every entry it
+// depends on, skipping entries which have already been computed.
+static void apply_schedule_entry_on_demand(mpfr_t *m, mpfr_t *x,
+                                           bool *computed, std::size_t k,
+                                           mpfr_rnd_t r) {
+    if (computed[k]) { return; }
+    const ScheduleEntry &e = ORDER_CONDITION_SCHEDULE[k];
+    if (e.op != ScheduleOp::LRS) {
+        apply_schedule_entry_on_demand(
+                m, x, computed, schedule_entry_containing(e.lhs), r);
+    }
+    if (e.op == ScheduleOp::ELM) {
+        apply_schedule_entry_on_demand(
+                m, x, computed, schedule_entry_containing(e.rhs), r);
+    }
+    apply_schedule_entry(m, x, e, r);
+    computed[k] = true;
+}
+
+static inline void apply_schedule_entry_tangent(mpfr_t *m_re, mpfr_t *m_du,
+                                                mpfr_t *x, std::size_t x_di,
+                                                const ScheduleEntry &e,
+                                                mpfr_rnd_t r) {
+    switch (e.op) {
+        case ScheduleOp::LRS:
+            lrst(m_du + e.dst, e.size, x_di, r);
+            break;
+        case ScheduleOp::LVM:
+            lvmt(m_du + e.dst, e.size, NUM_STAGES, x, x_di,
+                 m_re + e.lhs, m_du + e.lhs, r);
+            break;
+        case ScheduleOp::ESQ:
+            esqt(m_du + e.dst, e.size, m_re + e.lhs, m_du + e.lhs, r);
+            break;
+        case ScheduleOp::ELM:
+            elmt(m_du + e.dst, e.size, m_re + e.lhs, m_du + e.lhs,
+                 m_re + e.rhs, m_du + e.rhs, r);
+            break;
+    }
+}
+
+// Applies schedule entry e to both the real and dual parts of the workspace,
+// where the dual part of x is dx. The real part is computed exactly as by
+// apply_schedule_entry.
+static inline void apply_schedule_entry_dual(mpfr_t *m_re, mpfr_t *m_du,
+                                             mpfr_t *x, mpfr_t *dx,
+                                             const ScheduleEntry &e,
+                                             mpfr_rnd_t r) {
+    switch (e.op) {
+        case ScheduleOp::LRS:
+            lrsz(m_re + e.dst, m_du + e.dst, e.size, x, dx, r);
+            break;
+        case ScheduleOp::LVM:
+            lvmz(m_re + e.dst, m_du + e.dst, e.size, NUM_STAGES, x, dx,
+                 m_re + e.lhs, m_du + e.lhs, r);
+            break;
+        case ScheduleOp::ESQ:
+            esqz(m_re + e.dst, m_du + e.dst, e.size,
+                 m_re + e.lhs, m_du + e.lhs, r);
+            break;
+        case ScheduleOp::ELM:
+            elmz(m_re + e.dst, m_du + e.dst, e.size, m_re + e.lhs,
+                 m_du + e.lhs, m_re + e.rhs, m_du + e.rhs, r);
+            break;
+    }
+}
+
+// Changes the precision of n workspace entries, discarding their contents.
+static inline void set_workspace_precision(mpfr_t *v, std::size_t n,
+                                           mpfr_prec_t p) {
+    for (std::size_t i = 0; i < n; ++i) { mpfr_set_prec(v[i], p); }
+}
+
+// Marks every schedule entry needed to evaluate the active order conditions,
+// where a null pointer indicates that all order conditions are active.
+// Entries only depend on earlier entries, so one backward pass suffices.
+static void mark_needed_schedule_entries(bool *needed, const bool *active) {
+    for (std::size_t k = 0; k < NUM_ORDER_CONDITIONS; ++k) {
+        needed[k] = (active == nullptr) || active[k];
+    }
+    for (std::size_t k = NUM_ORDER_CONDITIONS; k-- > 0;) {
+        if (!needed[k]) { continue; }
+        const ScheduleEntry &e = ORDER_CONDITION_SCHEDULE[k];
+        if (e.op != ScheduleOp::LRS) {
+            needed[schedule_entry_containing(e.lhs)] = true;
+        }
+        if (e.op == ScheduleOp::ELM) {
+            needed[schedule_entry_containing(e.rhs)] = true;
+        }
+    }
+}
+
+// Returns the number of multiprecision operations needed to evaluate
+// order condition k from scratch, including all of its dependencies.
+static std::size_t order_condition_cost(std::size_t k) {
+    std::vector<bool> visited(NUM_ORDER_CONDITIONS, false);
+    std::vector<std::size_t> stack(1, k);
+    std::size_t cost = ORDER_CONDITION_SCHEDULE[k].size;
+    while (!stack.empty()) {
+        const std::size_t j = stack.back();
+        stack.pop_back();
+        if (visited[j]) { continue; }
+        visited[j] = true;
+        const ScheduleEntry &e = ORDER_CONDITION_SCHEDULE[j];
+        switch (e.op) {
+            case ScheduleOp::LRS:
+            case ScheduleOp::LVM:
+                cost += e.size * (e.size + 1) / 2;
+                break;
+            case ScheduleOp::ESQ:
+            case ScheduleOp::ELM:
+                cost += e.size;
+                break;
+        }
+        if (e.op != ScheduleOp::LRS) {
+            stack.push_back(schedule_entry_containing(e.lhs));
+        }
+        if (e.op == ScheduleOp::ELM) {
+            stack.push_back(schedule_entry_containing(e.rhs));
+        }
+    }
+    return cost;
+}
+
+// =============================================================================
+
+/*
+ * Evaluates objective_function_subset at num_points points simultaneously.
+ * The points use structure-of-arrays layout: component i of point q is
+ * stored in x[i * num_points + q], and its objective value is stored in
+ * f[q]. If breakdown is not a null pointer, the breakdown of point q is
+ * stored in breakdown[q * NUM_RESIDUAL_GROUPS + k] for k < MAX_ORDER, as
+ * described for objective_function_subset. Each schedule entry is applied
+ * to all points before proceeding to the next entry, so the cost of walking
+ * the schedule is shared between points, and the innermost loops run over
+ * contiguous independent data. Every point undergoes the same operations
+ * in the same order as in objective_function_subset, so the results agree
+ * exactly.
+ *
+ * The workspace is kept in thread-local storage and grows to hold the
+ * largest number of points seen so far. Like objective_function_subset,
+ * this function may be called with a different precision each time.
+ */
+void objective_function_batch(mpfr_t *f, mpfr_t *x, std::size_t num_points,
+                              const bool *active, mpfr_t *breakdown,
+                              mpfr_prec_t p, mpfr_rnd_t r) {
+    static thread_local mpfr_t *m = nullptr;
+    static thread_local mpfr_t *g = nullptr;
+    static thread_local mpfr_t *tmp = nullptr;
+    static thread_local bool *needed = nullptr;
+    static thread_local std::size_t capacity = 0;
+    static thread_local mpfr_prec_t workspace_prec = 0;
+    if (g == nullptr) {
+        g = new mpfr_t[NUM_ORDER_CONDITIONS];
+        for (std::size_t k = 0; k < NUM_ORDER_CONDITIONS; ++k) {
+            mpfr_init2(g[k], p);
+            srim(g[k], ORDER_CONDITION_SCHEDULE[k].gamma, r);
+        }
+        needed = new bool[NUM_ORDER_CONDITIONS];
+        workspace_prec = p;
+    } else if (workspace_prec != p) {
+        set_workspace_precision(m, SCHEDULE_WORKSPACE_SIZE * capacity, p);
+        set_workspace_precision(tmp, capacity, p);
+        set_workspace_precision(g, NUM_ORDER_CONDITIONS, p);
+        for (std::size_t k = 0; k < NUM_ORDER_CONDITIONS; ++k) {
+            srim(g[k], ORDER_CONDITION_SCHEDULE[k].gamma, r);
+        }
+        workspace_prec = p;
+    }
+    if (num_points > capacity) {
+        if (m != nullptr) {
+            for (std::size_t i = 0; i < SCHEDULE_WORKSPACE_SIZE * capacity;
+                 ++i) { mpfr_clear(m[i]); }
+            delete[] m;
+            for (std::size_t i = 0; i < capacity; ++i) { mpfr_clear(tmp[i]); }
+            delete[] tmp;
+        }
+        capacity = num_points;
+        m = new mpfr_t[SCHEDULE_WORKSPACE_SIZE * capacity];
+        for (std::size_t i = 0; i < SCHEDULE_WORKSPACE_SIZE * capacity; ++i) {
+            mpfr_init2(m[i], p);
+        }
+        tmp = new mpfr_t[capacity];
+        for (std::size_t i = 0; i < capacity; ++i) { mpfr_init2(tmp[i], p); }
+    }
+    mark_needed_schedule_entries(needed, active);
+    for (std::size_t q = 0; q < num_points; ++q) {
+        mpfr_set_ui(f[q], 1, r);
+        for (std::size_t i = NUM_VARS - NUM_STAGES; i < NUM_VARS; ++i) {
+            mpfr_sub(f[q], f[q], x[i * num_points + q], r);
+        }
+        mpfr_sqr(f[q], f[q], r);
+        if (breakdown != nullptr) {
+            mpfr_t *groups = breakdown + q * NUM_RESIDUAL_GROUPS;
+            mpfr_set(groups[0], f[q], r);
+            for (std::size_t k = 1; k < MAX_ORDER; ++k) {
+                mpfr_set_zero(groups[k], 0);
+            }
+        }
+    }
+    for (std::size_t k = 0; k < NUM_ORDER_CONDITIONS; ++k) {
+        if (!needed[k]) { continue; }
+        const ScheduleEntry &e = ORDER_CONDITION_SCHEDULE[k];
+        mpfr_t *dst = m + e.dst * num_points;
+        switch (e.op) {
+            case ScheduleOp::LRS:
+                lrsb(dst, e.size, num_points, x, r);
+                break;
+            case ScheduleOp::LVM:
+                lvmb(dst, e.size, NUM_STAGES, num_points,
+                     x, m + e.lhs * num_points, r);
+                break;
+            case ScheduleOp::ESQ:
+                esqb(dst, e.size, num_points, m + e.lhs * num_points, r);
+                break;
+            case ScheduleOp::ELM:
+                elmb(dst, e.size, num_points,
+                     m + e.lhs * num_points, m + e.rhs * num_points, r);
+                break;
+        }
+        if ((active != nullptr) && !active[k]) { continue; }
+        resb(f, tmp, e.size, num_points,
+             dst, x + (NUM_VARS - e.size) * num_points, g[k], r);
+        if (breakdown != nullptr) {
+            // resb leaves the residuals in tmp.
+            const std::size_t group = order_condition_order(k) - 1;
+            for (std::size_t q = 0; q < num_points; ++q) {
+                mpfr_ptr sum = breakdown[q * NUM_RESIDUAL_GROUPS + group];
+                mpfr_fma(sum, tmp[q], tmp[q], sum, r);
+            }
+        }
+    }
+}
+
+// =============================================================================
+
+/*
+ * Evaluates the sum of squared residuals of the order-one condition and the
+ * active order conditions, where active is either a null pointer (meaning
+ * all order conditions are active) or an array of NUM_ORDER_CONDITIONS
+ * flags. Only the schedule entries needed by active order conditions are
+ * computed. When all order conditions are active, the result agrees exactly
+ * with objective_function. Like objective_gradient_subset, this function may
+ * be called with a different precision each time.
+ *
+ * If breakdown is not a null pointer, the sums of squared residuals of the
+ * order conditions of each order are also stored in its first MAX_ORDER
+ * entries, as described for NUM_RESIDUAL_GROUPS.
+ */
+void objective_function_subset(mpfr_t f, mpfr_t *x, const bool *active,
+                               mpfr_t *breakdown,
+                               mpfr_prec_t p, mpfr_rnd_t r) {
+    static thread_local mpfr_t *m = nullptr;
+    static thread_local mpfr_t *g = nullptr;
+    static thread_local mpfr_t tmp;
+    static thread_local bool *needed = nullptr;
+    static thread_local mpfr_prec_t workspace_prec = 0;
+    if (m == nullptr) {
+        m = new mpfr_t[SCHEDULE_WORKSPACE_SIZE];
+        for (std::size_t i = 0; i < SCHEDULE_WORKSPACE_SIZE; ++i) {
+            mpfr_init2(m[i], p);
+        }
+        g = new mpfr_t[NUM_ORDER_CONDITIONS];
+        for (std::size_t k = 0; k < NUM_ORDER_CONDITIONS; ++k) {
+            mpfr_init2(g[k], p);
+            srim(g[k], ORDER_CONDITION_SCHEDULE[k].gamma, r);
+        }
+        mpfr_init2(tmp, p);
+        needed = new bool[NUM_ORDER_CONDITIONS];
+        workspace_prec = p;
+    } else if (workspace_prec != p) {
+        set_workspace_precision(m, SCHEDULE_WORKSPACE_SIZE, p);
+        set_workspace_precision(g, NUM_ORDER_CONDITIONS, p);
+        for (std::size_t k = 0; k < NUM_ORDER_CONDITIONS; ++k) {
+            srim(g[k], ORDER_CONDITION_SCHEDULE[k].gamma, r);
+        }
+        mpfr_set_prec(tmp, p);
+        workspace_prec = p;
+    }
+    mark_needed_schedule_entries(needed, active);
+    mpfr_set_ui(f, 1, r);
+    for (std::size_t i = NUM_VARS - NUM_STAGES; i < NUM_VARS; ++i) {
+        mpfr_sub(f, f, x[i], r);
+    }
+    mpfr_sqr(f, f, r);
+    if (breakdown != nullptr) {
+        mpfr_set(breakdown[0], f, r);
+        for (std::size_t k = 1; k < MAX_ORDER; ++k) {
+            mpfr_set_zero(breakdown[k], 0);
+        }
+    }
+    for (std::size_t k = 0; k < NUM_ORDER_CONDITIONS; ++k) {
+        if (!needed[k]) { continue; }
+        const ScheduleEntry &e = ORDER_CONDITION_SCHEDULE[k];
+        apply_schedule_entry(m, x, e, r);
+        if ((active == nullptr) || active[k]) {
+            resm(f, tmp, e.size, m + e.dst, x + (NUM_VARS - e.size), g[k], r);
+            if (breakdown != nullptr) {
+                // resm leaves the residual in tmp.
+                mpfr_ptr group = breakdown[order_condition_order(k) - 1];
+                mpfr_fma(group, tmp, tmp, group, r);
+            }
+        }
+    }
+}
+
+/*
+ * Evaluates objective_function_subset in double precision instead of with
+ * MPFR. All dot products, the residuals of the order conditions, and the sum
+ * of their squares are computed with compensated arithmetic (see dotd and
+ * resd), so the result is accurate to nearly full double precision relative
+ * to f even when the residuals are many orders of magnitude smaller than
+ * their individual terms. The entries of x must be exactly representable as
+ * doubles, and the result is rounded to the precision of f.
+ *
+ * The breakdown argument is treated as in objective_function_subset. Its
+ * entries are accumulated without compensation, since they are only used for
+ * reporting.
+ */
+void objective_function_double(mpfr_t f, mpfr_t *x, const bool *active,
+                               mpfr_t *breakdown, mpfr_rnd_t r) {
+    static thread_local double *m = nullptr;
+    static thread_local double *g_hi = nullptr;
+    static thread_local double *g_lo = nullptr;
+    static thread_local double *xd = nullptr;
+    static thread_local bool *needed = nullptr;
+    if (m == nullptr) {
+        m = new double[SCHEDULE_WORKSPACE_SIZE];
+        g_hi = new double[NUM_ORDER_CONDITIONS];
+        g_lo = new double[NUM_ORDER_CONDITIONS];
+        for (std::size_t k = 0; k < NUM_ORDER_CONDITIONS; ++k) {
+            srid(g_hi[k], g_lo[k], ORDER_CONDITION_SCHEDULE[k].gamma);
+        }
+        xd = new double[NUM_VARS];
+        needed = new bool[NUM_ORDER_CONDITIONS];
+    }
+    for (std::size_t i = 0; i < NUM_VARS; ++i) {
+        xd[i] = mpfr_get_d(x[i], r);
+    }
+    mark_needed_schedule_entries(needed, active);
+    double groups[MAX_ORDER] = {};
+    double s = 1.0, c = 0.0, err;
+    for (std::size_t i = NUM_VARS - NUM_STAGES; i < NUM_VARS; ++i) {
+        twsd(s, err, s, -xd[i]);
+        c += err;
+    }
+    double f_hi, f_lo;
+    twpd(f_hi, f_lo, s + c, s + c);
+    groups[0] = f_hi;
+    for (std::size_t k = 0; k < NUM_ORDER_CONDITIONS; ++k) {
+        if (!needed[k]) { continue; }
+        const ScheduleEntry &e = ORDER_CONDITION_SCHEDULE[k];
+        switch (e.op) {
+            case ScheduleOp::LRS:
+                lrsd(m + e.dst, e.size, xd);
+                break;
+            case ScheduleOp::LVM:
+                lvmd(m + e.dst, e.size, NUM_STAGES, xd, m + e.lhs);
+                break;
+            case ScheduleOp::ESQ:
+                esqd(m + e.dst, e.size, m + e.lhs);
+                break;
+            case ScheduleOp::ELM:
+                elmd(m + e.dst, e.size, m + e.lhs, m + e.rhs);
+                break;
+        }
+        if ((active == nullptr) || active[k]) {
+            const double res = resd(f_hi, f_lo, e.size, m + e.dst,
+                                    xd + (NUM_VARS - e.size),
+                                    g_hi[k], g_lo[k]);
+            groups[order_condition_order(k) - 1] += res * res;
+        }
+    }
+    mpfr_set_d(f, f_hi, r);
+    mpfr_add_d(f, f, f_lo, r);
+    if (breakdown != nullptr) {
+        for (std::size_t k = 0; k < MAX_ORDER; ++k) {
+            mpfr_set_d(breakdown[k], groups[k], r);
+        }
+    }
+}
+
+// Returns the number of limbs objective_function_multiword uses at precision
+// p, or zero if p exceeds the largest precision it supports.
+std::size_t multiword_limb_count(mpfr_prec_t p) {
+    const auto frac_limbs = static_cast<std::size_t>(
+            (p + MULTIWORD_LIMB_BITS - 1) / MULTIWORD_LIMB_BITS);
+    const std::size_t n = (frac_limbs < 1) ? 2 : frac_limbs + 1;
+    return (n <= MAX_MULTIWORD_LIMBS) ? n : 0;
+}
+
+/*
+ * Evaluates objective_function_subset in multiword fixed-point arithmetic
+ * (see multiword_kernels.hpp) with 52 * ceil(p / 52) fractional bits. The
+ * entries of x are rounded to that many fractional bits, all intermediate
+ * results are truncated to it, and the residuals of the order conditions are
+ * computed exactly from the truncated intermediate results before being
+ * squared and summed in MPFR with precision p.
+ *
+ * Returns false, leaving f and breakdown unspecified, if any intermediate
+ * result reaches 2^52 in magnitude, or if p requires more than
+ * MAX_MULTIWORD_LIMBS limbs (see multiword_limb_count). The breakdown
+ * argument is treated as in objective_function_subset.
+ */
+bool objective_function_multiword(mpfr_t f, mpfr_t *x, const bool *active,
+                                  mpfr_t *breakdown,
+                                  mpfr_prec_t p, mpfr_rnd_t r) {
+    // The workspace holds the schedule intermediates, followed by x, the
+    // reciprocals 1 / gamma of the order conditions, and one residual.
+    static const std::size_t x_offset = SCHEDULE_WORKSPACE_SIZE;
+    static const std::size_t g_offset = x_offset + NUM_VARS;
+    static const std::size_t res_offset = g_offset + NUM_ORDER_CONDITIONS;
+    static thread_local MultiwordWorkspace w = {0, res_offset + 1,
+                                                nullptr, nullptr,
+                                                cpu_supports_ifma(), false};
+    static thread_local mpfr_t tmp, res;
+    static thread_local mpz_t z;
+    static thread_local bool *needed = nullptr;
+    const std::size_t n = multiword_limb_count(p);
+    if (n == 0) { return false; }
+    if (w.limbs == nullptr) {
+        w.limbs = new std::uint64_t[MAX_MULTIWORD_LIMBS * w.stride];
+        w.neg = new std::uint64_t[w.stride];
+        mpfr_init2(tmp, MULTIWORD_LIMB_BITS * MAX_MULTIWORD_LIMBS);
+        mpfr_init2(res, MULTIWORD_LIMB_BITS * MAX_MULTIWORD_LIMBS);
+        mpz_init(z);
+        needed = new bool[NUM_ORDER_CONDITIONS];
+    }
+    w.overflow = false;
+    if (w.num_limbs != n) {
+        w.num_limbs = n;
+        mpfr_t g;
+        mpfr_init2(g, static_cast<mpfr_prec_t>(MULTIWORD_LIMB_BITS * (n + 1)));
+        for (std::size_t k = 0; k < NUM_ORDER_CONDITIONS; ++k) {
+            srim(g, ORDER_CONDITION_SCHEDULE[k].gamma, MPFR_RNDN);
+            setw(w, g_offset + k, g, tmp, z);
+        }
+        mpfr_clear(g);
+    }
+    for (std::size_t i = 0; i < NUM_VARS; ++i) {
+        setw(w, x_offset + i, x[i], tmp, z);
+    }
+    if (w.overflow) { return false; }
+    mark_needed_schedule_entries(needed, active);
+    mpfr_set_ui(f, 1, r);
+    for (std::size_t i = NUM_VARS - NUM_STAGES; i < NUM_VARS; ++i) {
+        mpfr_sub(f, f, x[i], r);
+    }
+    mpfr_sqr(f, f, r);
+    if (breakdown != nullptr) {
+        mpfr_set(breakdown[0], f, r);
+        for (std::size_t k = 1; k < MAX_ORDER; ++k) {
+            mpfr_set_zero(breakdown[k], 0);
+        }
+    }
+    // The residual is exact in 52 * n bits, so no rounding occurs before
+    // it is squared.
+    mpfr_set_prec(res, static_cast<mpfr_prec_t>(MULTIWORD_LIMB_BITS * n));
+    for (std::size_t k = 0; k < NUM_ORDER_CONDITIONS; ++k) {
+        if (!needed[k]) { continue; }
+        const ScheduleEntry &e = ORDER_CONDITION_SCHEDULE[k];
+        switch (e.op) {
+            case ScheduleOp::LRS:
+                lrsw(w, e.dst, e.size, x_offset);
+                break;
+            case ScheduleOp::LVM:
+                lvmw(w, e.dst, e.size, NUM_STAGES, x_offset, e.lhs);
+                break;
+            case ScheduleOp::ESQ:
+                esqw(w, e.dst, e.size, e.lhs);
+                break;
+            case ScheduleOp::ELM:
+                elmw(w, e.dst, e.size, e.lhs, e.rhs);
+                break;
+        }
+        if ((active == nullptr) || active[k]) {
+            resw(w, res_offset, e.size, e.dst,
+                 x_offset + (NUM_VARS - e.size), g_offset + k);
+            getw(res, w, res_offset, z, r);
+            mpfr_fma(f, res, res, f, r);
+            if (breakdown != nullptr) {
+                mpfr_ptr group = breakdown[order_condition_order(k) - 1];
+                mpfr_fma(group, res, res, group, r);
+            }
+        }
+        if (w.overflow) { return false; }
+    }
+    return true;
+}
+
+// Precision of the radii used by objective_function_ball. Radii are only
+// upper bounds, so they need not be accurate.
+#define BALL_RADIUS_PRECISION 32
+
+/*
+ * Evaluates objective_function_subset in ball arithmetic (see the ball
+ * functions in OrderConditionHelpers.hpp), performing the same midpoint
+ * operations with the same precision p. On return, f_rad rigorously bounds
+ * the distance between f and the exact value of the objective function at
+ * x, and if res_rad is not a null pointer, res_rad[k] likewise bounds the
+ * error in the residual of each active order condition k. Entries of
+ * res_rad for inactive order conditions are set to zero. The entries of x
+ * are treated as exact.
+ */
+void objective_function_ball(mpfr_t f, mpfr_t f_rad, mpfr_t *res_rad,
+                             mpfr_t *x, const bool *active,
+                             mpfr_prec_t p, mpfr_rnd_t r) {
+    static mpfr_t *m = nullptr;
+    static mpfr_t *m_rad = nullptr;
+    static mpfr_t *g = nullptr;
+    static mpfr_t *g_rad = nullptr;
+    static mpfr_t res, rad, tmp;
+    static bool *needed = nullptr;
+    static mpfr_prec_t workspace_prec = 0;
+    if (m == nullptr) {
+        m = new mpfr_t[SCHEDULE_WORKSPACE_SIZE];
+        m_rad = new mpfr_t[SCHEDULE_WORKSPACE_SIZE];
+        for (std::size_t i = 0; i < SCHEDULE_WORKSPACE_SIZE; ++i) {
+            mpfr_init2(m[i], p);
+            mpfr_init2(m_rad[i], BALL_RADIUS_PRECISION);
+        }
+        mpfr_inits2(BALL_RADIUS_PRECISION, rad, tmp,
+                    static_cast<mpfr_ptr>(nullptr));
+        g = new mpfr_t[NUM_ORDER_CONDITIONS];
+        g_rad = new mpfr_t[NUM_ORDER_CONDITIONS];
+        for (std::size_t k = 0; k < NUM_ORDER_CONDITIONS; ++k) {
+            mpfr_init2(g[k], p);
+            mpfr_init2(g_rad[k], BALL_RADIUS_PRECISION);
+            srir(g[k], g_rad[k], ORDER_CONDITION_SCHEDULE[k].gamma, tmp, r);
+        }
+        mpfr_init2(res, p);
+        needed = new bool[NUM_ORDER_CONDITIONS];
+        workspace_prec = p;
+    } else if (workspace_prec != p) {
+        set_workspace_precision(m, SCHEDULE_WORKSPACE_SIZE, p);
+        set_workspace_precision(g, NUM_ORDER_CONDITIONS, p);
+        for (std::size_t k = 0; k < NUM_ORDER_CONDITIONS; ++k) {
+            srir(g[k], g_rad[k], ORDER_CONDITION_SCHEDULE[k].gamma, tmp, r);
+        }
+        mpfr_set_prec(res, p);
+        workspace_prec = p;
+    }
+    mark_needed_schedule_entries(needed, active);
+    mpfr_set_zero(rad, 0);
+    mpfr_set_ui(res, 1, r);
+    for (std::size_t i = NUM_VARS - NUM_STAGES; i < NUM_VARS; ++i) {
+        if (mpfr_sub(res, res, x[i], r)) { rner(rad, res, tmp); }
+    }
+    mpfr_set_zero(f_rad, 0);
+    mler(f_rad, res, rad, res, rad, tmp);
+    if (mpfr_sqr(f, res, r)) { rner(f_rad, f, tmp); }
+    for (std::size_t k = 0; k < NUM_ORDER_CONDITIONS; ++k) {
+        if (res_rad != nullptr) { mpfr_set_zero(res_rad[k], 0); }
+        if (!needed[k]) { continue; }
+        const ScheduleEntry &e = ORDER_CONDITION_SCHEDULE[k];
+        switch (e.op) {
+            case ScheduleOp::LRS:
+                lrsr(m + e.dst, m_rad + e.dst, e.size, x, tmp, r);
+                break;
+            case ScheduleOp::LVM:
+                lvmr(m + e.dst, m_rad + e.dst, e.size, NUM_STAGES,
+                     x, m + e.lhs, m_rad + e.lhs, tmp, r);
+                break;
+            case ScheduleOp::ESQ:
+                esqr(m + e.dst, m_rad + e.dst, e.size,
+                     m + e.lhs, m_rad + e.lhs, tmp, r);
+                break;
+            case ScheduleOp::ELM:
+                elmr(m + e.dst, m_rad + e.dst, e.size,
+                     m + e.lhs, m_rad + e.lhs, m + e.rhs, m_rad + e.rhs,
+                     tmp, r);
+                break;
+        }
+        if ((active == nullptr) || active[k]) {
+            resr(f, f_rad, res, rad, e.size, m + e.dst, m_rad + e.dst,
+                 x + (NUM_VARS - e.size), g[k], g_rad[k], tmp, r);
+            if (res_rad != nullptr) { mpfr_set(res_rad[k], rad, MPFR_RNDU); }
+        }
+    }
+}
+
+/*
+ * Evaluates the gradient of objective_function_subset. The real parts of all
+ * intermediate vectors are computed once and shared between all NUM_VARS
+ * partial derivatives, so only their dual parts are recomputed for each
+ * variable. When all order conditions are active, the result agrees exactly
+ * with objective_gradient.
+ *
+ * Unlike the machine-generated code, this function may be called with a
+ * different precision each time, in which case its workspace is resized.
+ * Precisions lower than that of x can be used to compute an approximate
+ * gradient cheaply; all intermediate results are then rounded to p bits.
+ */
+void objective_gradient_subset(mpfr_t *dst, mpfr_t *x, const bool *active,
+                               mpfr_prec_t p, mpfr_rnd_t r) {
+    static thread_local mpfr_t *m_re = nullptr;
+    static thread_local mpfr_t *m_du = nullptr;
+    static thread_local mpfr_t *g = nullptr;
+    static thread_local mpfr_t *res = nullptr;
+    static thread_local mpfr_t tmp;
+    static thread_local bool *needed = nullptr;
+    static thread_local mpfr_prec_t workspace_prec = 0;
+    if (m_re == nullptr) {
+        m_re = new mpfr_t[SCHEDULE_WORKSPACE_SIZE];
+        for (std::size_t i = 0; i < SCHEDULE_WORKSPACE_SIZE; ++i) {
+            mpfr_init2(m_re[i], p);
+        }
+        m_du = new mpfr_t[SCHEDULE_WORKSPACE_SIZE];
+        for (std::size_t i = 0; i < SCHEDULE_WORKSPACE_SIZE; ++i) {
+            mpfr_init2(m_du[i], p);
+        }
+        g = new mpfr_t[NUM_ORDER_CONDITIONS];
+        res = new mpfr_t[NUM_ORDER_CONDITIONS];
+        for (std::size_t k = 0; k < NUM_ORDER_CONDITIONS; ++k) {
+            mpfr_init2(g[k], p);
+            srim(g[k], ORDER_CONDITION_SCHEDULE[k].gamma, r);
+            mpfr_init2(res[k], p);
+        }
+        mpfr_init2(tmp, p);
+        needed = new bool[NUM_ORDER_CONDITIONS];
+        workspace_prec = p;
+    } else if (workspace_prec != p) {
+        set_workspace_precision(m_re, SCHEDULE_WORKSPACE_SIZE, p);
+        set_workspace_precision(m_du, SCHEDULE_WORKSPACE_SIZE, p);
+        set_workspace_precision(g, NUM_ORDER_CONDITIONS, p);
+        set_workspace_precision(res, NUM_ORDER_CONDITIONS, p);
+        for (std::size_t k = 0; k < NUM_ORDER_CONDITIONS; ++k) {
+            srim(g[k], ORDER_CONDITION_SCHEDULE[k].gamma, r);
+        }
+        mpfr_set_prec(tmp, p);
+        workspace_prec = p;
+    }
+    mark_needed_schedule_entries(needed, active);
+    for (std::size_t k = 0; k < NUM_ORDER_CONDITIONS; ++k) {
+        if (!needed[k]) { continue; }
+        const ScheduleEntry &e = ORDER_CONDITION_SCHEDULE[k];
+        apply_schedule_entry(m_re, x, e, r);
+        if ((active == nullptr) || active[k]) {
+            dotm(res[k], e.size, m_re + e.dst, x + (NUM_VARS - e.size), r);
+            mpfr_sub(res[k], res[k], g[k], r);
+        }
+    }
+    for (std::size_t i = 0; i < NUM_VARS; ++i) {
+        if (i >= NUM_VARS - NUM_STAGES) {
+            mpfr_set_si(dst[i], -1, r);
+            for (std::size_t j = NUM_VARS - NUM_STAGES; j < NUM_VARS; ++j) {
+                mpfr_add(dst[i], dst[i], x[j], r);
+            }
+            mpfr_mul_2ui(dst[i], dst[i], 1, r);
+        } else {
+            mpfr_set_ui(dst[i], 0, r);
+        }
+        for (std::size_t k = 0; k < NUM_ORDER_CONDITIONS; ++k) {
+            if (!needed[k]) { continue; }
+            const ScheduleEntry &e = ORDER_CONDITION_SCHEDULE[k];
+            apply_schedule_entry_tangent(m_re, m_du, x, i, e, r);
+            if ((active == nullptr) || active[k]) {
+                rest(dst[i], res[k], tmp, e.size, m_re, m_du, e.dst,
+                     x, i, NUM_VARS - e.size, r);
+            }
+        }
+    }
+}
+
+/*
+ * Evaluates objective_function_subset together with its directional
+ * derivative df along dx, i.e., the dot product of its gradient with dx, in
+ * a single forward-mode pass with dual parts seeded by dx. This costs about
+ * three objective function evaluations, compared to NUM_VARS tangent passes
+ * for the full gradient. The value stored in f, and the breakdown (if
+ * requested), agree exactly with objective_function_subset.
+ */
+void objective_directional_derivative(mpfr_t f, mpfr_t df,
+                                      mpfr_t *x, mpfr_t *dx,
+                                      const bool *active, mpfr_t *breakdown,
+                                      mpfr_prec_t p, mpfr_rnd_t r) {
+    static mpfr_t *m_re = nullptr;
+    static mpfr_t *m_du = nullptr;
+    static mpfr_t *g = nullptr;
+    static mpfr_t tmp_re, tmp_du;
+    static bool *needed = nullptr;
+    static mpfr_prec_t workspace_prec = 0;
+    if (m_re == nullptr) {
+        m_re = new mpfr_t[SCHEDULE_WORKSPACE_SIZE];
+        m_du = new mpfr_t[SCHEDULE_WORKSPACE_SIZE];
+        for (std::size_t i = 0; i < SCHEDULE_WORKSPACE_SIZE; ++i) {
+            mpfr_init2(m_re[i], p);
+            mpfr_init2(m_du[i], p);
+        }
+        g = new mpfr_t[NUM_ORDER_CONDITIONS];
+        for (std::size_t k = 0; k < NUM_ORDER_CONDITIONS; ++k) {
+            mpfr_init2(g[k], p);
+            srim(g[k], ORDER_CONDITION_SCHEDULE[k].gamma, r);
+        }
+        mpfr_inits2(p, tmp_re, tmp_du, static_cast<mpfr_ptr>(nullptr));
+        needed = new bool[NUM_ORDER_CONDITIONS];
+        workspace_prec = p;
+    } else if (workspace_prec != p) {
+        set_workspace_precision(m_re, SCHEDULE_WORKSPACE_SIZE, p);
+        set_workspace_precision(m_du, SCHEDULE_WORKSPACE_SIZE, p);
+        set_workspace_precision(g, NUM_ORDER_CONDITIONS, p);
+        for (std::size_t k = 0; k < NUM_ORDER_CONDITIONS; ++k) {
+            srim(g[k], ORDER_CONDITION_SCHEDULE[k].gamma, r);
+        }
+        mpfr_set_prec(tmp_re, p);
+        mpfr_set_prec(tmp_du, p);
+        workspace_prec = p;
+    }
+    mark_needed_schedule_entries(needed, active);
+    // The order-one condition contributes (1 - sum(b))^2 to f and
+    // -2 * (1 - sum(b)) * sum(db) to df.
+    mpfr_set_ui(f, 1, r);
+    mpfr_set_zero(df, 0);
+    for (std::size_t i = NUM_VARS - NUM_STAGES; i < NUM_VARS; ++i) {
+        mpfr_sub(f, f, x[i], r);
+        mpfr_sub(df, df, dx[i], r);
+    }
+    mpfr_mul(df, df, f, r);
+    mpfr_mul_2ui(df, df, 1, r);
+    mpfr_sqr(f, f, r);
+    if (breakdown != nullptr) {
+        mpfr_set(breakdown[0], f, r);
+        for (std::size_t k = 1; k < MAX_ORDER; ++k) {
+            mpfr_set_zero(breakdown[k], 0);
+        }
+    }
+    for (std::size_t k = 0; k < NUM_ORDER_CONDITIONS; ++k) {
+        if (!needed[k]) { continue; }
+        const ScheduleEntry &e = ORDER_CONDITION_SCHEDULE[k];
+        apply_schedule_entry_dual(m_re, m_du, x, dx, e, r);
+        if ((active == nullptr) || active[k]) {
+            const std::size_t x_offset = NUM_VARS - e.size;
+            resz(f, df, tmp_re, tmp_du, e.size, m_re + e.dst, m_du + e.dst,
+                 x + x_offset, dx + x_offset, g[k], r);
+            if (breakdown != nullptr) {
+                // resz leaves the residual in tmp_re.
+                mpfr_ptr group = breakdown[order_condition_order(k) - 1];
+                mpfr_fma(group, tmp_re, tmp_re, group, r);
+            }
+        }
+    }
+}
+
+/*
+ * Evaluates objective_function_double together with its directional
+ * derivative df along dx, as objective_directional_derivative does for
+ * objective_function_subset. The value stored in f, and the breakdown (if
+ * requested), agree exactly with objective_function_double. The dual parts
+ * are computed in plain double-precision arithmetic, except for the
+ * derivatives of the residuals, which use compensated dot products.
+ */
+void objective_directional_derivative_double(mpfr_t f, mpfr_t df,
+                                             mpfr_t *x, mpfr_t *dx,
+                                             const bool *active,
+                                             mpfr_t *breakdown,
+                                             mpfr_rnd_t r) {
+    static thread_local double *m_re = nullptr;
+    static thread_local double *m_du = nullptr;
+    static thread_local double *g_hi = nullptr;
+    static thread_local double *g_lo = nullptr;
+    static thread_local double *xd = nullptr;
+    static thread_local double *dxd = nullptr;
+    static thread_local bool *needed = nullptr;
+    if (m_re == nullptr) {
+        m_re = new double[SCHEDULE_WORKSPACE_SIZE];
+        m_du = new double[SCHEDULE_WORKSPACE_SIZE];
+        g_hi = new double[NUM_ORDER_CONDITIONS];
+        g_lo = new double[NUM_ORDER_CONDITIONS];
+        for (std::size_t k = 0; k < NUM_ORDER_CONDITIONS; ++k) {
+            srid(g_hi[k], g_lo[k], ORDER_CONDITION_SCHEDULE[k].gamma);
+        }
+        xd = new double[NUM_VARS];
+        dxd = new double[NUM_VARS];
+        needed = new bool[NUM_ORDER_CONDITIONS];
+    }
+    for (std::size_t i = 0; i < NUM_VARS; ++i) {
+        xd[i] = mpfr_get_d(x[i], r);
+        dxd[i] = mpfr_get_d(dx[i], r);
+    }
+    mark_needed_schedule_entries(needed, active);
+    double groups[MAX_ORDER] = {};
+    double s = 1.0, c = 0.0, ds = 0.0, err;
+    for (std::size_t i = NUM_VARS - NUM_STAGES; i < NUM_VARS; ++i) {
+        twsd(s, err, s, -xd[i]);
+        c += err;
+        ds -= dxd[i];
+    }
+    double f_hi, f_lo;
+    twpd(f_hi, f_lo, s + c, s + c);
+    double df_sum = 2.0 * (s + c) * ds;
+    groups[0] = f_hi;
+    double scratch[NUM_STAGES];
+    for (std::size_t k = 0; k < NUM_ORDER_CONDITIONS; ++k) {
+        if (!needed[k]) { continue; }
+        const ScheduleEntry &e = ORDER_CONDITION_SCHEDULE[k];
+        switch (e.op) {
+            case ScheduleOp::LRS:
+                lrsd(m_re + e.dst, e.size, xd);
+                lrsd(m_du + e.dst, e.size, dxd);
+                break;
+            case ScheduleOp::LVM:
+                lvmd(m_re + e.dst, e.size, NUM_STAGES, xd, m_re + e.lhs);
+                lvmd(m_du + e.dst, e.size, NUM_STAGES, xd, m_du + e.lhs);
+                lvmd(scratch, e.size, NUM_STAGES, dxd, m_re + e.lhs);
+                for (std::size_t i = 0; i < e.size; ++i) {
+                    m_du[e.dst + i] += scratch[i];
+                }
+                break;
+            case ScheduleOp::ESQ:
+                esqd(m_re + e.dst, e.size, m_re + e.lhs);
+                for (std::size_t i = 0; i < e.size; ++i) {
+                    m_du[e.dst + i] =
+                            2.0 * m_re[e.lhs + i] * m_du[e.lhs + i];
+                }
+                break;
+            case ScheduleOp::ELM:
+                elmd(m_re + e.dst, e.size, m_re + e.lhs, m_re + e.rhs);
+                for (std::size_t i = 0; i < e.size; ++i) {
+                    m_du[e.dst + i] = m_re[e.lhs + i] * m_du[e.rhs + i] +
+                                      m_du[e.lhs + i] * m_re[e.rhs + i];
+                }
+                break;
+        }
+        if ((active == nullptr) || active[k]) {
+            const std::size_t x_offset = NUM_VARS - e.size;
+            const double res = resd(f_hi, f_lo, e.size, m_re + e.dst,
+                                    xd + x_offset, g_hi[k], g_lo[k]);
+            groups[order_condition_order(k) - 1] += res * res;
+            double d1_hi, d1_lo, d2_hi, d2_lo;
+            dotd(d1_hi, d1_lo, e.size, m_du + e.dst, xd + x_offset);
+            dotd(d2_hi, d2_lo, e.size, m_re + e.dst, dxd + x_offset);
+            df_sum += 2.0 * res * ((d1_hi + d2_hi) + (d1_lo + d2_lo));
+        }
+    }
+    mpfr_set_d(f, f_hi, r);
+    mpfr_add_d(f, f, f_lo, r);
+    mpfr_set_d(df, df_sum, r);
+    if (breakdown != nullptr) {
+        for (std::size_t k = 0; k < MAX_ORDER; ++k) {
+            mpfr_set_d(breakdown[k], groups[k], r);
+        }
+    }
+}
+
+/*
+ * Evaluates objective_function_multiword together with its directional
+ * derivative df along dx, as objective_directional_derivative does for
+ * objective_function_subset. The dual parts are computed in the same
+ * multiword fixed-point arithmetic as the real parts (see lvmwt and the
+ * other tangent functions in multiword_kernels.hpp), and the value stored
+ * in f, and the breakdown (if requested), agree exactly with
+ * objective_function_multiword.
+ *
+ * Returns false, leaving f, df, and breakdown unspecified, under the same
+ * conditions as objective_function_multiword, or if any dual part reaches
+ * 2^52 in magnitude.
+ */
+bool objective_directional_derivative_multiword(mpfr_t f, mpfr_t df,
+                                                mpfr_t *x, mpfr_t *dx,
+                                                const bool *active,
+                                                mpfr_t *breakdown,
+                                                mpfr_prec_t p, mpfr_rnd_t r) {
+    // The workspace holds the real and dual parts of the schedule
+    // intermediates, followed by x, dx, the reciprocals 1 / gamma of the
+    // order conditions, and the real and dual parts of one residual.
+    static const std::size_t du_offset = SCHEDULE_WORKSPACE_SIZE;
+    static const std::size_t x_offset = 2 * SCHEDULE_WORKSPACE_SIZE;
+    static const std::size_t dx_offset = x_offset + NUM_VARS;
+    static const std::size_t g_offset = dx_offset + NUM_VARS;
+    static const std::size_t res_offset = g_offset + NUM_ORDER_CONDITIONS;
+    static thread_local MultiwordWorkspace w = {0, res_offset + 2,
+                                                nullptr, nullptr,
+                                                cpu_supports_ifma(), false};
+    static thread_local mpfr_t tmp, res, res_du;
+    static thread_local mpz_t z;
+    static thread_local bool *needed = nullptr;
+    const std::size_t n = multiword_limb_count(p);
+    if (n == 0) { return false; }
+    if (w.limbs == nullptr) {
+        w.limbs = new std::uint64_t[MAX_MULTIWORD_LIMBS * w.stride];
+        w.neg = new std::uint64_t[w.stride];
+        mpfr_init2(tmp, MULTIWORD_LIMB_BITS * MAX_MULTIWORD_LIMBS);
+        mpfr_init2(res, MULTIWORD_LIMB_BITS * MAX_MULTIWORD_LIMBS);
+        mpfr_init2(res_du, MULTIWORD_LIMB_BITS * MAX_MULTIWORD_LIMBS);
+        mpz_init(z);
+        needed = new bool[NUM_ORDER_CONDITIONS];
+    }
+    w.overflow = false;
+    if (w.num_limbs != n) {
+        w.num_limbs = n;
+        mpfr_t g;
+        mpfr_init2(g, static_cast<mpfr_prec_t>(MULTIWORD_LIMB_BITS * (n + 1)));
+        for (std::size_t k = 0; k < NUM_ORDER_CONDITIONS; ++k) {
+            srim(g, ORDER_CONDITION_SCHEDULE[k].gamma, MPFR_RNDN);
+            setw(w, g_offset + k, g, tmp, z);
+        }
+        mpfr_clear(g);
+    }
+    for (std::size_t i = 0; i < NUM_VARS; ++i) {
+        setw(w, x_offset + i, x[i], tmp, z);
+        setw(w, dx_offset + i, dx[i], tmp, z);
+    }
+    if (w.overflow) { return false; }
+    mark_needed_schedule_entries(needed, active);
+    // The order-one condition is handled exactly as by
+    // objective_directional_derivative.
+    mpfr_set_ui(f, 1, r);
+    mpfr_set_zero(df, 0);
+    for (std::size_t i = NUM_VARS - NUM_STAGES; i < NUM_VARS; ++i) {
+        mpfr_sub(f, f, x[i], r);
+        mpfr_sub(df, df, dx[i], r);
+    }
+    mpfr_mul(df, df, f, r);
+    mpfr_mul_2ui(df, df, 1, r);
+    mpfr_sqr(f, f, r);
+    if (breakdown != nullptr) {
+        mpfr_set(breakdown[0], f, r);
+        for (std::size_t k = 1; k < MAX_ORDER; ++k) {
+            mpfr_set_zero(breakdown[k], 0);
+        }
+    }
+    // Both parts of the residual are exact in 52 * n bits.
+    mpfr_set_prec(res, static_cast<mpfr_prec_t>(MULTIWORD_LIMB_BITS * n));
+    mpfr_set_prec(res_du, static_cast<mpfr_prec_t>(MULTIWORD_LIMB_BITS * n));
+    mpfr_set_prec(tmp, p);
+    for (std::size_t k = 0; k < NUM_ORDER_CONDITIONS; ++k) {
+        if (!needed[k]) { continue; }
+        const ScheduleEntry &e = ORDER_CONDITION_SCHEDULE[k];
+        switch (e.op) {
+            case ScheduleOp::LRS:
+                lrsw(w, e.dst, e.size, x_offset);
+                lrsw(w, du_offset + e.dst, e.size, dx_offset);
+                break;
+            case ScheduleOp::LVM:
+                lvmw(w, e.dst, e.size, NUM_STAGES, x_offset, e.lhs);
+                lvmwt(w, du_offset + e.dst, e.size, NUM_STAGES,
+                      x_offset, dx_offset, e.lhs, du_offset + e.lhs);
+                break;
+            case ScheduleOp::ESQ:
+                esqw(w, e.dst, e.size, e.lhs);
+                esqwt(w, du_offset + e.dst, e.size,
+                      e.lhs, du_offset + e.lhs);
+                break;
+            case ScheduleOp::ELM:
+                elmw(w, e.dst, e.size, e.lhs, e.rhs);
+                elmwt(w, du_offset + e.dst, e.size, e.lhs, du_offset + e.lhs,
+                      e.rhs, du_offset + e.rhs);
+                break;
+        }
+        if ((active == nullptr) || active[k]) {
+            const std::size_t x_skip = NUM_VARS - e.size;
+            resw(w, res_offset, e.size, e.dst,
+                 x_offset + x_skip, g_offset + k);
+            reswt(w, res_offset + 1, e.size, e.dst, du_offset + e.dst,
+                  x_offset + x_skip, dx_offset + x_skip);
+            getw(res, w, res_offset, z, r);
+            getw(res_du, w, res_offset + 1, z, r);
+            mpfr_fma(f, res, res, f, r);
+            mpfr_mul(tmp, res, res_du, r);
+            mpfr_mul_2ui(tmp, tmp, 1, r);
+            mpfr_add(df, df, tmp, r);
+            if (breakdown != nullptr) {
+                mpfr_ptr group = breakdown[order_condition_order(k) - 1];
+                mpfr_fma(group, res, res, group, r);
+            }
+        }
+        if (w.overflow) { return false; }
+    }
+    return true;
+}
+
+// Number of residuals computed by objective_residual_jacobian: that of the
+// order-one condition sum(b) = 1, followed by those of all order conditions.
+#define NUM_RESIDUALS (NUM_ORDER_CONDITIONS + 1)
+
+/*
+ * Evaluates the residuals whose squares objective_function_subset sums,
+ * storing them in res, together with their Jacobian, stored in row-major
+ * order in jac (so that jac[k * NUM_VARS + i] is the partial derivative of
+ * res[k] with respect to x[i]). Entry 0 is the residual sum(b) - 1, and entry
+ * k + 1 is that of order condition k. The residuals and rows of inactive
+ * order conditions are set to zero.
+ *
+ * The Jacobian is computed in forward mode exactly as in
+ * objective_gradient_subset, at the same cost.
+ */
+void objective_residual_jacobian(mpfr_t *res, mpfr_t *jac, mpfr_t *x,
+                                 const bool *active,
+                                 mpfr_prec_t p, mpfr_rnd_t r) {
+    static mpfr_t *m_re = nullptr;
+    static mpfr_t *m_du = nullptr;
+    static mpfr_t *g = nullptr;
+    static bool *needed = nullptr;
+    static mpfr_prec_t workspace_prec = 0;
+    if (m_re == nullptr) {
+        m_re = new mpfr_t[SCHEDULE_WORKSPACE_SIZE];
+        m_du = new mpfr_t[SCHEDULE_WORKSPACE_SIZE];
+        for (std::size_t i = 0; i < SCHEDULE_WORKSPACE_SIZE; ++i) {
+            mpfr_init2(m_re[i], p);
+            mpfr_init2(m_du[i], p);
+        }
+        g = new mpfr_t[NUM_ORDER_CONDITIONS];
+        for (std::size_t k = 0; k < NUM_ORDER_CONDITIONS; ++k) {
+            mpfr_init2(g[k], p);
+            srim(g[k], ORDER_CONDITION_SCHEDULE[k].gamma, r);
+        }
+        needed = new bool[NUM_ORDER_CONDITIONS];
+        workspace_prec = p;
+    } else if (workspace_prec != p) {
+        set_workspace_precision(m_re, SCHEDULE_WORKSPACE_SIZE, p);
+        set_workspace_precision(m_du, SCHEDULE_WORKSPACE_SIZE, p);
+        set_workspace_precision(g, NUM_ORDER_CONDITIONS, p);
+        for (std::size_t k = 0; k < NUM_ORDER_CONDITIONS; ++k) {
+            srim(g[k], ORDER_CONDITION_SCHEDULE[k].gamma, r);
+        }
+        workspace_prec = p;
+    }
+    mark_needed_schedule_entries(needed, active);
+    mpfr_set_si(res[0], -1, r);
+    for (std::size_t i = NUM_VARS - NUM_STAGES; i < NUM_VARS; ++i) {
+        mpfr_add(res[0], res[0], x[i], r);
+    }
+    for (std::size_t i = 0; i < NUM_VARS; ++i) {
+        mpfr_set_ui(jac[i], (i >= NUM_VARS - NUM_STAGES) ? 1 : 0, r);
+    }
+    for (std::size_t k = 0; k < NUM_ORDER_CONDITIONS; ++k) {
+        mpfr_set_zero(res[k + 1], 0);
+        for (std::size_t i = 0; i < NUM_VARS; ++i) {
+            mpfr_set_zero(jac[(k + 1) * NUM_VARS + i], 0);
+        }
+        if (!needed[k]) { continue; }
+        const ScheduleEntry &e = ORDER_CONDITION_SCHEDULE[k];
+        apply_schedule_entry(m_re, x, e, r);
+        if ((active == nullptr) || active[k]) {
+            dotm(res[k + 1], e.size, m_re + e.dst, x + (NUM_VARS - e.size), r);
+            mpfr_sub(res[k + 1], res[k + 1], g[k], r);
+        }
+    }
+    for (std::size_t i = 0; i < NUM_VARS; ++i) {
+        for (std::size_t k = 0; k < NUM_ORDER_CONDITIONS; ++k) {
+            if (!needed[k]) { continue; }
+            const ScheduleEntry &e = ORDER_CONDITION_SCHEDULE[k];
+            apply_schedule_entry_tangent(m_re, m_du, x, i, e, r);
+            if ((active == nullptr) || active[k]) {
+                // Derivative of dot(m, x_b) with respect to x[i], as in rest.
+                mpfr_ptr d = jac[(k + 1) * NUM_VARS + i];
+                const std::size_t x_offset = NUM_VARS - e.size;
+                dotm(d, e.size, m_du + e.dst, x + x_offset, r);
+                if (x_offset <= i) {
+                    mpfr_add(d, d, m_re[e.dst + (i - x_offset)], r);
+                }
+            }
+        }
+    }
+}
+
+// =============================================================================
+
+// Returns the number of workspace entries occupied by the outputs of the
+// order conditions of order at most order.
+static std::size_t schedule_workspace_prefix_size(std::size_t order) {
+    const std::size_t num_entries = ORDER_CONDITION_OFFSETS[order - 1];
+    if (num_entries == 0) { return 0; }
+    const ScheduleEntry &e = ORDER_CONDITION_SCHEDULE[num_entries - 1];
+    return e.dst + e.size;
+}
+
+// Returns the largest order s such that the values and adjoints of all
+// intermediate vectors of order at most s fit into budget bytes at precision
+// p. A result of 1 means that no intermediate vectors fit.
+std::size_t reverse_mode_stored_orders(std::size_t budget, mpfr_prec_t p) {
+    const std::size_t entry_bytes =
+            2 * (sizeof(mpfr_t) + mpfr_custom_get_size(p));
+    std::size_t order = 1;
+    while ((order < MAX_ORDER) &&
+           (schedule_workspace_prefix_size(order + 1) * entry_bytes <=
+            budget)) { ++order; }
+    return order;
+}
+
+// Collects schedule entry k and every entry with index at least first it
+// depends on, directly or indirectly.
+static void collect_dependencies_from(std::vector<std::size_t> &deps,
+                                      std::size_t k, std::size_t first) {
+    if (std::find(deps.begin(), deps.end(), k) != deps.end()) { return; }
+    deps.push_back(k);
+    const ScheduleEntry &e = ORDER_CONDITION_SCHEDULE[k];
+    if (e.op != ScheduleOp::LRS) {
+        const std::size_t j = schedule_entry_containing(e.lhs);
+        if (j >= first) { collect_dependencies_from(deps, j, first); }
+    }
+    if (e.op == ScheduleOp::ELM) {
+        const std::size_t j = schedule_entry_containing(e.rhs);
+        if (j >= first) { collect_dependencies_from(deps, j, first); }
+    }
+}
+
+static inline void apply_schedule_entry_adjoint(mpfr_t *dst_ad,
+                                                mpfr_t *lhs, mpfr_t *lhs_ad,
+                                                mpfr_t *rhs, mpfr_t *rhs_ad,
+                                                mpfr_t *x, mpfr_t *x_ad,
+                                                mpfr_t tmp,
+                                                const ScheduleEntry &e,
+                                                mpfr_rnd_t r) {
+    switch (e.op) {
+        case ScheduleOp::LRS:
+            lrsa(x_ad, e.size, dst_ad, r);
+            break;
+        case ScheduleOp::LVM:
+            lvma(x_ad, lhs_ad, e.size, NUM_STAGES, x, lhs, dst_ad, r);
+            break;
+        case ScheduleOp::ESQ:
+            esqa(lhs_ad, tmp, e.size, lhs, dst_ad, r);
+            break;
+        case ScheduleOp::ELM:
+            elma(lhs_ad, rhs_ad, e.size, lhs, rhs, dst_ad, r);
+            break;
+    }
+}
+
+/*
+ * Evaluates the gradient of objective_function_subset in reverse mode, at a
+ * cost of a small multiple of one objective function evaluation, while
+ * keeping the tape of intermediate vectors within a memory budget.
+ *
+ * Every intermediate vector of order q depends only on intermediate vectors
+ * of order less than q. The intermediate vectors of order at most
+ * stored_orders (see reverse_mode_stored_orders) are computed once and kept,
+ * together with their adjoints, in a workspace laid out like that of
+ * objective_function_subset. Each active order condition of higher order is
+ * then handled on its own: the unstored intermediate vectors it depends on
+ * are recomputed into a small pool of scratch slots, its residual is
+ * evaluated, and its adjoint is swept back through the scratch slots into
+ * the stored adjoints. A final backward sweep over the stored prefix
+ * completes the gradient.
+ *
+ * Intermediate vectors of order MAX_ORDER are never operands, so storing
+ * all orders but the highest costs no recomputation at all. Each further
+ * order left unstored roughly halves the tape and multiplies the number of
+ * recomputed vectors per order condition by a small factor.
+ */
+void objective_gradient_reverse(mpfr_t *dst, mpfr_t *x, const bool *active,
+                                std::size_t stored_orders,
+                                mpfr_prec_t p, mpfr_rnd_t r) {
+    static thread_local mpfr_t *m = nullptr;
+    static thread_local mpfr_t *m_ad = nullptr;
+    static thread_local std::size_t workspace_size = 0;
+    static thread_local mpfr_t *slots = nullptr;
+    static thread_local mpfr_t *slots_ad = nullptr;
+    static thread_local std::size_t num_slots = 0;
+    static thread_local mpfr_t *g = nullptr;
+    static thread_local mpfr_t res, tmp;
+    static thread_local bool *needed = nullptr;
+    static thread_local std::size_t *slot_index = nullptr;
+    static thread_local mpfr_prec_t workspace_prec = 0;
+    static thread_local std::vector<std::size_t> cone;
+    if (g == nullptr) {
+        g = new mpfr_t[NUM_ORDER_CONDITIONS];
+        for (std::size_t k = 0; k < NUM_ORDER_CONDITIONS; ++k) {
+            mpfr_init2(g[k], p);
+            srim(g[k], ORDER_CONDITION_SCHEDULE[k].gamma, r);
+        }
+        mpfr_inits2(p, res, tmp, static_cast<mpfr_ptr>(nullptr));
+        needed = new bool[NUM_ORDER_CONDITIONS];
+        slot_index = new std::size_t[NUM_ORDER_CONDITIONS];
+        workspace_prec = p;
+    } else if (workspace_prec != p) {
+        set_workspace_precision(g, NUM_ORDER_CONDITIONS, p);
+        for (std::size_t k = 0; k < NUM_ORDER_CONDITIONS; ++k) {
+            srim(g[k], ORDER_CONDITION_SCHEDULE[k].gamma, r);
+        }
+        mpfr_set_prec(res, p);
+        mpfr_set_prec(tmp, p);
+        set_workspace_precision(m, workspace_size, p);
+        set_workspace_precision(m_ad, workspace_size, p);
+        set_workspace_precision(slots, num_slots * NUM_STAGES, p);
+        set_workspace_precision(slots_ad, num_slots * NUM_STAGES, p);
+        workspace_prec = p;
+    }
+    const std::size_t first_unstored =
+            ORDER_CONDITION_OFFSETS[stored_orders - 1];
+    const std::size_t stored_size =
+            schedule_workspace_prefix_size(stored_orders);
+    if (stored_size != workspace_size) {
+        for (std::size_t i = 0; i < workspace_size; ++i) {
+            mpfr_clear(m[i]);
+            mpfr_clear(m_ad[i]);
+        }
+        delete[] m;
+        delete[] m_ad;
+        workspace_size = stored_size;
+        m = new mpfr_t[workspace_size];
+        m_ad = new mpfr_t[workspace_size];
+        for (std::size_t i = 0; i < workspace_size; ++i) {
+            mpfr_init2(m[i], p);
+            mpfr_init2(m_ad[i], p);
+        }
+    }
+    // Returns the location of the value or adjoint of the workspace entry at
+    // the given offset, which lies either in the stored prefix or in a
+    // scratch slot.
+    const auto locate = [](mpfr_t *stored, mpfr_t *scratch,
+                           std::size_t offset) -> mpfr_t * {
+        if (offset < workspace_size) { return stored + offset; }
+        const std::size_t k = schedule_entry_containing(offset);
+        return scratch + slot_index[k] * NUM_STAGES +
+               (offset - ORDER_CONDITION_SCHEDULE[k].dst);
+    };
+    mark_needed_schedule_entries(needed, active);
+    // The order-one condition contributes 2 * (sum(b) - 1) to the gradient
+    // with respect to each b_i.
+    for (std::size_t i = 0; i < NUM_VARS; ++i) {
+        if (i >= NUM_VARS - NUM_STAGES) {
+            mpfr_set_si(dst[i], -1, r);
+            for (std::size_t j = NUM_VARS - NUM_STAGES; j < NUM_VARS; ++j) {
+                mpfr_add(dst[i], dst[i], x[j], r);
+            }
+            mpfr_mul_2ui(dst[i], dst[i], 1, r);
+        } else {
+            mpfr_set_ui(dst[i], 0, r);
+        }
+    }
+    // Forward sweep over the stored prefix, seeding the adjoints of its
+    // active order conditions with 2 * residual.
+    for (std::size_t i = 0; i < workspace_size; ++i) {
+        mpfr_set_zero(m_ad[i], 0);
+    }
+    for (std::size_t k = 0; k < first_unstored; ++k) {
+        if (!needed[k]) { continue; }
+        const ScheduleEntry &e = ORDER_CONDITION_SCHEDULE[k];
+        apply_schedule_entry(m, x, e, r);
+        if ((active == nullptr) || active[k]) {
+            mpfr_t *const x_res = x + (NUM_VARS - e.size);
+            dotm(res, e.size, m + e.dst, x_res, r);
+            mpfr_sub(res, res, g[k], r);
+            mpfr_mul_2ui(res, res, 1, r);
+            resa(m_ad + e.dst, dst + (NUM_VARS - e.size), e.size,
+                 m + e.dst, x_res, res, r);
+        }
+    }
+    // Each active order condition beyond the stored prefix is recomputed
+    // from its unstored dependencies and swept back on its own.
+    for (std::size_t k = first_unstored; k < NUM_ORDER_CONDITIONS; ++k) {
+        if ((active != nullptr) && !active[k]) { continue; }
+        cone.clear();
+        collect_dependencies_from(cone, k, first_unstored);
+        std::sort(cone.begin(), cone.end());
+        if (cone.size() > num_slots) {
+            for (std::size_t i = 0; i < num_slots * NUM_STAGES; ++i) {
+                mpfr_clear(slots[i]);
+                mpfr_clear(slots_ad[i]);
+            }
+            delete[] slots;
+            delete[] slots_ad;
+            num_slots = cone.size();
+            slots = new mpfr_t[num_slots * NUM_STAGES];
+            slots_ad = new mpfr_t[num_slots * NUM_STAGES];
+            for (std::size_t i = 0; i < num_slots * NUM_STAGES; ++i) {
+                mpfr_init2(slots[i], p);
+                mpfr_init2(slots_ad[i], p);
+            }
+        }
+        for (std::size_t n = 0; n < cone.size(); ++n) {
+            slot_index[cone[n]] = n;
+        }
+        // Unused operand fields are zero, which must not be looked up.
+        for (std::size_t n = 0; n < cone.size(); ++n) {
+            const ScheduleEntry &c = ORDER_CONDITION_SCHEDULE[cone[n]];
+            mpfr_t *const lhs = (c.op == ScheduleOp::LRS) ? nullptr :
+                                locate(m, slots, c.lhs);
+            mpfr_t *const rhs = (c.op != ScheduleOp::ELM) ? nullptr :
+                                locate(m, slots, c.rhs);
+            apply_schedule_entry_at(slots + n * NUM_STAGES, lhs, rhs,
+                                    x, c, r);
+            for (std::size_t i = 0; i < c.size; ++i) {
+                mpfr_set_zero(slots_ad[n * NUM_STAGES + i], 0);
+            }
+        }
+        const ScheduleEntry &e = ORDER_CONDITION_SCHEDULE[k];
+        mpfr_t *const x_res = x + (NUM_VARS - e.size);
+        mpfr_t *const m_res = slots + slot_index[k] * NUM_STAGES;
+        dotm(res, e.size, m_res, x_res, r);
+        mpfr_sub(res, res, g[k], r);
+        mpfr_mul_2ui(res, res, 1, r);
+        resa(slots_ad + slot_index[k] * NUM_STAGES,
+             dst + (NUM_VARS - e.size), e.size, m_res, x_res, res, r);
+        for (std::size_t n = cone.size(); n-- > 0;) {
+            const ScheduleEntry &c = ORDER_CONDITION_SCHEDULE[cone[n]];
+            const bool has_lhs = (c.op != ScheduleOp::LRS);
+            const bool has_rhs = (c.op == ScheduleOp::ELM);
+            apply_schedule_entry_adjoint(
+                    slots_ad + n * NUM_STAGES,
+                    has_lhs ? locate(m, slots, c.lhs) : nullptr,
+                    has_lhs ? locate(m_ad, slots_ad, c.lhs) : nullptr,
+                    has_rhs ? locate(m, slots, c.rhs) : nullptr,
+                    has_rhs ? locate(m_ad, slots_ad, c.rhs) : nullptr,
+                    x, dst, tmp, c, r);
+        }
+    }
+    // Backward sweep over the stored prefix.
+    for (std::size_t k = first_unstored; k-- > 0;) {
+        if (!needed[k]) { continue; }
+        const ScheduleEntry &e = ORDER_CONDITION_SCHEDULE[k];
+        apply_schedule_entry_adjoint(m_ad + e.dst,
+                                     m + e.lhs, m_ad + e.lhs,
+                                     m + e.rhs, m_ad + e.rhs,
+                                     x, dst, tmp, e, r);
+    }
+}
+
+// =============================================================================
+
+/*
+ * Evaluates objective_function_subset, giving up as soon as the running sum
+ * of squared residuals exceeds bound. Returns true if the evaluation ran to
+ * completion, in which case f holds exactly the value that
+ * objective_function_subset would compute. Returns false if the evaluation
+ * stopped early, in which case f holds a partial sum of squared residuals
+ * that exceeds bound (and hence, up to rounding, so does the full sum).
+ *
+ * Residuals are visited in decreasing order of their most recently observed
+ * magnitude divided by the cost of computing them from scratch, so that
+ * evaluations at points which are about to be rejected typically stop after
+ * computing a small fraction of the schedule.
+ *
+ * The breakdown argument is treated as in objective_function_subset, and is
+ * only written if the evaluation runs to completion.
+ */
+bool objective_function_bounded(mpfr_t f, mpfr_t *x, mpfr_t bound,
+                                const bool *active, mpfr_t *breakdown,
+                                mpfr_prec_t p, mpfr_rnd_t r) {
+    static thread_local mpfr_t *m = nullptr;
+    static thread_local mpfr_t *g = nullptr;
+    static thread_local mpfr_t *res = nullptr;
+    static thread_local mpfr_t order_one;
+    static thread_local bool *computed = nullptr;
+    static thread_local double *log2_cost = nullptr;
+    static thread_local double *priority = nullptr;
+    static thread_local std::size_t *visit_order = nullptr;
+    static thread_local mpfr_prec_t workspace_prec = 0;
+    if (m == nullptr) {
+        m = new mpfr_t[SCHEDULE_WORKSPACE_SIZE];
+        for (std::size_t i = 0; i < SCHEDULE_WORKSPACE_SIZE; ++i) {
+            mpfr_init2(m[i], p);
+        }
+        g = new mpfr_t[NUM_ORDER_CONDITIONS];
+        res = new mpfr_t[NUM_ORDER_CONDITIONS];
+        computed = new bool[NUM_ORDER_CONDITIONS];
+        log2_cost = new double[NUM_ORDER_CONDITIONS];
+        priority = new double[NUM_ORDER_CONDITIONS];
+        visit_order = new std::size_t[NUM_ORDER_CONDITIONS];
+        for (std::size_t k = 0; k < NUM_ORDER_CONDITIONS; ++k) {
+            mpfr_init2(g[k], p);
+            srim(g[k], ORDER_CONDITION_SCHEDULE[k].gamma, r);
+            mpfr_init2(res[k], p);
+            log2_cost[k] = std::log2(
+                    static_cast<double>(order_condition_cost(k)));
+            // Before any residual has been observed, assume that all
+            // residuals have unit magnitude, so the cheapest come first.
+            priority[k] = -log2_cost[k];
+            visit_order[k] = k;
+        }
+        mpfr_init2(order_one, p);
+        workspace_prec = p;
+    } else if (workspace_prec != p) {
+        // Residual priorities only depend on magnitudes, so they carry over.
+        set_workspace_precision(m, SCHEDULE_WORKSPACE_SIZE, p);
+        set_workspace_precision(g, NUM_ORDER_CONDITIONS, p);
+        set_workspace_precision(res, NUM_ORDER_CONDITIONS, p);
+        for (std::size_t k = 0; k < NUM_ORDER_CONDITIONS; ++k) {
+            srim(g[k], ORDER_CONDITION_SCHEDULE[k].gamma, r);
+        }
+        mpfr_set_prec(order_one, p);
+        workspace_prec = p;
+    }
+    std::sort(visit_order, visit_order + NUM_ORDER_CONDITIONS,
+              [](std::size_t i, std::size_t j) {
+                  return (priority[i] > priority[j]) ||
+                         ((priority[i] == priority[j]) && (i < j));
+              });
+    mpfr_set_ui(order_one, 1, r);
+    for (std::size_t i = NUM_VARS - NUM_STAGES; i < NUM_VARS; ++i) {
+        mpfr_sub(order_one, order_one, x[i], r);
+    }
+    mpfr_sqr(order_one, order_one, r);
+    mpfr_set(f, order_one, r);
+    if (mpfr_greater_p(f, bound)) { return false; }
+    for (std::size_t k = 0; k < NUM_ORDER_CONDITIONS; ++k) {
+        computed[k] = false;
+    }
+    for (std::size_t n = 0; n < NUM_ORDER_CONDITIONS; ++n) {
+        const std::size_t k = visit_order[n];
+        if ((active != nullptr) && !active[k]) { continue; }
+        const ScheduleEntry &e = ORDER_CONDITION_SCHEDULE[k];
+        apply_schedule_entry_on_demand(m, x, computed, k, r);
+        dotm(res[k], e.size, m + e.dst, x + (NUM_VARS - e.size), r);
+        mpfr_sub(res[k], res[k], g[k], r);
+        mpfr_fma(f, res[k], res[k], f, r);
+        priority[k] = mpfr_zero_p(res[k])
+                      ? -std::numeric_limits<double>::infinity()
+                      : 2.0 * static_cast<double>(mpfr_get_exp(res[k])) -
+                        log2_cost[k];
+        if (mpfr_greater_p(f, bound)) { return false; }
+    }
+    // Re-sum the residuals in schedule order to reproduce the rounding
+    // behavior of objective_function_subset exactly.
+    mpfr_set(f, order_one, r);
+    for (std::size_t k = 0; k < NUM_ORDER_CONDITIONS; ++k) {
+        if ((active != nullptr) && !active[k]) { continue; }
+        mpfr_fma(f, res[k], res[k], f, r);
+    }
+    if (breakdown != nullptr) {
+        mpfr_set(breakdown[0], order_one, r);
+        for (std::size_t k = 1; k < MAX_ORDER; ++k) {
+            mpfr_set_zero(breakdown[k], 0);
+        }
+        for (std::size_t k = 0; k < NUM_ORDER_CONDITIONS; ++k) {
+            if ((active != nullptr) && !active[k]) { continue; }
+            mpfr_ptr group = breakdown[order_condition_order(k) - 1];
+            mpfr_fma(group, res[k], res[k], group, r);
+        }
+    }
+    return true;
+}
+
+// =============================================================================
+
+#endif // RKTK_SCHEDULED_EVALUATORS_HPP_INCLUDED
@@ -0,0 +1,241 @@
+#ifndef RKTK_SIMPLIFYING_ASSUMPTIONS_HPP_INCLUDED
+#define RKTK_SIMPLIFYING_ASSUMPTIONS_HPP_INCLUDED
+
+// C++ standard library headers
+#include <cstddef> // for std::size_t
+
+// GNU MPFR multiprecision library headers
+#include <mpfr.h>
+
+// RKTK headers
+#include "objective_function.hpp" // for NUM_VARS
+#include "order_condition_schedule.hpp"
+
+/*
+ * The column simplifying assumption D(zeta) requires that
+ *
+ *     sum_i b_i c_i^(q-1) a_ij = b_j (1 - c_j^q) / q
+ *
+ * for every stage j and every 1 <= q <= zeta, where c_i denotes the i-th row
+ * sum of A. When D(q) holds, the order condition of every rooted tree t
+ * whose root carries q-1 leaves and exactly one other subtree u reduces to
+ *
+ *     Phi(t) = (Phi(u) - Phi(u with q leaves added to its root)) / q,
+ *
+ * and both trees on the right-hand side have conditions of their own. Such
+ * order conditions are therefore implied by the remaining ones, and can be
+ * dropped from the objective function in favor of the NUM_STAGES * zeta
+ * residuals of D(zeta) itself, which are far cheaper to evaluate.
+ *
+ * The row simplifying assumptions C(eta) for eta >= 2 are not offered here,
+ * since they cannot hold on the second stage of an explicit method unless
+ * c_2 = 0, and the order conditions they imply depend on how that stage is
+ * treated.
+ */
+
+// The largest zeta for which D(zeta) implies any order condition of order at
+// most MAX_ORDER. (The smallest tree of the form described above with q-1
+// root leaves has order q + 2.)
+#define MAX_COLUMN_ASSUMPTION_ORDER (MAX_ORDER - 2)
+
+// Computes the number of leaves and the number of non-leaf subtrees attached
+// to the root of the rooted tree whose order condition is evaluated by
+// schedule entry k.
+static void schedule_entry_root_shape(std::size_t k, std::size_t &num_leaves,
+                                      std::size_t &num_branches) {
+    const ScheduleEntry &e = ORDER_CONDITION_SCHEDULE[k];
+    switch (e.op) {
+        case ScheduleOp::LRS:
+            num_leaves = 1;
+            num_branches = 0;
+            break;
+        case ScheduleOp::LVM:
+            num_leaves = 0;
+            num_branches = 1;
+            break;
+        case ScheduleOp::ESQ:
+            schedule_entry_root_shape(
+                    schedule_entry_containing(e.lhs), num_leaves, num_branches);
+            num_leaves *= 2;
+            num_branches *= 2;
+            break;
+        case ScheduleOp::ELM: {
+            std::size_t rhs_leaves, rhs_branches;
+            schedule_entry_root_shape(
+                    schedule_entry_containing(e.lhs), num_leaves, num_branches);
+            schedule_entry_root_shape(
+                    schedule_entry_containing(e.rhs), rhs_leaves, rhs_branches);
+            num_leaves += rhs_leaves;
+            num_branches += rhs_branches;
+            break;
+        }
+    }
+}
+
+// Returns true if order condition k is implied by the column simplifying
+// assumption D(zeta) together with the order conditions it is not implied by.
+static bool implied_by_column_assumptions(std::size_t k, std::size_t zeta) {
+    std::size_t num_leaves, num_branches;
+    schedule_entry_root_shape(k, num_leaves, num_branches);
+    return (num_branches == 1) && (num_leaves < zeta);
+}
+
+// =============================================================================
+
+/*
+ * Adds the sum of squared residuals of D(zeta) to f, where x uses the same
+ * variable layout as objective_function: the strictly lower-triangular part
+ * of A in row-major order, followed by b. The workspaces of this function
+ * and add_column_assumption_gradient are thread-local, since line searches
+ * and speculative gradients call them from several threads at once.
+ */
+void add_column_assumption_residuals(mpfr_t f, mpfr_t *x, std::size_t zeta,
+                                     mpfr_prec_t p, mpfr_rnd_t r) {
+    static thread_local mpfr_t c[NUM_STAGES], c_pow[NUM_STAGES];
+    static thread_local mpfr_t w[NUM_STAGES];
+    static thread_local mpfr_t d, tmp;
+    static thread_local mpfr_prec_t workspace_prec = 0;
+    if (workspace_prec == 0) {
+        for (std::size_t i = 0; i < NUM_STAGES; ++i) {
+            mpfr_inits2(p, c[i], c_pow[i], w[i],
+                        static_cast<mpfr_ptr>(nullptr));
+        }
+        mpfr_inits2(p, d, tmp, static_cast<mpfr_ptr>(nullptr));
+        workspace_prec = p;
+    } else if (workspace_prec != p) {
+        for (std::size_t i = 0; i < NUM_STAGES; ++i) {
+            mpfr_set_prec(c[i], p);
+            mpfr_set_prec(c_pow[i], p);
+            mpfr_set_prec(w[i], p);
+        }
+        mpfr_set_prec(d, p);
+        mpfr_set_prec(tmp, p);
+        workspace_prec = p;
+    }
+    mpfr_t *const b = x + (NUM_VARS - NUM_STAGES);
+    mpfr_set_zero(c[0], 0);
+    for (std::size_t i = 1, k = 0; i < NUM_STAGES; ++i) {
+        mpfr_set(c[i], x[k++], r);
+        for (std::size_t j = 1; j < i; ++j) { mpfr_add(c[i], c[i], x[k++], r); }
+    }
+    for (std::size_t i = 0; i < NUM_STAGES; ++i) { mpfr_set_ui(c_pow[i], 1, r); }
+    for (std::size_t q = 1; q <= zeta; ++q) {
+        // Here c_pow holds c^(q-1).
+        for (std::size_t i = 0; i < NUM_STAGES; ++i) {
+            mpfr_mul(w[i], b[i], c_pow[i], r);
+        }
+        for (std::size_t j = 0; j < NUM_STAGES; ++j) {
+            mpfr_set_zero(d, 0);
+            for (std::size_t i = j + 1; i < NUM_STAGES; ++i) {
+                mpfr_fma(d, w[i], x[i * (i - 1) / 2 + j], d, r);
+            }
+            mpfr_mul(tmp, c_pow[j], c[j], r);
+            mpfr_ui_sub(tmp, 1, tmp, r);
+            mpfr_mul(tmp, tmp, b[j], r);
+            mpfr_div_ui(tmp, tmp, q, r);
+            mpfr_sub(d, d, tmp, r);
+            mpfr_fma(f, d, d, f, r);
+        }
+        for (std::size_t i = 0; i < NUM_STAGES; ++i) {
+            mpfr_mul(c_pow[i], c_pow[i], c[i], r);
+        }
+    }
+}
+
+/*
+ * Adds the gradient of the sum of squared residuals of D(zeta) to dst.
+ * Writing d_j for the residual of D(q) in column j, w_i = b_i c_i^(q-1), and
+ * s_k = sum_j a_kj d_j, the contribution of D(q) to the gradient is
+ *
+ *     d/d a_kl = 2 (d_l w_k + d_k w_k + (q-1) b_k c_k^(q-2) s_k),
+ *     d/d b_k  = 2 (c_k^(q-1) s_k + d_k (c_k^q - 1) / q).
+ */
+void add_column_assumption_gradient(mpfr_t *dst, mpfr_t *x, std::size_t zeta,
+                                    mpfr_prec_t p, mpfr_rnd_t r) {
+    static thread_local mpfr_t c[NUM_STAGES], c_pow[NUM_STAGES];
+    static thread_local mpfr_t c_pow_prev[NUM_STAGES], w[NUM_STAGES];
+    static thread_local mpfr_t d[NUM_STAGES], u[NUM_STAGES];
+    static thread_local mpfr_t s, tmp;
+    static thread_local mpfr_prec_t workspace_prec = 0;
+    if (workspace_prec == 0) {
+        for (std::size_t i = 0; i < NUM_STAGES; ++i) {
+            mpfr_inits2(p, c[i], c_pow[i], c_pow_prev[i], w[i], d[i], u[i],
+                        static_cast<mpfr_ptr>(nullptr));
+        }
+        mpfr_inits2(p, s, tmp, static_cast<mpfr_ptr>(nullptr));
+        workspace_prec = p;
+    } else if (workspace_prec != p) {
+        for (std::size_t i = 0; i < NUM_STAGES; ++i) {
+            mpfr_set_prec(c[i], p);
+            mpfr_set_prec(c_pow[i], p);
+            mpfr_set_prec(c_pow_prev[i], p);
+            mpfr_set_prec(w[i], p);
+            mpfr_set_prec(d[i], p);
+            mpfr_set_prec(u[i], p);
+        }
+        mpfr_set_prec(s, p);
+        mpfr_set_prec(tmp, p);
+        workspace_prec = p;
+    }
+    mpfr_t *const b = x + (NUM_VARS - NUM_STAGES);
+    mpfr_t *const grad_b = dst + (NUM_VARS - NUM_STAGES);
+    mpfr_set_zero(c[0], 0);
+    for (std::size_t i = 1, k = 0; i < NUM_STAGES; ++i) {
+        mpfr_set(c[i], x[k++], r);
+        for (std::size_t j = 1; j < i; ++j) { mpfr_add(c[i], c[i], x[k++], r); }
+    }
+    for (std::size_t i = 0; i < NUM_STAGES; ++i) { mpfr_set_ui(c_pow[i], 1, r); }
+    for (std::size_t q = 1; q <= zeta; ++q) {
+        // Here c_pow holds c^(q-1), and c_pow_prev holds c^(q-2) if q >= 2.
+        for (std::size_t i = 0; i < NUM_STAGES; ++i) {
+            mpfr_mul(w[i], b[i], c_pow[i], r);
+        }
+        for (std::size_t j = 0; j < NUM_STAGES; ++j) {
+            mpfr_set_zero(d[j], 0);
+            for (std::size_t i = j + 1; i < NUM_STAGES; ++i) {
+                mpfr_fma(d[j], w[i], x[i * (i - 1) / 2 + j], d[j], r);
+            }
+            mpfr_mul(tmp, c_pow[j], c[j], r);
+            mpfr_ui_sub(tmp, 1, tmp, r);
+            mpfr_mul(tmp, tmp, b[j], r);
+            mpfr_div_ui(tmp, tmp, q, r);
+            mpfr_sub(d[j], d[j], tmp, r);
+        }
+        for (std::size_t k = 0; k < NUM_STAGES; ++k) {
+            mpfr_set_zero(s, 0);
+            for (std::size_t j = 0; j < k; ++j) {
+                mpfr_fma(s, x[k * (k - 1) / 2 + j], d[j], s, r);
+            }
+            // gradient with respect to b_k
+            mpfr_mul(tmp, c_pow[k], c[k], r);
+            mpfr_sub_ui(tmp, tmp, 1, r);
+            mpfr_div_ui(tmp, tmp, q, r);
+            mpfr_mul(tmp, tmp, d[k], r);
+            mpfr_fma(tmp, c_pow[k], s, tmp, r);
+            mpfr_mul_2ui(tmp, tmp, 1, r);
+            mpfr_add(grad_b[k], grad_b[k], tmp, r);
+            // part of the gradient with respect to a_kl independent of l
+            mpfr_mul(u[k], d[k], w[k], r);
+            if (q >= 2) {
+                mpfr_mul(tmp, b[k], c_pow_prev[k], r);
+                mpfr_mul_ui(tmp, tmp, q - 1, r);
+                mpfr_fma(u[k], tmp, s, u[k], r);
+            }
+        }
+        for (std::size_t k = 1, i = 0; k < NUM_STAGES; ++k) {
+            for (std::size_t l = 0; l < k; ++l, ++i) {
+                mpfr_fma(tmp, d[l], w[k], u[k], r);
+                mpfr_mul_2ui(tmp, tmp, 1, r);
+                mpfr_add(dst[i], dst[i], tmp, r);
+            }
+        }
+        for (std::size_t i = 0; i < NUM_STAGES; ++i) {
+            mpfr_set(c_pow_prev[i], c_pow[i], r);
+            mpfr_mul(c_pow[i], c_pow[i], c[i], r);
+        }
+    }
+}
+
+// =============================================================================
+
+#endif // RKTK_SIMPLIFYING_ASSUMPTIONS_HPP_INCLUDED
@@ -0,0 +1,190 @@
+#ifndef RKTK_SPECULATIVE_GRADIENT_HPP_INCLUDED
+#define RKTK_SPECULATIVE_GRADIENT_HPP_INCLUDED
+
+// C++ standard library headers
+#include <cstddef> // for std::size_t
+#include <mutex>   // for std::mutex, std::lock_guard, std::unique_lock
+
+// GNU MPFR multiprecision library headers
+#include <mpfr.h>
+
+// Project-specific headers
+#include <dznl/MPFRVector.hpp>
+
+// RKTK headers
+#include "background_worker.hpp"    // for BackgroundWorker
+#include "objective_evaluator.hpp"  // for ObjectiveEvaluator
+#include "scheduled_evaluators.hpp" // for set_workspace_precision
+
+/*
+ * SpeculativeGradient overlaps the gradient evaluation at the end of a BFGS
+ * iteration with the line search that precedes it. Whenever a line search
+ * finds a trial point better than all others proposed since begin, it
+ * proposes that point, and a BackgroundWorker evaluates the gradient there
+ * while the line search continues. The gradient is not returned directly;
+ * it lands in the objective cache, from which ObjectiveEvaluator::gradient
+ * retrieves it once the optimizer settles on the same point.
+ *
+ * Gradient evaluations cannot be interrupted, so a proposal made while the
+ * worker is busy waits until the evaluation in progress has finished, and
+ * is replaced by any better proposal in the meantime. When the line search
+ * ends, finish reports whether the gradient at the accepted point has been
+ * or is being evaluated. If not, the speculative work is discarded: the
+ * caller evaluates the gradient itself, and only waits for the worker
+ * afterward, which keeps the evaluator idle between iterations.
+ */
+class SpeculativeGradient {
+
+private: // ======================================================= DATA MEMBERS
+
+    ObjectiveEvaluator &evaluator;
+    const mpfr_rnd_t rnd;
+    std::mutex mutex;
+    dznl::MPFRVector pending_point; // best proposal not yet started
+    dznl::MPFRVector active_point;  // point being evaluated by the worker
+    dznl::MPFRVector result;
+    mpfr_t best_func;
+    mpfr_prec_t grad_prec;
+    bool accepting;
+    bool has_pending;
+    bool has_started; // since the last call to begin
+    bool running;
+    std::size_t num_started;
+    std::size_t num_used;
+    BackgroundWorker worker;
+
+public: // ======================================================== CONSTRUCTORS
+
+    SpeculativeGradient(ObjectiveEvaluator &objective,
+                        mpfr_prec_t numeric_precision,
+                        mpfr_rnd_t rounding_mode) :
+            evaluator(objective), rnd(rounding_mode),
+            pending_point(NUM_VARS, numeric_precision),
+            active_point(NUM_VARS, numeric_precision),
+            result(NUM_VARS, numeric_precision),
+            grad_prec(numeric_precision), accepting(false),
+            has_pending(false), has_started(false), running(false),
+            num_started(0), num_used(0) {
+        mpfr_init2(best_func, numeric_precision);
+    }
+
+    // explicitly disallow copy construction
+    SpeculativeGradient(const SpeculativeGradient &) = delete;
+
+    // explicitly disallow copy assignment
+    SpeculativeGradient &operator=(const SpeculativeGradient &) = delete;
+
+public: // ========================================================== DESTRUCTOR
+
+    ~SpeculativeGradient() {
+        worker.wait();
+        mpfr_clear(best_func);
+    }
+
+public: // =========================================================== ACCESSORS
+
+    // Returns the number of speculative gradient evaluations started.
+    std::size_t get_started_count() const { return num_started; }
+
+    // Returns the number of speculative gradient evaluations whose result
+    // was used by the optimizer.
+    std::size_t get_used_count() const { return num_used; }
+
+public: // ============================================================ MUTATORS
+
+    // Starts accepting proposals that improve on the objective function
+    // value func at the current point. Gradients will be evaluated at
+    // gradient_prec bits, and proposed points have point_prec bits.
+    void begin(mpfr_t func, mpfr_prec_t point_prec,
+               mpfr_prec_t gradient_prec) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (mpfr_get_prec(best_func) != point_prec) {
+            mpfr_set_prec(best_func, point_prec);
+            set_workspace_precision(pending_point.data(), NUM_VARS,
+                                    point_prec);
+            set_workspace_precision(active_point.data(), NUM_VARS,
+                                    point_prec);
+            set_workspace_precision(result.data(), NUM_VARS, point_prec);
+        }
+        mpfr_set(best_func, func, rnd);
+        grad_prec = gradient_prec;
+        accepting = true;
+        has_pending = false;
+        has_started = false;
+    }
+
+    // Proposes a trial point with objective function value f. This may be
+    // called by several line searches on different threads at once.
+    void propose(const dznl::MPFRVector &point, mpfr_t f) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!accepting || !mpfr_less_p(f, best_func)) { return; }
+        mpfr_set(best_func, f, rnd);
+        for (std::size_t i = 0; i < NUM_VARS; ++i) {
+            mpfr_set(pending_point[i], point[i], rnd);
+        }
+        has_pending = true;
+        if (!running) {
+            running = true;
+            // The previous task has already left run, but the worker may
+            // not have registered its completion yet.
+            worker.wait();
+            worker.start([this] { run(); });
+        }
+    }
+
+    // Stops accepting proposals and returns true if the gradient at point
+    // has been evaluated speculatively, in which case it is now in the
+    // objective cache. Otherwise, the caller must evaluate the gradient
+    // itself and then call wait.
+    bool finish(const dznl::MPFRVector &point) {
+        std::unique_lock<std::mutex> lock(mutex);
+        accepting = false;
+        has_pending = false;
+        if (!has_started || !equal_points(active_point, point)) {
+            return false;
+        }
+        lock.unlock();
+        worker.wait();
+        ++num_used;
+        return true;
+    }
+
+    // Blocks until the speculative evaluation in progress (if any) has
+    // finished.
+    void wait() { worker.wait(); }
+
+private: // ===================================================== HELPER METHODS
+
+    // Evaluates gradients on the worker thread at the best pending proposal
+    // until there is none.
+    void run() {
+        while (true) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!has_pending) {
+                    running = false;
+                    return;
+                }
+                for (std::size_t i = 0; i < NUM_VARS; ++i) {
+                    mpfr_swap(active_point[i], pending_point[i]);
+                }
+                has_pending = false;
+                has_started = true;
+                ++num_started;
+            }
+            evaluator.gradient(result.data(), active_point.data(),
+                               grad_prec, rnd);
+        }
+    }
+
+    static bool equal_points(const dznl::MPFRVector &a,
+                             const dznl::MPFRVector &b) {
+        for (std::size_t i = 0; i < NUM_VARS; ++i) {
+            if (!mpfr_equal_p(a[i], b[i])) { return false; }
+        }
+        return true;
+    }
+
+};
+
+#endif // RKTK_SPECULATIVE_GRADIENT_HPP_INCLUDED
@@ -0,0 +1,116 @@
+#ifndef RKTK_SYMMETRIC_MATRIX_HPP_INCLUDED
+#define RKTK_SYMMETRIC_MATRIX_HPP_INCLUDED
+
+// C++ standard library headers
+#include <cstddef> // for std::size_t
+
+// GNU MPFR multiprecision library headers
+#include <mpfr.h>
+
+// Project-specific headers
+#include <dznl/MPFRVector.hpp>
+
+// RKTK headers
+#include "objective_function.hpp" // for NUM_VARS
+
+#define NUM_PACKED_ENTRIES (NUM_VARS * (NUM_VARS + 1) / 2)
+
+/*
+ * PackedSymmetricMatrix stores a symmetric NUM_VARS x NUM_VARS matrix by its
+ * lower triangle, packed row by row, so that entry (i, j) with j <= i lives
+ * at index i * (i + 1) / 2 + j. Compared to a dense dznl::MPFRMatrix, this
+ * halves the number of mpfr_t entries to initialize, round, and traverse.
+ * The kernels below touch each stored entry exactly once: a matrix-vector
+ * product uses it for both (i, j) and (j, i), and a symmetric rank-two
+ * update only computes the lower triangle.
+ */
+class PackedSymmetricMatrix {
+
+private: // ======================================================= DATA MEMBERS
+
+    mpfr_t *entries;
+    mpfr_t t;
+
+public: // ======================================================== CONSTRUCTORS
+
+    explicit PackedSymmetricMatrix(mpfr_prec_t prec) :
+            entries(new mpfr_t[NUM_PACKED_ENTRIES]) {
+        for (std::size_t k = 0; k < NUM_PACKED_ENTRIES; ++k) {
+            mpfr_init2(entries[k], prec);
+            mpfr_set_zero(entries[k], 0);
+        }
+        mpfr_init2(t, prec);
+    }
+
+    // explicitly disallow copy construction
+    PackedSymmetricMatrix(const PackedSymmetricMatrix &) = delete;
+
+    // explicitly disallow copy assignment
+    PackedSymmetricMatrix &operator=(const PackedSymmetricMatrix &) = delete;
+
+public: // ========================================================== DESTRUCTOR
+
+    ~PackedSymmetricMatrix() {
+        for (std::size_t k = 0; k < NUM_PACKED_ENTRIES; ++k) {
+            mpfr_clear(entries[k]);
+        }
+        mpfr_clear(t);
+        delete[] entries;
+    }
+
+public: // =========================================================== ACCESSORS
+
+    mpfr_t *data() { return entries; }
+
+    // Computes dst = A * v. dst and v must be distinct vectors.
+    void multiply(dznl::MPFRVector &dst, const dznl::MPFRVector &v,
+                  mpfr_rnd_t rnd) {
+        for (std::size_t i = 0; i < NUM_VARS; ++i) {
+            mpfr_set_zero(dst[i], 0);
+        }
+        for (std::size_t i = 0, k = 0; i < NUM_VARS; ++i) {
+            for (std::size_t j = 0; j < i; ++j, ++k) {
+                mpfr_fma(dst[i], entries[k], v[j], dst[i], rnd);
+                mpfr_fma(dst[j], entries[k], v[i], dst[j], rnd);
+            }
+            mpfr_fma(dst[i], entries[k], v[i], dst[i], rnd);
+            ++k;
+        }
+    }
+
+public: // ============================================================ MUTATORS
+
+    void set_identity_matrix() {
+        for (std::size_t i = 0, k = 0; i < NUM_VARS; ++i) {
+            for (std::size_t j = 0; j < i; ++j, ++k) {
+                mpfr_set_zero(entries[k], 0);
+            }
+            mpfr_set_ui(entries[k], 1, MPFR_RNDN);
+            ++k;
+        }
+    }
+
+    // Performs the symmetric rank-two update A += alpha * (u v^T + v u^T).
+    void rank_two_update(mpfr_t alpha,
+                         const dznl::MPFRVector &u, const dznl::MPFRVector &v,
+                         mpfr_rnd_t rnd) {
+        for (std::size_t i = 0, k = 0; i < NUM_VARS; ++i) {
+            for (std::size_t j = 0; j <= i; ++j, ++k) {
+                mpfr_mul(t, u[i], v[j], rnd);
+                mpfr_fma(t, v[i], u[j], t, rnd);
+                mpfr_fma(entries[k], alpha, t, entries[k], rnd);
+            }
+        }
+    }
+
+    // Changes the precision of all entries, rounding their values.
+    void set_precision(mpfr_prec_t prec, mpfr_rnd_t rnd) {
+        for (std::size_t k = 0; k < NUM_PACKED_ENTRIES; ++k) {
+            mpfr_prec_round(entries[k], prec, rnd);
+        }
+        mpfr_set_prec(t, prec);
+    }
+
+};
+
+#endif // RKTK_SYMMETRIC_MATRIX_HPP_INCLUDED
@@ -0,0 +1,154 @@
+#ifndef RKTK_TRUNCATED_NEWTON_HPP_INCLUDED
+#define RKTK_TRUNCATED_NEWTON_HPP_INCLUDED
+
+// C++ standard library headers
+#include <cstddef> // for std::size_t
+
+// GNU MPFR multiprecision library headers
+#include <mpfr.h>
+
+// Project-specific headers
+#include <dznl/MPFRVector.hpp>
+
+// RKTK headers
+#include "bfgs_subroutines.hpp"    // for dot
+#include "objective_evaluator.hpp" // for ObjectiveEvaluator
+
+// Maximum number of conjugate gradient iterations per Newton step. In exact
+// arithmetic, CG terminates after at most NUM_VARS iterations.
+#define NEWTON_CG_MAX_ITERATIONS NUM_VARS
+
+/*
+ * TruncatedNewtonSolver computes Newton steps without forming the Hessian H
+ * of the objective function. The Newton equations H p = -g are solved
+ * approximately by the conjugate gradient method, which only requires
+ * products of H with vectors. Each product is approximated by a forward
+ * difference of gradients,
+ *
+ *     H d ~ (grad(x + h d) - grad(x)) / h,
+ *
+ * with h chosen so that h |d| is about 2^(-prec/2) (1 + |x|), balancing
+ * truncation against rounding error. Each CG iteration therefore costs one
+ * gradient evaluation.
+ *
+ * CG is stopped once the residual |H p + g| falls below eta |g|, where the
+ * forcing term eta = min(1/2, |g|) makes the outer iteration converge
+ * quadratically near a minimum (Nocedal & Wright, Numerical Optimization,
+ * Algorithm 7.1). It is also stopped upon encountering a direction of
+ * non-positive curvature, in which case the steepest descent direction is
+ * returned if no CG iteration has been completed. Either way, the result is
+ * a direction of descent.
+ */
+class TruncatedNewtonSolver {
+
+private: // ======================================================= DATA MEMBERS
+
+    dznl::MPFRVector r, d, hd, x_probe, grad_probe;
+    mpfr_t rr, rr_new, curv, alpha, beta, h, tol, t;
+
+public: // ======================================================== CONSTRUCTORS
+
+    explicit TruncatedNewtonSolver(mpfr_prec_t prec) :
+            r(NUM_VARS, prec), d(NUM_VARS, prec), hd(NUM_VARS, prec),
+            x_probe(NUM_VARS, prec), grad_probe(NUM_VARS, prec) {
+        mpfr_inits2(prec, rr, rr_new, curv, alpha, beta, h, tol, t,
+                    static_cast<mpfr_ptr>(nullptr));
+    }
+
+    // explicitly disallow copy construction
+    TruncatedNewtonSolver(const TruncatedNewtonSolver &) = delete;
+
+    // explicitly disallow copy assignment
+    TruncatedNewtonSolver &operator=(const TruncatedNewtonSolver &) = delete;
+
+public: // ========================================================== DESTRUCTOR
+
+    ~TruncatedNewtonSolver() {
+        mpfr_clears(rr, rr_new, curv, alpha, beta, h, tol, t,
+                    static_cast<mpfr_ptr>(nullptr));
+    }
+
+public: // ============================================================ MUTATORS
+
+    // Computes an approximate Newton step dst at the point x, whose norm is
+    // x_norm and at which the objective function has gradient grad with
+    // norm grad_norm. grad must have been evaluated at prec bits. Returns
+    // the number of CG iterations (and hence gradient evaluations) performed.
+    std::size_t solve(dznl::MPFRVector &dst, ObjectiveEvaluator &evaluator,
+                      const dznl::MPFRVector &x, mpfr_t x_norm,
+                      const dznl::MPFRVector &grad, mpfr_t grad_norm,
+                      mpfr_prec_t prec, mpfr_rnd_t rnd) {
+        // tol = min(1/2, |g|) * |g|
+        mpfr_set(tol, grad_norm, rnd);
+        if (mpfr_cmp_d(tol, 0.5) > 0) { mpfr_set_d(tol, 0.5, rnd); }
+        mpfr_mul(tol, tol, grad_norm, rnd);
+        mpfr_sqr(tol, tol, rnd);
+        for (std::size_t i = 0; i < NUM_VARS; ++i) {
+            mpfr_set_zero(dst[i], 0);
+            mpfr_set(r[i], grad[i], rnd);
+            mpfr_neg(d[i], grad[i], rnd);
+        }
+        dot(rr, r, r, rnd);
+        std::size_t num_iterations = 0;
+        while (num_iterations < NEWTON_CG_MAX_ITERATIONS) {
+            hessian_vector_product(evaluator, x, x_norm, grad, prec, rnd);
+            ++num_iterations;
+            dot(curv, d, hd, rnd);
+            if (!mpfr_regular_p(curv) || (mpfr_sgn(curv) <= 0)) {
+                if (num_iterations == 1) {
+                    for (std::size_t i = 0; i < NUM_VARS; ++i) {
+                        mpfr_set(dst[i], d[i], rnd);
+                    }
+                }
+                break;
+            }
+            mpfr_div(alpha, rr, curv, rnd);
+            for (std::size_t i = 0; i < NUM_VARS; ++i) {
+                mpfr_fma(dst[i], alpha, d[i], dst[i], rnd);
+                mpfr_fma(r[i], alpha, hd[i], r[i], rnd);
+            }
+            dot(rr_new, r, r, rnd);
+            if (mpfr_lessequal_p(rr_new, tol)) { break; }
+            mpfr_div(beta, rr_new, rr, rnd);
+            for (std::size_t i = 0; i < NUM_VARS; ++i) {
+                mpfr_mul(d[i], beta, d[i], rnd);
+                mpfr_sub(d[i], d[i], r[i], rnd);
+            }
+            mpfr_swap(rr, rr_new);
+        }
+        return num_iterations;
+    }
+
+    // Changes the precision of all workspace variables.
+    void set_precision(mpfr_prec_t prec) {
+        set_workspace_precision(r.data(), NUM_VARS, prec);
+        set_workspace_precision(d.data(), NUM_VARS, prec);
+        set_workspace_precision(hd.data(), NUM_VARS, prec);
+        set_workspace_precision(x_probe.data(), NUM_VARS, prec);
+        set_workspace_precision(grad_probe.data(), NUM_VARS, prec);
+        mpfr_ptr scalars[] = {rr, rr_new, curv, alpha, beta, h, tol, t};
+        for (mpfr_ptr scalar : scalars) { mpfr_set_prec(scalar, prec); }
+    }
+
+private: // ===================================================== HELPER METHODS
+
+    // Approximates hd = H d by a forward difference of gradients.
+    void hessian_vector_product(ObjectiveEvaluator &evaluator,
+                                const dznl::MPFRVector &x, mpfr_t x_norm,
+                                const dznl::MPFRVector &grad,
+                                mpfr_prec_t prec, mpfr_rnd_t rnd) {
+        d.norm(t, rnd);
+        mpfr_add_ui(h, x_norm, 1, rnd);
+        mpfr_div(h, h, t, rnd);
+        mpfr_div_2ui(h, h, static_cast<unsigned long>(prec / 2), rnd);
+        x_probe.set_axpy(h, d, x, rnd);
+        evaluator.gradient(grad_probe.data(), x_probe.data(), prec, rnd);
+        for (std::size_t i = 0; i < NUM_VARS; ++i) {
+            mpfr_sub(hd[i], grad_probe[i], grad[i], rnd);
+            mpfr_div(hd[i], hd[i], h, rnd);
+        }
+    }
+
+};
+
+#endif // RKTK_TRUNCATED_NEWTON_HPP_INCLUDED
@@ -0,0 +1,221 @@
+#ifndef RKTK_TRUST_REGION_HPP_INCLUDED
+#define RKTK_TRUST_REGION_HPP_INCLUDED
+
+// C++ standard library headers
+#include <cstddef> // for std::size_t
+
+// GNU MPFR multiprecision library headers
+#include <mpfr.h>
+
+// Project-specific headers
+#include <dznl/MPFRMatrix.hpp>
+#include <dznl/MPFRVector.hpp>
+
+// RKTK headers
+#include "bfgs_subroutines.hpp"      // for dot
+#include "scheduled_evaluators.hpp" // for set_workspace_precision
+
+/*
+ * SR1TrustRegion holds the state of a trust-region method whose quadratic
+ * model m(p) = f + dot(g, p) + dot(p, B p) / 2 uses the symmetric rank-one
+ * (SR1) approximation B of the Hessian. Unlike the BFGS approximation, B
+ * need not be positive definite, so it can represent the negative curvature
+ * encountered near saddle points instead of being reset.
+ *
+ * Each trial step approximately minimizes m within the ball of radius
+ * delta by the truncated conjugate gradient method of Steihaug (1983),
+ * which follows directions of negative curvature to the boundary. The
+ * radius is adapted from the ratio rho of actual to predicted reduction,
+ * and B is updated from every trial step, accepted or not, as in Nocedal &
+ * Wright, Numerical Optimization, Algorithm 6.2.
+ */
+class SR1TrustRegion {
+
+private: // ======================================================= DATA MEMBERS
+
+    dznl::MPFRMatrix hess;
+    dznl::MPFRVector z, r, d, bd, w;
+    mpfr_t radius, tol, rr, rr_new, curv, alpha, beta, a, b, c, t;
+
+public: // ======================================================== CONSTRUCTORS
+
+    explicit SR1TrustRegion(mpfr_prec_t prec) :
+            hess(NUM_VARS, prec), z(NUM_VARS, prec), r(NUM_VARS, prec),
+            d(NUM_VARS, prec), bd(NUM_VARS, prec), w(NUM_VARS, prec) {
+        mpfr_inits2(prec, radius, tol, rr, rr_new, curv, alpha, beta, a, b, c,
+                    t, static_cast<mpfr_ptr>(nullptr));
+        reset();
+    }
+
+    // explicitly disallow copy construction
+    SR1TrustRegion(const SR1TrustRegion &) = delete;
+
+    // explicitly disallow copy assignment
+    SR1TrustRegion &operator=(const SR1TrustRegion &) = delete;
+
+public: // ========================================================== DESTRUCTOR
+
+    ~SR1TrustRegion() {
+        mpfr_clears(radius, tol, rr, rr_new, curv, alpha, beta, a, b, c, t,
+                    static_cast<mpfr_ptr>(nullptr));
+    }
+
+public: // ============================================================ MUTATORS
+
+    // Resets B to the identity and the trust-region radius to one.
+    void reset() {
+        hess.set_identity_matrix();
+        mpfr_set_ui(radius, 1, MPFR_RNDN);
+    }
+
+    // Computes a trial step dst for gradient grad, with norm grad_norm, and
+    // the reduction of the model it predicts. CG stops once the residual
+    // |B p + g| falls below min(1/2, sqrt(|g|)) |g|, or when the iterate
+    // reaches the trust-region boundary.
+    void solve(dznl::MPFRVector &dst, mpfr_t predicted,
+               const dznl::MPFRVector &grad, mpfr_t grad_norm,
+               mpfr_rnd_t rnd) {
+        mpfr_sqrt(tol, grad_norm, rnd);
+        if (mpfr_cmp_d(tol, 0.5) > 0) { mpfr_set_d(tol, 0.5, rnd); }
+        mpfr_mul(tol, tol, grad_norm, rnd);
+        mpfr_sqr(tol, tol, rnd);
+        for (std::size_t i = 0; i < NUM_VARS; ++i) {
+            mpfr_set_zero(z[i], 0);
+            mpfr_set(r[i], grad[i], rnd);
+            mpfr_neg(d[i], grad[i], rnd);
+        }
+        dot(rr, r, r, rnd);
+        for (std::size_t j = 0; (j < NUM_VARS) && !mpfr_zero_p(rr); ++j) {
+            bd.set_matrix_vector_multiply(hess, d, rnd);
+            dot(curv, d, bd, rnd);
+            if (!mpfr_number_p(curv) || (mpfr_sgn(curv) <= 0)) {
+                step_to_boundary(rnd);
+                break;
+            }
+            mpfr_div(alpha, rr, curv, rnd);
+            // Check whether z + alpha d leaves the trust region.
+            w.set_axpy(alpha, d, z, rnd);
+            w.norm(t, rnd);
+            if (mpfr_greaterequal_p(t, radius)) {
+                step_to_boundary(rnd);
+                break;
+            }
+            z.swap(w);
+            for (std::size_t i = 0; i < NUM_VARS; ++i) {
+                mpfr_fma(r[i], alpha, bd[i], r[i], rnd);
+            }
+            dot(rr_new, r, r, rnd);
+            if (mpfr_lessequal_p(rr_new, tol)) { break; }
+            mpfr_div(beta, rr_new, rr, rnd);
+            for (std::size_t i = 0; i < NUM_VARS; ++i) {
+                mpfr_mul(d[i], beta, d[i], rnd);
+                mpfr_sub(d[i], d[i], r[i], rnd);
+            }
+            mpfr_swap(rr, rr_new);
+        }
+        // predicted = -(dot(g, p) + dot(p, B p) / 2)
+        bd.set_matrix_vector_multiply(hess, z, rnd);
+        dot(t, z, bd, rnd);
+        mpfr_div_2ui(t, t, 1, rnd);
+        dot(predicted, grad, z, rnd);
+        mpfr_add(predicted, predicted, t, rnd);
+        mpfr_neg(predicted, predicted, rnd);
+        dst = z;
+    }
+
+    // Performs the SR1 update of B from the step s = step_size *
+    // step_direction and the gradient difference y = delta_gradient. The
+    // update is skipped when its denominator dot(y - B s, s) is small
+    // relative to |y - B s| |s|, since it would then be numerically unstable.
+    void update(const dznl::MPFRVector &delta_gradient, mpfr_t step_size,
+                const dznl::MPFRVector &step_direction, mpfr_rnd_t rnd) {
+        // w = y - B s
+        bd.set_matrix_vector_multiply(hess, step_direction, rnd);
+        for (std::size_t i = 0; i < NUM_VARS; ++i) {
+            mpfr_mul(w[i], step_size, bd[i], rnd);
+            mpfr_sub(w[i], delta_gradient[i], w[i], rnd);
+        }
+        dot(a, w, step_direction, rnd);
+        mpfr_mul(a, a, step_size, rnd);
+        w.norm(b, rnd);
+        mpfr_mul(b, b, step_size, rnd);
+        mpfr_div_2ui(b, b, 26, rnd); // r = 2^(-26), about 1.5e-8
+        mpfr_abs(t, a, rnd);
+        if (!mpfr_regular_p(a) || mpfr_less_p(t, b)) { return; }
+        // B += w w^T / dot(w, s)
+        mpfr_t *const entries = hess.data();
+        for (std::size_t i = 0; i < NUM_VARS; ++i) {
+            mpfr_div(t, w[i], a, rnd);
+            for (std::size_t j = 0; j < NUM_VARS; ++j) {
+                mpfr_t &entry = entries[i * NUM_VARS + j];
+                mpfr_fma(entry, t, w[j], entry, rnd);
+            }
+        }
+    }
+
+    // Adapts the trust-region radius after a trial step of length
+    // step_size, and returns true if the step should be accepted, i.e., if
+    // both the actual and the predicted reduction are positive.
+    bool update_radius(mpfr_t actual, mpfr_t predicted, mpfr_t step_size,
+                       mpfr_rnd_t rnd) {
+        if ((mpfr_sgn(predicted) <= 0) || !mpfr_number_p(actual)) {
+            mpfr_div_2ui(radius, radius, 1, rnd);
+            return false;
+        }
+        mpfr_div(t, actual, predicted, rnd);
+        if (mpfr_cmp_d(t, 0.75) > 0) {
+            // Expand only if the step was limited by the trust region.
+            mpfr_mul_d(a, radius, 0.8, rnd);
+            if (mpfr_greater_p(step_size, a)) {
+                mpfr_mul_2ui(radius, radius, 1, rnd);
+            }
+        } else if (mpfr_cmp_d(t, 0.1) < 0) {
+            mpfr_div_2ui(radius, radius, 1, rnd);
+        }
+        return (mpfr_sgn(actual) > 0);
+    }
+
+    // Changes the precision of B and the trust-region radius, rounding
+    // their values, and of all workspace variables.
+    void set_precision(mpfr_prec_t prec, mpfr_rnd_t rnd) {
+        mpfr_t *const entries = hess.data();
+        for (std::size_t i = 0; i < NUM_VARS * NUM_VARS; ++i) {
+            mpfr_prec_round(entries[i], prec, rnd);
+        }
+        mpfr_prec_round(radius, prec, rnd);
+        set_workspace_precision(z.data(), NUM_VARS, prec);
+        set_workspace_precision(r.data(), NUM_VARS, prec);
+        set_workspace_precision(d.data(), NUM_VARS, prec);
+        set_workspace_precision(bd.data(), NUM_VARS, prec);
+        set_workspace_precision(w.data(), NUM_VARS, prec);
+        mpfr_ptr scalars[] = {tol, rr, rr_new, curv, alpha, beta, a, b, c, t};
+        for (mpfr_ptr scalar : scalars) { mpfr_set_prec(scalar, prec); }
+    }
+
+private: // ===================================================== HELPER METHODS
+
+    // Replaces z by z + tau d, where tau >= 0 is chosen such that
+    // |z + tau d| equals the trust-region radius.
+    void step_to_boundary(mpfr_rnd_t rnd) {
+        // Solve a tau^2 + 2 b tau + c = 0 with a = dot(d, d),
+        // b = dot(z, d), and c = dot(z, z) - radius^2 <= 0.
+        dot(a, d, d, rnd);
+        dot(b, z, d, rnd);
+        dot(c, z, z, rnd);
+        mpfr_sqr(t, radius, rnd);
+        mpfr_sub(c, c, t, rnd);
+        mpfr_sqr(t, b, rnd);
+        mpfr_fms(t, a, c, t, rnd);
+        mpfr_neg(t, t, rnd);
+        if (mpfr_sgn(t) < 0) { mpfr_set_zero(t, 0); }
+        mpfr_sqrt(t, t, rnd);
+        mpfr_sub(t, t, b, rnd);
+        mpfr_div(t, t, a, rnd);
+        for (std::size_t i = 0; i < NUM_VARS; ++i) {
+            mpfr_fma(z[i], t, d[i], z[i], rnd);
+        }
+    }
+
+};
+
+#endif // RKTK_TRUST_REGION_HPP_INCLUDED